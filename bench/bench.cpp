@@ -0,0 +1,205 @@
+#include "bench.h"
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <fstream>
+#include <map>
+#include <regex>
+
+std::vector<BenchCase> &GetBenchCases()
+{
+    static std::vector<BenchCase> cases;
+    return cases;
+}
+
+std::vector<BenchResult> &GetBenchResults()
+{
+    static std::vector<BenchResult> results;
+    return results;
+}
+
+static std::string s_currentBench;
+
+void SetCurrentBench(const std::string &name)
+{
+    s_currentBench = name;
+}
+
+static int s_failCount = 0;
+
+bool BenchCheck(bool condition, const std::string &message)
+{
+    if (!condition)
+    {
+        SPDLOG_ERROR("check failed: {}", message);
+        s_failCount++;
+    }
+    return condition;
+}
+
+int GetBenchFailCount()
+{
+    return s_failCount;
+}
+
+static double GetPercentile(const std::vector<double> &sorted, double percent)
+{
+    size_t index = (size_t)std::ceil(percent * sorted.size());
+    return sorted[std::clamp(index, (size_t)1, sorted.size()) - 1];
+}
+
+BenchResult RecordResult(const std::string &name, const std::vector<double> &times)
+{
+    BenchResult result;
+    result.name = s_currentBench.empty() ? name : s_currentBench + "/" + name;
+    result.iterations = (int)times.size();
+    if (!times.empty())
+    {
+        std::vector<double> sorted = times;
+        std::sort(sorted.begin(), sorted.end());
+        double total = 0.0;
+        for (auto time : times)
+            total += time;
+        result.meanMs = total / times.size();
+        result.minMs = sorted.front();
+        result.maxMs = sorted.back();
+        result.p50Ms = GetPercentile(sorted, 0.5);
+        result.p95Ms = GetPercentile(sorted, 0.95);
+        result.p99Ms = GetPercentile(sorted, 0.99);
+    }
+
+    SPDLOG_INFO("{}: mean {:.3f} ms, min {:.3f} ms, max {:.3f} ms, p95 {:.3f} ms ({} iterations)",
+                name, result.meanMs, result.minMs, result.maxMs, result.p95Ms, result.iterations);
+    GetBenchResults().push_back(result);
+    return result;
+}
+
+BenchResult Measure(const std::string &name, int iterations, const std::function<void()> &func)
+{
+    std::vector<double> times;
+    times.reserve(iterations);
+    for (int i = 0; i < iterations; i++)
+    {
+        auto start = std::chrono::high_resolution_clock::now();
+        func();
+        auto end = std::chrono::high_resolution_clock::now();
+        times.push_back(std::chrono::duration<double, std::milli>(end - start).count());
+    }
+    return RecordResult(name, times);
+}
+
+bool WriteBenchResults(const std::string &filename, const std::vector<BenchResult> &results)
+{
+    std::ofstream file(filename);
+    if (!file.is_open())
+    {
+        SPDLOG_ERROR("failed to open result file: {}", filename);
+        return false;
+    }
+
+    // 한 줄에 결과 하나. ReadBenchResults가 이 형식을 읽음
+    file << "{\n  \"results\": [\n";
+    for (size_t i = 0; i < results.size(); i++)
+    {
+        auto &r = results[i];
+        file << fmt::format("    {{\"name\": \"{}\", \"iterations\": {}, \"meanMs\": {:.6f}, \"minMs\": {:.6f}, "
+                            "\"maxMs\": {:.6f}, \"p50Ms\": {:.6f}, \"p95Ms\": {:.6f}, \"p99Ms\": {:.6f}}}{}\n",
+                            r.name, r.iterations, r.meanMs, r.minMs, r.maxMs, r.p50Ms, r.p95Ms, r.p99Ms,
+                            i + 1 < results.size() ? "," : "");
+    }
+    file << "  ]\n}\n";
+    SPDLOG_INFO("results written: {} ({} entries)", filename, results.size());
+    return true;
+}
+
+bool ReadBenchResults(const std::string &filename, std::vector<BenchResult> &results)
+{
+    auto text = LoadTextFile(filename);
+    if (!text)
+        return false;
+
+    // WriteBenchResults가 만든 평평한 객체 배열만 처리하는 간단한 파서
+    static const std::regex objectPattern(R"(\{[^{}]*\})");
+    static const std::regex fieldPattern(R"xx("(\w+)"\s*:\s*("([^"]*)"|[-+0-9.eE]+))xx");
+    results.clear();
+    for (auto it = std::sregex_iterator(text->begin(), text->end(), objectPattern); it != std::sregex_iterator(); ++it)
+    {
+        std::string object = it->str();
+        BenchResult result;
+        for (auto field = std::sregex_iterator(object.begin(), object.end(), fieldPattern);
+             field != std::sregex_iterator(); ++field)
+        {
+            std::string key = (*field)[1];
+            std::string value = (*field)[2];
+            if (key == "name")
+                result.name = (*field)[3];
+            else if (key == "iterations")
+                result.iterations = std::stoi(value);
+            else if (key == "meanMs")
+                result.meanMs = std::stod(value);
+            else if (key == "minMs")
+                result.minMs = std::stod(value);
+            else if (key == "maxMs")
+                result.maxMs = std::stod(value);
+            else if (key == "p50Ms")
+                result.p50Ms = std::stod(value);
+            else if (key == "p95Ms")
+                result.p95Ms = std::stod(value);
+            else if (key == "p99Ms")
+                result.p99Ms = std::stod(value);
+        }
+        if (!result.name.empty())
+            results.push_back(result);
+    }
+    return true;
+}
+
+static double GetMetric(const BenchResult &result, const std::string &metric)
+{
+    if (metric == "p95")
+        return result.p95Ms;
+    if (metric == "p99")
+        return result.p99Ms;
+    return result.meanMs;
+}
+
+int CompareBenchResults(const std::vector<BenchResult> &baseline, const std::vector<BenchResult> &current,
+                        double thresholdPercent, const std::string &metric)
+{
+    std::map<std::string, const BenchResult *> baselineMap;
+    for (auto &result : baseline)
+        baselineMap[result.name] = &result;
+
+    int regressionCount = 0;
+    SPDLOG_INFO("compare {} (threshold {:.1f}%)", metric, thresholdPercent);
+    SPDLOG_INFO("{:<50} {:>12} {:>12} {:>9}", "name", "baseline", "current", "change");
+    for (auto &result : current)
+    {
+        auto found = baselineMap.find(result.name);
+        if (found == baselineMap.end())
+        {
+            SPDLOG_INFO("{:<50} {:>12} {:>12.3f} {:>9}", result.name, "-", GetMetric(result, metric), "new");
+            continue;
+        }
+
+        double base = GetMetric(*found->second, metric);
+        double value = GetMetric(result, metric);
+        double change = base > 0.0 ? (value - base) / base * 100.0 : 0.0;
+        baselineMap.erase(found);
+        if (change > thresholdPercent)
+        {
+            SPDLOG_WARN("{:<50} {:>12.3f} {:>12.3f} {:>+8.1f}% REGRESSION", result.name, base, value, change);
+            regressionCount++;
+        }
+        else
+        {
+            SPDLOG_INFO("{:<50} {:>12.3f} {:>12.3f} {:>+8.1f}%{}", result.name, base, value, change,
+                        change < -thresholdPercent ? " improved" : "");
+        }
+    }
+    for (auto &missing : baselineMap)
+        SPDLOG_INFO("{:<50} {:>12.3f} {:>12} {:>9}", missing.first, GetMetric(*missing.second, metric), "-", "missing");
+
+    SPDLOG_INFO("{} regression(s)", regressionCount);
+    return regressionCount;
+}
@@ -0,0 +1,70 @@
+#pragma once
+
+#include "common.h"
+#include <functional>
+#include <vector>
+
+// 간단한 benchmark 도구
+// BENCH(name) { ... Measure("case", iterations, [&] { ... }); } 형태로 작성하면
+// main에서 이름으로 골라 실행할 수 있음
+// GL context가 필요한 benchmark는 BENCH_GPU로 등록하고 --gpu 옵션을 줄 때만 실행
+
+struct BenchResult
+{
+    std::string name; // "benchmark 이름/case 이름"
+    int iterations{0};
+    double meanMs{0.0};
+    double minMs{0.0};
+    double maxMs{0.0};
+    double p50Ms{0.0};
+    double p95Ms{0.0};
+    double p99Ms{0.0};
+};
+
+using BenchFunc = void (*)();
+
+struct BenchCase
+{
+    std::string name;
+    BenchFunc func;
+    bool gpu{false};
+};
+
+std::vector<BenchCase> &GetBenchCases();
+std::vector<BenchResult> &GetBenchResults();
+// 실행 중인 benchmark 이름. 결과 이름 앞에 붙음
+void SetCurrentBench(const std::string &name);
+
+struct BenchRegistrar
+{
+    BenchRegistrar(const char *name, BenchFunc func, bool gpu = false)
+    {
+        GetBenchCases().push_back({name, func, gpu});
+    }
+};
+
+// func를 iterations번 실행하고 1회당 시간을 기록
+BenchResult Measure(const std::string &name, int iterations, const std::function<void()> &func);
+// 이미 측정한 시간(ms) 목록으로 결과를 기록
+BenchResult RecordResult(const std::string &name, const std::vector<double> &times);
+
+// 결과 검증. 실패하면 기록되고 bench 종료 코드가 0이 아니게 됨
+bool BenchCheck(bool condition, const std::string &message);
+int GetBenchFailCount();
+
+// 결과 파일(JSON) 저장/읽기
+bool WriteBenchResults(const std::string &filename, const std::vector<BenchResult> &results);
+bool ReadBenchResults(const std::string &filename, std::vector<BenchResult> &results);
+// baseline 대비 metric("mean", "p95", "p99")이 threshold(%) 이상 느려진 항목 수 반환
+int CompareBenchResults(const std::vector<BenchResult> &baseline, const std::vector<BenchResult> &current,
+                        double thresholdPercent, const std::string &metric = "mean");
+
+#define BENCH(benchName)                                        \
+    static void benchName();                                    \
+    static BenchRegistrar benchName##Registrar(#benchName, benchName); \
+    static void benchName()
+
+#define BENCH_GPU(benchName)                                          \
+    static void benchName();                                          \
+    static BenchRegistrar benchName##Registrar(#benchName, benchName, true); \
+    static void benchName()
@@ -0,0 +1,375 @@
+#include "bench.h"
+#include "headless.h"
+#include "program.h"
+#include <algorithm>
+#include <filesystem>
+
+// 고정 seed의 합성 장면을 headless로 렌더링해서 프레임 시간을 기록
+// shader/model 경로가 상대 경로이므로 저장소 루트에서 실행해야 함
+// 예) ./build/bench GpuScene --gpu --json result.json --baseline baseline.json
+
+static void MeasureScene(const std::string &name, const SceneOption &scene,
+                         CameraPath cameraPath = CameraPath::Orbit)
+{
+    HeadlessOption option;
+    option.scene = scene;
+    option.cameraPath = cameraPath;
+    option.frameCount = 120;
+    option.warmupFrames = 20;
+    option.width = 1280;
+    option.height = 720;
+
+    HeadlessResult result;
+    if (!BenchCheck(RunHeadless(option, &result) == 0, name + ": headless rendering failed"))
+        return;
+    BenchCheck(result.renderStats.drawCalls > 0, name + ": nothing was drawn");
+    SPDLOG_INFO("{}: {} draw calls, {} triangles, {:.1f} MB GPU memory", name, result.renderStats.drawCalls,
+                result.renderStats.triangles, result.memoryStats.GetTotalBytes() / (1024.0 * 1024.0));
+    RecordResult(name, std::vector<double>(result.frameTimes.begin(), result.frameTimes.end()));
+}
+
+BENCH_GPU(GpuSceneBaseline)
+{
+    MeasureScene("default scene", SceneOption());
+    MeasureScene("default scene fly-through", SceneOption(), CameraPath::FlyThrough);
+}
+
+BENCH_GPU(GpuSceneBoxes)
+{
+    SceneOption scene;
+    scene.boxCount = 1000;
+    MeasureScene("1k boxes", scene);
+    scene.boxCount = 10000;
+    MeasureScene("10k boxes", scene);
+}
+
+BENCH_GPU(GpuSceneGrass)
+{
+    SceneOption scene;
+    scene.grassCount = 10000;
+    MeasureScene("10k grass", scene);
+    scene.grassCount = 100000;
+    MeasureScene("100k grass", scene);
+
+    // 1M 인스턴스에서도 프레임당 업로드가 한도(기본 4MB) 안에 머무르고 모든 인스턴스가 그려지는지 확인
+    scene.grassCount = 1000000;
+    HeadlessOption option;
+    option.scene = scene;
+    option.cameraPath = CameraPath::FlyThrough;
+    option.frameCount = 120;
+    option.warmupFrames = 20;
+    option.width = 1280;
+    option.height = 720;
+    HeadlessResult result;
+    if (!BenchCheck(RunHeadless(option, &result) == 0, "1M grass: headless rendering failed"))
+        return;
+    BenchCheck(result.renderStats.instances >= (uint64_t)scene.grassCount, "1M grass: not every instance was drawn");
+    BenchCheck(result.maxBufferUploadBytes < 8 * 1024 * 1024, "1M grass: upload exceeded the budget");
+    SPDLOG_INFO("1M grass: at most {:.1f} KB uploaded per frame", result.maxBufferUploadBytes / 1024.0);
+    RecordResult("1M grass", std::vector<double>(result.frameTimes.begin(), result.frameTimes.end()));
+}
+
+BENCH_GPU(GpuSceneLights)
+{
+    SceneOption scene;
+    scene.lightCount = 8;
+    MeasureScene("8 lights", scene);
+    scene.lightCount = 32;
+    MeasureScene("32 lights", scene);
+}
+
+// pass별 GPU 시간 비교에 쓰는 공통 설정 : 장면을 가로지르는 fly-through 경로, 1280x720
+static HeadlessOption PassTimingOption(const SceneOption &scene, bool readAmbientOcclusion = false)
+{
+    HeadlessOption option;
+    option.scene = scene;
+    option.cameraPath = CameraPath::FlyThrough;
+    option.frameCount = 60;
+    option.warmupFrames = 10;
+    option.width = 1280;
+    option.height = 720;
+    option.readAmbientOcclusion = readAmbientOcclusion;
+    return option;
+}
+
+// passes의 GPU 시간을 프레임별로 합쳐서 기록. 하나도 없으면 기록하지 않음
+static void RecordPassTimes(const std::string &name, const HeadlessResult &result,
+                            std::initializer_list<const char *> passes)
+{
+    std::vector<double> times;
+    for (const char *pass : passes)
+    {
+        auto found = result.gpuPassTimes.find(pass);
+        if (found == result.gpuPassTimes.end())
+            continue;
+        times.resize(std::max(times.size(), found->second.size()), 0.0);
+        for (size_t i = 0; i < found->second.size(); i++)
+            times[i] += found->second[i];
+    }
+    if (!times.empty())
+        RecordResult(name, times);
+}
+
+// 모든 광원을 계산하는 방식, clustered 방식, light volume 방식의 조명 pass GPU 시간 비교
+// 광원이 많을 때 cluster가 의미 있도록 감쇠 거리를 줄이고, 광원이 배치된 deferred 장면을 바라보는 경로 사용
+static void MeasureLighting(int lightCount, DeferredLightingMode mode)
+{
+    const char *modeNames[] = {"full-screen", "clustered", "light volume"};
+    auto name = fmt::format("{} lights {}", lightCount, modeNames[(int)mode]);
+    SceneOption scene;
+    scene.lightCount = lightCount;
+    scene.lightRange = 5.0f;
+    scene.lightingMode = mode;
+
+    HeadlessResult result;
+    if (!BenchCheck(RunHeadless(PassTimingOption(scene), &result) == 0, name + ": headless rendering failed"))
+        return;
+    // 광원/cluster 데이터는 stream 버퍼로 매 프레임 올라가므로 GPU를 기다린 시간도 같이 출력
+    SPDLOG_INFO("{}: stream fence wait {:.3f} ms total, {:.3f} ms max per frame", name,
+                result.totalFenceWaitMs, result.maxFenceWaitMs);
+    RecordResult(name, std::vector<double>(result.frameTimes.begin(), result.frameTimes.end()));
+    RecordPassTimes(name + " (lighting gpu)", result, {"deferred lighting"});
+}
+
+BENCH_GPU(GpuClusteredLighting)
+{
+    for (int lightCount : {32, 256, 1024, 4096})
+    {
+        MeasureLighting(lightCount, DeferredLightingMode::FullScreen);
+        MeasureLighting(lightCount, DeferredLightingMode::Clustered);
+        MeasureLighting(lightCount, DeferredLightingMode::LightVolume);
+    }
+}
+
+// depth pre-pass 유무에 따른 G-buffer pass GPU 시간 비교. 모델이 겹쳐 보이는 fly-through 경로 사용
+static void MeasureDepthPrepass(int modelCount, bool depthPrepass)
+{
+    auto name = fmt::format("{} models {}", modelCount, depthPrepass ? "depth pre-pass" : "no pre-pass");
+    SceneOption scene;
+    scene.modelCount = modelCount;
+    scene.depthPrepass = depthPrepass;
+
+    HeadlessResult result;
+    if (!BenchCheck(RunHeadless(PassTimingOption(scene), &result) == 0, name + ": headless rendering failed"))
+        return;
+    RecordResult(name, std::vector<double>(result.frameTimes.begin(), result.frameTimes.end()));
+    for (const char *pass : {"depth pre-pass", "g-buffer"})
+        RecordPassTimes(fmt::format("{} ({} gpu)", name, pass), result, {pass});
+}
+
+BENCH_GPU(GpuDepthPrepass)
+{
+    for (int modelCount : {1, 8, 32})
+    {
+        MeasureDepthPrepass(modelCount, false);
+        MeasureDepthPrepass(modelCount, true);
+    }
+}
+
+// AO가 화면 전체에서 같은 값이거나 첫 측정 프레임과 마지막 프레임이 똑같으면
+// pass가 그려지지 않았거나 첫 프레임 결과에 멈춘 것 (카메라가 움직이므로 AO도 바뀌어야 함)
+static bool CheckAmbientOcclusionUpdates(const std::string &name, const HeadlessResult &result)
+{
+    auto &last = result.ambientOcclusion;
+    auto &first = result.firstAmbientOcclusion;
+    if (!BenchCheck(!last.empty() && first.size() == last.size(), name + ": ambient occlusion was not read back"))
+        return false;
+    auto range = std::minmax_element(last.begin(), last.end());
+    size_t changedCount = 0;
+    for (size_t i = 0; i < last.size(); i++)
+    {
+        if (abs((int)last[i] - (int)first[i]) > 2)
+            changedCount++;
+    }
+    double changedRatio = (double)changedCount / last.size();
+    bool varied = BenchCheck(*range.second - *range.first > 25, name + ": ambient occlusion is flat");
+    bool updated = BenchCheck(changedRatio > 0.01, name + ": ambient occlusion did not change across frames");
+    return varied && updated;
+}
+
+// 같은 카메라 경로와 seed로 그린 두 AO 결과(마지막 프레임)를 픽셀 단위로 비교
+// 평균 절대 오차가 0.03 미만이고 크게(0.1 이상) 다른 픽셀이 5% 미만이어야 같은 품질로 봄
+static bool CompareAmbientOcclusion(const HeadlessResult &a, const HeadlessResult &b, const std::string &name)
+{
+    auto &aoA = a.ambientOcclusion;
+    auto &aoB = b.ambientOcclusion;
+    if (!BenchCheck(!aoA.empty() && aoA.size() == aoB.size(), name + ": ambient occlusion was not read back"))
+        return false;
+    double diffSum = 0.0;
+    size_t largeDiffCount = 0;
+    for (size_t i = 0; i < aoA.size(); i++)
+    {
+        int diff = abs((int)aoA[i] - (int)aoB[i]);
+        diffSum += diff / 255.0;
+        if (diff > 25)
+            largeDiffCount++;
+    }
+    double meanDiff = diffSum / aoA.size();
+    double largeDiffRatio = (double)largeDiffCount / aoA.size();
+    SPDLOG_INFO("{}: mean abs diff {:.4f}, pixels over 0.1: {:.2f}%", name, meanDiff, largeDiffRatio * 100.0);
+    return BenchCheck(meanDiff < 0.03 && largeDiffRatio < 0.05, name + ": ambient occlusion differs too much");
+}
+
+// SSAO 해상도별 GPU 시간과 전체 해상도 결과와의 차이
+static bool MeasureSsao(SsaoResolution resolution, HeadlessResult &result)
+{
+    const char *resolutionNames[] = {"full", "half", "quarter"};
+    auto name = fmt::format("ssao {}", resolutionNames[(int)resolution]);
+    SceneOption scene;
+    scene.ssaoResolution = resolution;
+    auto option = PassTimingOption(scene, true);
+
+    if (!BenchCheck(RunHeadless(option, &result) == 0, name + ": headless rendering failed"))
+        return false;
+    RecordResult(name, std::vector<double>(result.frameTimes.begin(), result.frameTimes.end()));
+    // downsample, AO, blur, upsample을 합친 프레임별 시간
+    RecordPassTimes(name + " (ssao gpu)", result, {"ssao", "ssao blur", "ssao upsample"});
+    if (!BenchCheck(result.ambientOcclusion.size() == (size_t)option.width * option.height,
+                    name + ": ambient occlusion was not read back"))
+        return false;
+    return CheckAmbientOcclusionUpdates(name, result);
+}
+
+BENCH_GPU(GpuSsaoResolution)
+{
+    HeadlessResult full;
+    if (!MeasureSsao(SsaoResolution::Full, full))
+        return;
+    for (auto resolution : {SsaoResolution::Half, SsaoResolution::Quarter})
+    {
+        HeadlessResult result;
+        if (MeasureSsao(resolution, result))
+            CompareAmbientOcclusion(result, full, fmt::format("ssao {}x downsample vs full", 1 << (int)resolution));
+    }
+}
+
+// SSAO blur 방식별 blur pass GPU 시간. 해상도는 기본값(half)
+BENCH_GPU(GpuSsaoBlur)
+{
+    const char *blurNames[] = {"box", "gaussian", "bilateral"};
+    for (auto blur : {SsaoBlur::Box, SsaoBlur::Gaussian, SsaoBlur::Bilateral})
+    {
+        auto name = fmt::format("ssao blur {}", blurNames[(int)blur]);
+        SceneOption scene;
+        scene.ssaoBlur = blur;
+
+        HeadlessResult result;
+        if (!BenchCheck(RunHeadless(PassTimingOption(scene), &result) == 0, name + ": headless rendering failed"))
+            continue;
+        RecordResult(name, std::vector<double>(result.frameTimes.begin(), result.frameTimes.end()));
+        RecordPassTimes(name + " (blur gpu)", result, {"ssao blur"});
+    }
+}
+
+// AO 계산 방식별 "ssao" pass(linear depth, mip chain, AO) GPU 시간과 AO 평균
+BENCH_GPU(GpuSsaoMode)
+{
+    const char *modeNames[] = {"hemisphere", "gtao"};
+    for (auto mode : {SsaoMode::Hemisphere, SsaoMode::Horizon})
+    {
+        auto name = fmt::format("ssao mode {}", modeNames[(int)mode]);
+        SceneOption scene;
+        scene.ssaoMode = mode;
+
+        HeadlessResult result;
+        if (!BenchCheck(RunHeadless(PassTimingOption(scene, true), &result) == 0, name + ": headless rendering failed"))
+            continue;
+        RecordResult(name, std::vector<double>(result.frameTimes.begin(), result.frameTimes.end()));
+        RecordPassTimes(name + " (ssao gpu)", result, {"ssao"});
+        if (!CheckAmbientOcclusionUpdates(name, result))
+            continue;
+        double sum = 0.0;
+        for (auto value : result.ambientOcclusion)
+            sum += value / 255.0;
+        SPDLOG_INFO("{}: mean ambient visibility {:.3f}", name, sum / result.ambientOcclusion.size());
+    }
+}
+
+// 프레임마다 64개 샘플을 모두 계산하는 것과 16개씩 temporal 누적하는 것의 GPU 시간과 결과 차이
+BENCH_GPU(GpuSsaoTemporal)
+{
+    HeadlessResult results[2];
+    for (int temporal = 0; temporal < 2; temporal++)
+    {
+        auto name = fmt::format("ssao {}", temporal ? "16 samples temporal" : "64 samples");
+        SceneOption scene;
+        scene.ssaoTemporal = temporal == 1;
+
+        auto &result = results[temporal];
+        if (!BenchCheck(RunHeadless(PassTimingOption(scene, true), &result) == 0, name + ": headless rendering failed"))
+            return;
+        RecordResult(name, std::vector<double>(result.frameTimes.begin(), result.frameTimes.end()));
+        RecordPassTimes(name + " (ssao gpu)", result, {"ssao", "ssao temporal"});
+    }
+
+    if (!CheckAmbientOcclusionUpdates("ssao 16 samples temporal", results[1]))
+        return;
+    // 누적 결과가 매 프레임 64개 샘플과 같은 품질로 수렴해야 함 (해상도 비교와 같은 기준)
+    CompareAmbientOcclusion(results[1], results[0], "ssao 16 samples temporal vs 64 samples");
+}
+
+BENCH_GPU(GpuSceneModels)
+{
+    SceneOption scene;
+    scene.modelCount = 1;
+    MeasureScene("1 model", scene);
+    scene.modelCount = 8;
+    MeasureScene("8 models", scene);
+}
+
+// 시작 시간 : cache 디렉토리를 지우고 실행(cold)한 것과 binary cache가 있는 상태(warm)를 비교
+BENCH_GPU(GpuStartup)
+{
+    const std::string cacheDirectory = "./shader_cache_bench";
+    const int RUN_COUNT = 5;
+    auto previousDirectory = Program::GetBinaryCacheDirectory();
+    Program::SetBinaryCacheDirectory(cacheDirectory);
+
+    HeadlessOption option;
+    option.frameCount = 1;
+    option.warmupFrames = 0;
+
+    std::vector<double> coldInit, coldShader, warmInit, warmShader;
+    for (int i = 0; i < RUN_COUNT * 2; i++)
+    {
+        bool cold = i < RUN_COUNT;
+        if (cold)
+            std::filesystem::remove_all(cacheDirectory);
+
+        HeadlessResult result;
+        if (!BenchCheck(RunHeadless(option, &result) == 0, "startup: headless rendering failed"))
+            break;
+        (cold ? coldInit : warmInit).push_back(result.initTime);
+        (cold ? coldShader : warmShader).push_back(result.shaderInitTime);
+    }
+    auto &cacheStats = Program::GetCacheStats();
+    BenchCheck(warmShader.empty() || cacheStats.hits > 0, "startup: program binary cache was never used");
+
+    RecordResult("cold startup", coldInit);
+    RecordResult("cold shader init", coldShader);
+    RecordResult("warm startup", warmInit);
+    RecordResult("warm shader init", warmShader);
+
+    std::filesystem::remove_all(cacheDirectory);
+    Program::SetBinaryCacheDirectory(previousDirectory);
+}
+
+// directional light의 shadow map pass GPU 시간. 0은 고정 범위 shadow map 하나, 나머지는 cascade 수
+// 박스를 많이 두어 cascade 수에 따라 geometry shader가 복사하는 삼각형이 늘어나는 비용을 봄
+BENCH_GPU(GpuShadowCascades)
+{
+    for (int cascades = 0; cascades <= 4; cascades++)
+    {
+        auto name = fmt::format("shadow cascades {}", cascades);
+        SceneOption scene;
+        scene.directionalLight = true;
+        scene.shadowCascades = cascades;
+        scene.boxCount = 2000;
+
+        HeadlessResult result;
+        if (!BenchCheck(RunHeadless(PassTimingOption(scene), &result) == 0, name + ": headless rendering failed"))
+            continue;
+        RecordResult(name, std::vector<double>(result.frameTimes.begin(), result.frameTimes.end()));
+        RecordPassTimes(name + " (shadow gpu)", result, {"shadow map"});
+    }
+}
@@ -0,0 +1,155 @@
+#include "bench.h"
+#include "jobsystem.h"
+#include "scene.h"
+#include <algorithm>
+#include <numeric>
+#include <random>
+
+// JobSystem 정확성 검사와 오버헤드 측정. GL 없이 실행 가능
+
+// 작은 n은 직접 계산하고 큰 n은 두 개의 하위 job으로 나누어 counter로 대기
+static uint64_t Fib(JobSystem *jobSystem, int n)
+{
+    if (n < 2)
+        return n;
+    if (n < 16)
+        return Fib(nullptr, n - 1) + Fib(nullptr, n - 2);
+
+    uint64_t a = 0, b = 0;
+    JobCounter counter;
+    jobSystem->Submit([&]
+                      { a = Fib(jobSystem, n - 1); },
+                      &counter);
+    jobSystem->Submit([&]
+                      { b = Fib(jobSystem, n - 2); },
+                      &counter);
+    jobSystem->Wait(&counter);
+    return a + b;
+}
+
+BENCH(JobSystemBasic)
+{
+    auto jobSystem = JobSystem::Create();
+    SPDLOG_INFO("thread count: {}", jobSystem->GetThreadCount());
+
+    uint64_t fib = 0;
+    Measure("fib(30) recursive jobs", 5, [&]
+            { fib = Fib(jobSystem.get(), 30); });
+    BenchCheck(fib == 832040, fmt::format("fib(30) = {}", fib));
+
+    // 병렬 합
+    const size_t count = 10000000;
+    std::vector<uint32_t> values(count);
+    std::iota(values.begin(), values.end(), 0u);
+    uint64_t expected = (uint64_t)count * (count - 1) / 2;
+
+    uint64_t serialSum = 0;
+    Measure("sum 10M serial", 10, [&]
+            {
+        serialSum = 0;
+        for (auto v : values)
+            serialSum += v; });
+    BenchCheck(serialSum == expected, "serial sum");
+
+    std::atomic<uint64_t> parallelSum{0};
+    Measure("sum 10M ParallelFor", 10, [&]
+            {
+        parallelSum = 0;
+        jobSystem->ParallelFor(count, [&](size_t begin, size_t end)
+                               {
+            uint64_t local = 0;
+            for (size_t i = begin; i < end; i++)
+                local += values[i];
+            parallelSum += local; }); });
+    BenchCheck(parallelSum == expected, fmt::format("parallel sum {} != {}", parallelSum.load(), expected));
+
+    // dependency 체인 : 각 단계는 이전 단계가 끝난 후에만 실행되어야 함
+    const int stageCount = 64;
+    std::vector<int> order;
+    Measure("dependency chain 64 stages", 10, [&]
+            {
+        order.clear();
+        std::vector<JobCounter> counters(stageCount);
+        for (int i = 0; i < stageCount; i++)
+        {
+            jobSystem->Submit([&order, i]
+                              { order.push_back(i); },
+                              &counters[i], i > 0 ? &counters[i - 1] : nullptr);
+        }
+        jobSystem->Wait(&counters[stageCount - 1]); });
+    bool ordered = (int)order.size() == stageCount;
+    for (int i = 0; ordered && i < stageCount; i++)
+        ordered = order[i] == i;
+    BenchCheck(ordered, "dependency chain order");
+
+    // fan-in : 여러 범위 job이 모두 끝난 후 하나의 job 실행
+    std::vector<int> marks(100000, 0);
+    bool fanInValid = false;
+    JobCounter rangeCounter, finalCounter;
+    jobSystem->SubmitRange(marks.size(), 1000, [&](size_t begin, size_t end)
+                           {
+        for (size_t i = begin; i < end; i++)
+            marks[i]++; },
+                           &rangeCounter);
+    jobSystem->Submit([&]
+                      { fanInValid = std::all_of(marks.begin(), marks.end(), [](int m)
+                                                 { return m == 1; }); },
+                      &finalCounter, &rangeCounter);
+    jobSystem->Wait(&finalCounter);
+    BenchCheck(fanInValid, "fan-in dependency");
+}
+
+// 엔진 작업 형태 : 청크 단위 transform 갱신을 serial과 ParallelFor로 비교
+BENCH(JobSystemSceneUpdate)
+{
+    const size_t entityCount = 200000;
+    auto jobSystem = JobSystem::Create();
+
+    std::mt19937 rng(1234);
+    std::uniform_real_distribution<float> range(-50.0f, 50.0f);
+    std::uniform_real_distribution<float> angle(0.0f, 360.0f);
+
+    auto scene = Scene::Create();
+    auto mesh = scene->AddMesh(nullptr);
+    auto material = scene->AddMaterial(nullptr);
+    for (size_t i = 0; i < entityCount; i++)
+    {
+        scene->CreateRenderable(
+            Transform(vec3(range(rng), range(rng), range(rng)), vec3(0.0f, angle(rng), 0.0f), vec3(1.0f)),
+            mesh, material, RENDER_FORWARD);
+    }
+
+    std::vector<SceneChunk *> chunks;
+    scene->GetChunks(COMPONENT_TRANSFORM, chunks);
+    auto markDirty = [&]
+    {
+        for (auto chunk : chunks)
+            for (uint32_t i = 0; i < chunk->count; i++)
+                chunk->transforms[i].SetPosition(chunk->transforms[i].GetPosition());
+    };
+
+    Measure("update 200k transforms serial", 10, [&]
+            {
+        markDirty();
+        for (auto chunk : chunks)
+            Scene::UpdateChunkTransforms(*chunk); });
+    std::vector<mat4> serialWorlds;
+    for (auto chunk : chunks)
+        serialWorlds.insert(serialWorlds.end(), chunk->worlds.begin(), chunk->worlds.begin() + chunk->count);
+
+    Measure("update 200k transforms ParallelFor", 10, [&]
+            {
+        markDirty();
+        jobSystem->ParallelFor(chunks.size(), [&](size_t begin, size_t end)
+                               {
+            for (size_t i = begin; i < end; i++)
+                Scene::UpdateChunkTransforms(*chunks[i]); },
+                               1); });
+
+    size_t index = 0;
+    bool same = true;
+    for (auto chunk : chunks)
+        for (uint32_t i = 0; i < chunk->count; i++)
+            same = same && chunk->worlds[i] == serialWorlds[index++];
+    BenchCheck(same, "parallel transform update matches serial");
+}
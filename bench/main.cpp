@@ -0,0 +1,87 @@
+#include "bench.h"
+
+// 사용법 : bench [benchmark 이름 일부] [옵션]
+//   --gpu                    GL context가 필요한 benchmark(BENCH_GPU)도 실행
+//   --json <file>            결과를 JSON으로 저장
+//   --baseline <file>        실행 후 baseline 결과와 비교
+//   --compare <base> <file>  실행하지 않고 두 결과 파일만 비교
+//   --threshold <percent>    이 비율 이상 느려지면 regression (기본 5)
+//   --metric <mean|p95|p99>  비교 기준 (기본 mean)
+// 인자가 없으면 GPU를 제외한 모든 benchmark 실행
+// 종료 코드 : 0 정상, 1 검증 실패, 2 regression 발견
+int main(int argc, const char **argv)
+{
+    std::string filter;
+    std::string jsonFile;
+    std::string baselineFile;
+    std::string compareFile;
+    std::string metric = "mean";
+    double threshold = 5.0;
+    bool gpu = false;
+
+    for (int i = 1; i < argc; i++)
+    {
+        std::string arg = argv[i];
+        bool hasValue = i + 1 < argc;
+        if (arg == "--gpu")
+            gpu = true;
+        else if (arg == "--json" && hasValue)
+            jsonFile = argv[++i];
+        else if (arg == "--baseline" && hasValue)
+            baselineFile = argv[++i];
+        else if (arg == "--compare" && i + 2 < argc)
+        {
+            baselineFile = argv[++i];
+            compareFile = argv[++i];
+        }
+        else if (arg == "--threshold" && hasValue)
+            threshold = atof(argv[++i]);
+        else if (arg == "--metric" && hasValue)
+            metric = argv[++i];
+        else
+            filter = arg;
+    }
+
+    std::vector<BenchResult> baseline;
+    if (!baselineFile.empty() && !ReadBenchResults(baselineFile, baseline))
+        return -1;
+
+    // 결과 파일끼리만 비교
+    if (!compareFile.empty())
+    {
+        std::vector<BenchResult> current;
+        if (!ReadBenchResults(compareFile, current))
+            return -1;
+        return CompareBenchResults(baseline, current, threshold, metric) > 0 ? 2 : 0;
+    }
+
+    int runCount = 0;
+    for (auto &benchCase : GetBenchCases())
+    {
+        if (!filter.empty() && benchCase.name.find(filter) == std::string::npos)
+            continue;
+        if (benchCase.gpu && !gpu)
+            continue;
+        SPDLOG_INFO("[{}]", benchCase.name);
+        SetCurrentBench(benchCase.name);
+        benchCase.func();
+        runCount++;
+    }
+    SetCurrentBench("");
+
+    if (runCount == 0)
+    {
+        SPDLOG_ERROR("no benchmark matches: {}", filter);
+        return -1;
+    }
+    if (!jsonFile.empty())
+        WriteBenchResults(jsonFile, GetBenchResults());
+    if (GetBenchFailCount() > 0)
+    {
+        SPDLOG_ERROR("{} check(s) failed", GetBenchFailCount());
+        return 1;
+    }
+    if (!baselineFile.empty() && CompareBenchResults(baseline, GetBenchResults(), threshold, metric) > 0)
+        return 2;
+    return 0;
+}
@@ -0,0 +1,68 @@
+#include "bench.h"
+#include "scene.h"
+#include <random>
+
+// 100k 엔티티 생성/삭제 및 시스템 순회 비용. GL 리소스 없이 인덱스만 사용
+BENCH(ScenePopulation)
+{
+    const size_t entityCount = 100000;
+
+    std::mt19937 rng(1234);
+    std::uniform_real_distribution<float> range(-50.0f, 50.0f);
+    std::uniform_real_distribution<float> angle(0.0f, 360.0f);
+
+    SceneUPtr scene;
+    std::vector<Entity> entities;
+    entities.reserve(entityCount);
+    Measure("create 100k entities", 5, [&]
+            {
+        scene = Scene::Create();
+        entities.clear();
+        auto mesh = scene->AddMesh(nullptr);
+        auto material = scene->AddMaterial(nullptr);
+        for (size_t i = 0; i < entityCount; i++)
+        {
+            auto flags = (i % 4 == 0) ? RENDER_DEFERRED : (RENDER_FORWARD | RENDER_SHADOW_CASTER);
+            entities.push_back(scene->CreateRenderable(
+                Transform(vec3(range(rng), range(rng), range(rng)), vec3(0.0f, angle(rng), 0.0f), vec3(1.0f)),
+                mesh, material, flags));
+        } });
+
+    Measure("update transforms 100k (all dirty)", 20, [&]
+            {
+        scene->ForEachChunk(COMPONENT_TRANSFORM, [](SceneChunk &chunk)
+                            {
+            for (uint32_t i = 0; i < chunk.count; i++)
+                chunk.transforms[i].SetPosition(chunk.transforms[i].GetPosition()); });
+        scene->UpdateTransforms(); });
+
+    Measure("update transforms 100k (clean)", 20, [&]
+            { scene->UpdateTransforms(); });
+
+    // 렌더 준비 : 조건에 맞는 엔티티의 clip space 행렬 계산
+    auto viewProjection = perspective(radians(45.0f), 16.0f / 9.0f, 0.01f, 100.0f) *
+                          lookAt(vec3(0.0f, 2.0f, 12.0f), vec3(0.0f), vec3(0.0f, 1.0f, 0.0f));
+    std::vector<mat4> transforms;
+    transforms.reserve(entityCount);
+    Measure("collect shadow casters 100k", 20, [&]
+            {
+        transforms.clear();
+        scene->ForEachChunk(COMPONENT_RENDERABLE, [&](SceneChunk &chunk)
+                            {
+            for (uint32_t i = 0; i < chunk.count; i++)
+            {
+                if (chunk.flags[i] & RENDER_SHADOW_CASTER)
+                    transforms.push_back(viewProjection * chunk.worlds[i]);
+            } }); });
+    SPDLOG_INFO("collected: {}", transforms.size());
+
+    Measure("destroy and recreate 10k", 10, [&]
+            {
+        for (size_t i = 0; i < entityCount / 10; i++)
+        {
+            size_t index = rng() % entities.size();
+            scene->DestroyEntity(entities[index]);
+            entities[index] = scene->CreateRenderable(Transform(), 0, 0, RENDER_FORWARD);
+        } });
+    SPDLOG_INFO("entities: {}", scene->GetEntityCount());
+}
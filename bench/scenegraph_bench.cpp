@@ -0,0 +1,81 @@
+#include "bench.h"
+#include "scenegraph.h"
+#include <random>
+
+// 1M 노드(루트 1000개 x 자식 999개)에서 매 프레임 1%의 노드를 변경
+BENCH(SceneGraphUpdate)
+{
+    const size_t rootCount = 1000;
+    const size_t childCount = 999;
+    const size_t nodeCount = rootCount * (childCount + 1);
+    const size_t dirtyCount = nodeCount / 100;
+
+    auto graph = SceneGraph::Create();
+    std::vector<SceneNode *> nodes;
+    nodes.reserve(nodeCount);
+    for (size_t i = 0; i < rootCount; i++)
+    {
+        auto root = graph->CreateNode(Transform(vec3((float)i, 0.0f, 0.0f), vec3(0.0f), vec3(1.0f)));
+        nodes.push_back(root);
+        for (size_t j = 0; j < childCount; j++)
+            nodes.push_back(graph->CreateNode(Transform(vec3(0.0f, (float)j, 0.0f), vec3(0.0f, 10.0f, 0.0f), vec3(0.5f)), root));
+    }
+    graph->Update();
+
+    std::mt19937 rng(1234);
+    std::uniform_int_distribution<size_t> pick(0, nodeCount - 1);
+    float angle = 0.0f;
+
+    Measure("scenegraph 1M nodes, 1% dirty", 100, [&]
+            {
+        angle += 1.0f;
+        auto rot = angleAxis(radians(angle), vec3(0.0f, 1.0f, 0.0f));
+        for (size_t i = 0; i < dirtyCount; i++)
+            nodes[pick(rng)]->SetRotation(rot);
+        graph->Update(); });
+    SPDLOG_INFO("updated nodes per frame: {}", graph->GetLastUpdateCount());
+
+    Measure("scenegraph 1M nodes, full update", 20, [&]
+            { graph->Update(true); });
+
+    // 기존 방식 : 매번 euler 각으로부터 행렬 4개를 곱해서 계산
+    std::vector<mat4> worlds(nodeCount);
+    Measure("euler matrix rebuild 1M", 20, [&]
+            {
+        for (size_t i = 0; i < nodeCount; i++)
+        {
+            worlds[i] = translate(mat4(1.0f), vec3((float)i)) *
+                        rotate(mat4(1.0f), radians(angle), vec3(1.0f, 0.0f, 0.0f)) *
+                        rotate(mat4(1.0f), radians(angle), vec3(0.0f, 1.0f, 0.0f)) *
+                        rotate(mat4(1.0f), radians(angle), vec3(0.0f, 0.0f, 1.0f)) *
+                        scale(mat4(1.0f), vec3(0.5f));
+        } });
+}
+
+// 100k 깊이의 한 줄 계층. 재귀 없이 깊이/행렬이 갱신되고 순환 parent 설정이 거부되는지 확인
+BENCH(SceneGraphDeepChain)
+{
+    const size_t depth = 100000;
+
+    auto graph = SceneGraph::Create();
+    std::vector<SceneNode *> chain;
+    chain.reserve(depth);
+    chain.push_back(graph->CreateNode());
+    for (size_t i = 1; i < depth; i++)
+        chain.push_back(graph->CreateNode(Transform(vec3(0.0f, 1.0f, 0.0f), vec3(0.0f), vec3(1.0f)), chain.back()));
+    graph->Update();
+
+    SceneNode *roots[2] = {graph->CreateNode(), graph->CreateNode()};
+    size_t rootIndex = 0;
+    Measure("reparent 100k deep chain", 20, [&]
+            {
+        rootIndex = 1 - rootIndex;
+        chain.front()->SetParent(roots[rootIndex]);
+        graph->Update(); });
+    SPDLOG_INFO("updated nodes per frame: {}", graph->GetLastUpdateCount());
+
+    BenchCheck(graph->GetLastUpdateCount() == depth, "deep chain was not fully updated");
+    BenchCheck(!chain.front()->SetParent(chain.back()), "parenting under a descendant was accepted");
+    BenchCheck(!chain.front()->SetParent(chain.front()), "parenting under itself was accepted");
+    BenchCheck(chain.front()->GetParent() == roots[rootIndex], "rejected SetParent changed the parent");
+}
@@ -0,0 +1,161 @@
+#include "bench.h"
+#include "transformsystem.h"
+#include "headless.h"
+#include "framebuffer.h"
+#include "program.h"
+#include <random>
+
+// 객체별(AoS) Transform 계산과 TransformSystem(SoA) 일괄 계산 비교
+BENCH(TransformCompose)
+{
+    const size_t objectCount = 100000;
+    const int frameCount = 50;
+
+    std::mt19937 rng(1234);
+    std::uniform_real_distribution<float> range(-50.0f, 50.0f);
+    std::uniform_real_distribution<float> angle(0.0f, 360.0f);
+
+    std::vector<Transform> transforms;
+    transforms.reserve(objectCount);
+    auto system = TransformSystem::Create(objectCount);
+    for (size_t i = 0; i < objectCount; i++)
+    {
+        Transform trf(vec3(range(rng), range(rng), range(rng)),
+                      vec3(angle(rng), angle(rng), angle(rng)), vec3(1.0f));
+        transforms.push_back(trf);
+        system->Add(trf);
+    }
+
+    auto projection = perspective(radians(45.0f), 16.0f / 9.0f, 0.01f, 100.0f);
+    auto view = lookAt(vec3(0.0f, 2.0f, 12.0f), vec3(0.0f), vec3(0.0f, 1.0f, 0.0f));
+    std::vector<mat4> out(objectCount * 2);
+
+    // 기존 Object::Update 방식 : 매 객체 world 계산 후 projection * view * world
+    Measure("per-object glm (100k)", frameCount, [&]
+            {
+        for (size_t i = 0; i < objectCount; i++)
+        {
+            transforms[i].SetPosition(transforms[i].GetPosition()); // 매 프레임 움직인다고 가정
+            auto world = transforms[i].GetTransform();
+            out[i * 2] = world;
+            out[i * 2 + 1] = projection * view * world;
+        } });
+
+    // per-object 결과와 비교. 계산 순서 차이로 생기는 오차보다 크면 커널이 잘못된 것
+    auto checkResult = [&](const std::string &name)
+    {
+        float maxError = 0.0f;
+        for (size_t i = 0; i < objectCount; i++)
+        {
+            for (int m = 0; m < 2; m++)
+            {
+                auto &a = m == 0 ? system->GetWorld((uint32_t)i) : system->GetWorldViewProjection((uint32_t)i);
+                auto &b = out[i * 2 + m];
+                for (int c = 0; c < 4; c++)
+                {
+                    for (int r = 0; r < 4; r++)
+                        maxError = glm::max(maxError, glm::abs(a[c][r] - b[c][r]) / glm::max(1.0f, glm::abs(b[c][r])));
+                }
+            }
+        }
+        SPDLOG_INFO("{}: max relative difference from per-object path: {}", name, maxError);
+        BenchCheck(maxError < 1e-3f, fmt::format("{} result differs from per-object path: {}", name, maxError));
+    };
+
+    auto viewProjection = projection * view;
+    system->SetUseSimd(false);
+    Measure("TransformSystem scalar (100k)", frameCount, [&]
+            { system->Compose(viewProjection); });
+    checkResult("scalar");
+
+    if (TransformSystem::IsSimdAvailable())
+    {
+        system->SetUseSimd(true);
+        Measure("TransformSystem AVX2 (100k)", frameCount, [&]
+                { system->Compose(viewProjection); });
+        checkResult("AVX2");
+    }
+    else
+    {
+        SPDLOG_INFO("AVX2 is not available (build option or CPU)");
+    }
+}
+
+// Compose 결과를 매 프레임 texture buffer로 업로드하는 비용을 측정하고
+// 셰이더에서 texelFetch로 읽은 값이 CPU 결과와 같은지 확인
+BENCH_GPU(GpuTransformUpload)
+{
+    const size_t objectCount = 100000;
+    const int frameCount = 50;
+    const int readTexels = 1024; // 1024 x 1 target의 픽셀마다 texel 하나 (앞쪽 128개 객체)
+
+    if (!BenchCheck(CreateHeadlessGLContext(), "failed to create GL context"))
+        return;
+    {
+        std::mt19937 rng(1234);
+        std::uniform_real_distribution<float> range(-50.0f, 50.0f);
+        std::uniform_real_distribution<float> angle(0.0f, 360.0f);
+        auto system = TransformSystem::Create(objectCount);
+        for (size_t i = 0; i < objectCount; i++)
+        {
+            system->Add(Transform(vec3(range(rng), range(rng), range(rng)),
+                                  vec3(angle(rng), angle(rng), angle(rng)), vec3(1.0f)));
+        }
+        auto viewProjection = perspective(radians(45.0f), 16.0f / 9.0f, 0.01f, 100.0f) *
+                              lookAt(vec3(0.0f, 2.0f, 12.0f), vec3(0.0f), vec3(0.0f, 1.0f, 0.0f));
+
+        Measure("Compose + Upload (100k)", frameCount, [&]
+                {
+            system->Compose(viewProjection);
+            system->Upload();
+            glFinish(); });
+
+        // 정점 버퍼 없이 gl_VertexID로 화면을 덮는 삼각형을 그리고 픽셀 x번째 texel을 그대로 출력
+        ShaderPtr vs = Shader::CreateFromSource(
+            "#version 330 core\n"
+            "void main() {\n"
+            "    vec2 pos = vec2((gl_VertexID << 1) & 2, gl_VertexID & 2);\n"
+            "    gl_Position = vec4(pos * 2.0 - 1.0, 0.0, 1.0);\n"
+            "}\n",
+            GL_VERTEX_SHADER, "transform_fetch.vs");
+        ShaderPtr fs = Shader::CreateFromSource(
+            "#version 330 core\n"
+            "uniform samplerBuffer matrices;\n"
+            "uniform int texelOffset;\n"
+            "out vec4 fragColor;\n"
+            "void main() {\n"
+            "    fragColor = texelFetch(matrices, texelOffset + int(gl_FragCoord.x));\n"
+            "}\n",
+            GL_FRAGMENT_SHADER, "transform_fetch.fs");
+        ProgramUPtr program = (vs && fs) ? Program::Create({vs, fs}) : nullptr;
+        FramebufferPtr target = Framebuffer::CreateColorOnly({Texture::Create(readTexels, 1, GL_RGBA32F, GL_FLOAT)});
+        if (BenchCheck(program && target, "failed to create texture buffer fetch program or target"))
+        {
+            uint32_t vao = 0;
+            glGenVertexArrays(1, &vao);
+            glBindVertexArray(vao);
+            target->Bind();
+            glViewport(0, 0, readTexels, 1);
+            glDisable(GL_DEPTH_TEST);
+            program->Use();
+            system->Bind(0);
+            program->SetUniform("matrices", 0);
+            program->SetUniform("texelOffset", system->GetTexelOffset());
+            glDrawArrays(GL_TRIANGLES, 0, 3);
+
+            std::vector<vec4> texels(readTexels);
+            glReadPixels(0, 0, readTexels, 1, GL_RGBA, GL_FLOAT, texels.data());
+            glBindVertexArray(0);
+            glDeleteVertexArrays(1, &vao);
+
+            const float *expected = glm::value_ptr(system->GetMatrices()[0]);
+            float maxError = 0.0f;
+            for (int i = 0; i < readTexels * 4; i++)
+                maxError = glm::max(maxError, glm::abs(glm::value_ptr(texels[0])[i] - expected[i]));
+            SPDLOG_INFO("texture buffer fetch: max difference from CPU matrices: {}", maxError);
+            BenchCheck(maxError == 0.0f, fmt::format("texture buffer contents differ from composed matrices: {}", maxError));
+        }
+    }
+    // GL 리소스를 모두 해제한 뒤 context를 정리
+    DestroyHeadlessGLContext();
+}
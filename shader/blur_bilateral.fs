@@ -0,0 +1,40 @@
+#version 330 core
+
+out vec2 fragColor;
+in vec2 texCoord;
+uniform sampler2D tex;       // (값, linear depth). GL_LINEAR filter이어야 함
+uniform vec2 direction;      // (1, 0) 가로, (0, 1) 세로
+
+// blur_separable.fs와 같은 9-tap gaussian (5번 읽음)
+const float OFFSETS[3] = float[](0.0, 1.3846153846, 3.2307692308);
+const float WEIGHTS[3] = float[](0.2270270270, 0.3162162162, 0.0702702703);
+// 상대 깊이 차이가 이보다 크면 다른 표면으로 보고 섞지 않음 (ssao_upsample.fs와 같은 값)
+const float DEPTH_THRESHOLD = 0.1;
+
+// 두 texel을 묶어 읽으므로 깊이도 보간된 값. 경계에 걸친 tap은 깊이가 벌어져서 가중치가 줄어듦
+float Weight(float sampleDepth, float centerDepth) {
+    float diff = abs(sampleDepth - centerDepth) / centerDepth;
+    return max(1.0 - diff / DEPTH_THRESHOLD, 0.0);
+}
+
+void main() {
+    vec2 center = texture(tex, texCoord).rg;
+    if (center.y <= 0.0) {
+        // 아무것도 그려지지 않은 픽셀
+        fragColor = center;
+        return;
+    }
+    vec2 step = direction / vec2(textureSize(tex, 0));
+    float total = center.x * WEIGHTS[0];
+    float totalWeight = WEIGHTS[0];
+    for (int i = 1; i < 3; ++i) {
+        vec2 a = texture(tex, texCoord + step * OFFSETS[i]).rg;
+        vec2 b = texture(tex, texCoord - step * OFFSETS[i]).rg;
+        float wa = WEIGHTS[i] * Weight(a.y, center.y);
+        float wb = WEIGHTS[i] * Weight(b.y, center.y);
+        total += a.x * wa + b.x * wb;
+        totalWeight += wa + wb;
+    }
+    // 다음 pass가 깊이를 쓸 수 있도록 가운데 깊이를 그대로 넘김
+    fragColor = vec2(total / totalWeight, center.y);
+}
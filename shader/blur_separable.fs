@@ -0,0 +1,21 @@
+#version 330 core
+
+out vec4 fragColor;
+in vec2 texCoord;
+uniform sampler2D tex;       // GL_LINEAR filter이어야 함
+uniform vec2 direction;      // (1, 0) 가로, (0, 1) 세로
+
+// 9-tap gaussian을 bilinear filter로 두 texel씩 묶어서 5번만 읽음
+// 묶은 위치 = (o1 * w1 + o2 * w2) / (w1 + w2), 가중치 = w1 + w2
+const float OFFSETS[3] = float[](0.0, 1.3846153846, 3.2307692308);
+const float WEIGHTS[3] = float[](0.2270270270, 0.3162162162, 0.0702702703);
+
+void main() {
+    vec2 step = direction / vec2(textureSize(tex, 0));
+    vec4 result = texture(tex, texCoord) * WEIGHTS[0];
+    for (int i = 1; i < 3; ++i) {
+        result += texture(tex, texCoord + step * OFFSETS[i]) * WEIGHTS[i];
+        result += texture(tex, texCoord - step * OFFSETS[i]) * WEIGHTS[i];
+    }
+    fragColor = result;
+}
@@ -1,8 +1,8 @@
 #version 330 core
 
-layout (location = 0) out vec4 gPosition;
-layout (location = 1) out vec4 gNormal;
-layout (location = 2) out vec4 gAlbedoSpec;
+// compact G-buffer : position은 depth에서 복원하므로 저장하지 않음
+layout (location = 0) out vec2 gNormal;
+layout (location = 1) out vec4 gAlbedoSpec;
 
 in vec3 position;
 in vec3 normal;
@@ -14,15 +14,15 @@ struct Material {
 };
 uniform Material material;
 
+#include "normal_encoding.glsl"
+
 void main() {
 
   //// lighting pass
-  // store the fragment position vector in the first gbuffer texture
-  gPosition = vec4(position, 1.0);
-  // also store the per-fragment normals into the gbuffer
-  gNormal = vec4(normalize(normal), 1.0);
+  // store the per-fragment normals into the gbuffer (RG16)
+  gNormal = EncodeNormal(normalize(normal));
   // and the diffuse per-fragment color
   gAlbedoSpec.rgb = texture(material.diffuse, texCoord).rgb;
   // store specular intensity in gAlbedoSpec’s alpha component
   gAlbedoSpec.a = texture(material.specular, texCoord).r;
-}
\ No newline at end of file
+}
@@ -10,6 +10,9 @@ out vec3 normal;
 out vec2 texCoord;
 out vec3 position;
 
+// depth pre-pass(depth_only.vs)와 같은 depth를 보장
+invariant gl_Position;
+
 void main() {
   gl_Position = transform * vec4(aPos, 1.0);
   normal = (transpose(inverse(modelTransform)) * vec4(aNormal, 0.0)).xyz;
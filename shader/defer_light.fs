@@ -2,24 +2,63 @@
 out vec4 fragColor;
 in vec2 texCoord;
 
-uniform sampler2D gPosition;
-uniform sampler2D gNormal;
+uniform sampler2D gDepth;             // G-buffer의 depth. world position을 복원함
+uniform sampler2D gNormal;            // octahedral encoding (RG16)
 uniform sampler2D gAlbedoSpec;
+uniform mat4 inverseViewProjection;
 
 uniform sampler2D ssao;
 uniform int useSsao;
 
-struct Light {
-    vec3 position;
-    vec3 color;
-};
-const int NR_LIGHTS = 32;
-uniform Light lights[NR_LIGHTS];
+// 광원마다 3 texel : (position, radius), (color, 0), (attenuation, 0)
+uniform samplerBuffer lightData;
+uniform int lightCount;
+
+// clustered shading (LightCluster)
+uniform int useClusters;
+uniform usamplerBuffer clusterData;  // cluster마다 (시작 위치, 광원 수)
+uniform usamplerBuffer lightIndices;
+uniform vec3 clusterGrid;            // tile x, tile y, slice 개수
+uniform vec2 clusterTileSize;        // tile 하나의 픽셀 크기
+uniform vec2 clusterDepthParams;     // near, slice scale
+uniform mat4 view;
+
 uniform vec3 viewPos;
+
+#include "normal_encoding.glsl"
+
+vec3 GetWorldPosition(vec2 uv, float depth) {
+    vec4 world = inverseViewProjection * vec4(vec3(uv, depth) * 2.0 - 1.0, 1.0);
+    return world.xyz / world.w;
+}
+
+vec3 CalcLight(int index, vec3 fragPos, vec3 normal, vec3 albedo) {
+    vec4 positionRadius = texelFetch(lightData, index * 3);
+    vec3 toLight = positionRadius.xyz - fragPos;
+    float dist = length(toLight);
+    if (dist >= positionRadius.w)
+        return vec3(0.0);
+    vec3 color = texelFetch(lightData, index * 3 + 1).rgb;
+    vec3 attenuation = texelFetch(lightData, index * 3 + 2).xyz;
+    float att = 1.0 / (attenuation.x + attenuation.y * dist + attenuation.z * dist * dist);
+    // 반경에서 0이 되도록 부드럽게 줄임
+    float ratio = dist / positionRadius.w;
+    float window = clamp(1.0 - ratio * ratio * ratio * ratio, 0.0, 1.0);
+    // diffuse
+    vec3 lightDir = toLight / max(dist, 0.0001);
+    return max(dot(normal, lightDir), 0.0) * albedo * color * att * window * window;
+}
+
 void main() {
     // retrieve data from G-buffer
-    vec3 fragPos = texture(gPosition, texCoord).rgb;
-    vec3 normal = texture(gNormal, texCoord).rgb;
+    float depth = texture(gDepth, texCoord).r;
+    if (depth >= 1.0) {
+        // 아무것도 그려지지 않은 픽셀
+        fragColor = vec4(0.0, 0.0, 0.0, 1.0);
+        return;
+    }
+    vec3 fragPos = GetWorldPosition(texCoord, depth);
+    vec3 normal = DecodeNormal(texture(gNormal, texCoord).rg);
     vec3 albedo = texture(gAlbedoSpec, texCoord).rgb;
     float specular = texture(gAlbedoSpec, texCoord).a;
     // then calculate lighting as usual
@@ -27,11 +66,23 @@ void main() {
     vec3 ambient = useSsao == 1 ? texture(ssao, texCoord).r * 0.4 * albedo : albedo * 0.4;
     vec3 lighting = ambient;
     vec3 viewDir = normalize(viewPos - fragPos);
-    for(int i = 0; i < NR_LIGHTS; ++i) {
-    // diffuse
-        vec3 lightDir = normalize(lights[i].position - fragPos);
-        vec3 diffuse = max(dot(normal, lightDir), 0.0) * albedo * lights[i].color;
-        lighting += diffuse;
+    if (useClusters == 1) {
+        // 픽셀이 속한 cluster의 광원만 계산
+        float viewDepth = -(view * vec4(fragPos, 1.0)).z;
+        int slice = int(log(max(viewDepth, clusterDepthParams.x) / clusterDepthParams.x) * clusterDepthParams.y);
+        ivec2 tile = ivec2(gl_FragCoord.xy / clusterTileSize);
+        ivec3 grid = ivec3(clusterGrid);
+        ivec3 cluster = clamp(ivec3(tile, slice), ivec3(0), grid - 1);
+        int clusterIndex = (cluster.z * grid.y + cluster.y) * grid.x + cluster.x;
+        uvec2 range = texelFetch(clusterData, clusterIndex).xy;
+        for (uint i = 0u; i < range.y; ++i) {
+            int index = int(texelFetch(lightIndices, int(range.x + i)).r);
+            lighting += CalcLight(index, fragPos, normal, albedo);
+        }
+    }
+    else {
+        for (int i = 0; i < lightCount; ++i)
+            lighting += CalcLight(i, fragPos, normal, albedo);
     }
     fragColor = vec4(lighting, 1.0);
-}
\ No newline at end of file
+}
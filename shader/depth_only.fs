@@ -0,0 +1,5 @@
+#version 330 core
+
+// depth만 기록하므로 색 출력 없음
+void main() {
+}
@@ -0,0 +1,11 @@
+#version 330 core
+layout (location = 0) in vec3 aPos;
+
+uniform mat4 transform;
+
+// G-buffer pass(defer_geo.vs)와 정확히 같은 depth가 나와야 GL_EQUAL 테스트를 통과함
+invariant gl_Position;
+
+void main() {
+    gl_Position = transform * vec4(aPos, 1.0);
+}
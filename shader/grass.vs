@@ -2,10 +2,11 @@
  
 layout (location = 0) in vec3 aPos;
 layout (location = 2) in vec2 aTexCoord;
-layout (location = 3) in vec3 aOffset;
+layout (location = 3) in vec4 aOffset; // x, 회전각, z, 밟힘 정도
 out vec2 texCoord;
 
 uniform mat4 transform;
+uniform float time;
  
 void main() {
     float c = cos(aOffset.y);
@@ -16,6 +17,15 @@ void main() {
         0.0, 1.0, 0.0, 0.0,
         s, 0.0, c, 0.0,
         aOffset.x, 0.0, aOffset.z, 1.0);
-    gl_Position = transform * offsetMat * vec4(aPos, 1.0);
+
+    // 윗부분만 흔들리도록 높이에 비례해서 휘게 함
+    vec3 pos = aPos;
+    float height = aPos.y + 0.5;
+    float sway = sin(time * 2.0 + aOffset.x * 0.7 + aOffset.z * 0.5) * 0.1;
+    pos.x += sway * height * (1.0 - aOffset.w);
+    pos.y -= aOffset.w * 0.6 * height;
+    pos.z += aOffset.w * 0.4 * height;
+
+    gl_Position = transform * offsetMat * vec4(pos, 1.0);
     texCoord = aTexCoord;
 }
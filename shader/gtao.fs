@@ -0,0 +1,115 @@
+#version 330 core
+
+out vec2 fragColor; // (AO, linear depth). ssao.fs와 같은 형식
+
+in vec2 texCoord;
+
+uniform sampler2D linearDepth; // SSAO 해상도의 linear depth와 mip chain (ssao_depth_mip.fs)
+uniform sampler2D gNormal;
+uniform sampler2D texNoise;
+
+uniform mat4 view;
+uniform mat4 projection;
+uniform int downsample; // SSAO 해상도 배율 (1, 2, 4)
+
+uniform vec2 noiseScale;
+uniform float radius;
+uniform vec2 temporalJitter; // temporal 누적을 쓸 때 프레임마다 바뀌는 노이즈 offset
+
+// ground-truth AO : 화면에서 방향(slice)마다 양쪽으로 걸어가며 가장 높은 horizon을 찾고
+// 두 horizon 사이의 보이는 각도를 cosine 가중치로 적분
+const int SLICE_COUNT = 2;
+const int STEP_COUNT = 4;            // slice 한쪽 방향의 step 수
+const float MAX_RADIUS_PIXELS = 128.0;
+const float MIP_OFFSET = 3.3;        // step 거리가 2^3.3 픽셀을 넘으면 낮은 해상도 mip에서 읽음
+const float FALLOFF_RANGE = 0.6;     // radius의 바깥 60%에서 가중치가 0으로 줄어듦
+const float PI = 3.14159265;
+const float HALF_PI = 1.57079633;
+
+#include "normal_encoding.glsl"
+
+// 화면 좌표와 linear depth로 view space 좌표를 복원 (대칭 원근 투영)
+vec3 GetViewPosition(vec2 uv, float depth) {
+    return vec3((uv * 2.0 - 1.0) * depth / vec2(projection[0][0], projection[1][1]), -depth);
+}
+
+// SSAO 해상도 texel k의 깊이는 전체 해상도 texel k * downsample에서 가져온 값
+vec3 GetTexelPosition(ivec2 texel, float depth) {
+    vec2 uv = (vec2(texel * downsample) + 0.5) / vec2(textureSize(gNormal, 0));
+    return GetViewPosition(uv, depth);
+}
+
+// 샘플 방향의 horizon cos. 샘플이 없거나 멀면 lowCos(접평면)으로 돌아감
+float HorizonCos(ivec2 texel, float lod, vec3 P, vec3 V, float lowCos, vec2 falloff) {
+    ivec2 size = textureSize(linearDepth, 0);
+    if (any(lessThan(texel, ivec2(0))) || any(greaterThanEqual(texel, size)))
+        return lowCos;
+    float depth = textureLod(linearDepth, (vec2(texel) + 0.5) / vec2(size), lod).r;
+    if (depth <= 0.0)
+        return lowCos; // 아무것도 없는 곳
+    vec3 delta = GetTexelPosition(texel, depth) - P;
+    float dist = max(length(delta), 0.0001);
+    float weight = clamp(dist * falloff.x + falloff.y, 0.0, 1.0);
+    return mix(lowCos, dot(delta / dist, V), weight);
+}
+
+void main() {
+    ivec2 texel = ivec2(gl_FragCoord.xy);
+    float depth = texelFetch(linearDepth, texel, 0).r;
+    if (depth <= 0.0) {
+        fragColor = vec2(1.0, 0.0);
+        return;
+    }
+    vec3 P = GetTexelPosition(texel, depth);
+    vec3 V = normalize(-P);
+    vec3 N = normalize((view * vec4(DecodeNormal(texelFetch(gNormal, texel * downsample, 0).rg), 0.0)).xyz);
+
+    // radius를 SSAO 해상도의 픽셀 크기로 바꿈
+    float radiusPixels = min(radius * projection[1][1] * 0.5 * float(textureSize(linearDepth, 0).y) / depth,
+                             MAX_RADIUS_PIXELS);
+    if (radiusPixels < 1.0) {
+        fragColor = vec2(1.0, depth);
+        return;
+    }
+    // slice 회전과 step 위치를 픽셀마다 흔들고 blur로 평균
+    vec2 noise = fract(texture(texNoise, texCoord * noiseScale).xy * 0.5 + 0.5 + temporalJitter);
+    float falloffFrom = radius * (1.0 - FALLOFF_RANGE);
+    vec2 falloff = vec2(-1.0, radius) / (radius - falloffFrom);
+
+    float visibility = 0.0;
+    for (int s = 0; s < SLICE_COUNT; s++) {
+        float phi = (float(s) + noise.x) * PI / float(SLICE_COUNT);
+        vec2 omega = vec2(cos(phi), sin(phi));
+        // slice 평면에 normal을 투영하고 V와의 각도 n을 구함
+        vec3 direction = vec3(omega, 0.0);
+        vec3 orthoDirection = direction - dot(direction, V) * V;
+        vec3 axis = normalize(cross(orthoDirection, V));
+        vec3 projectedNormal = N - axis * dot(N, axis);
+        float projectedLength = length(projectedNormal);
+        float cosN = clamp(dot(projectedNormal, V) / max(projectedLength, 0.0001), 0.0, 1.0);
+        float n = sign(dot(orthoDirection, projectedNormal)) * acos(cosN);
+
+        // 0 : +omega 방향, 1 : -omega 방향
+        float lowCos0 = cos(n + HALF_PI);
+        float lowCos1 = cos(n - HALF_PI);
+        float horizonCos0 = lowCos0;
+        float horizonCos1 = lowCos1;
+        for (int j = 0; j < STEP_COUNT; j++) {
+            // 가까운 곳을 촘촘하게 (제곱 분포), 최소 1픽셀
+            float t = (float(j) + noise.y) / float(STEP_COUNT);
+            float offsetLength = t * t * radiusPixels + 1.0;
+            ivec2 offset = ivec2(round(omega * offsetLength));
+            float lod = clamp(log2(offsetLength) - MIP_OFFSET, 0.0, 3.0);
+            horizonCos0 = max(horizonCos0, HorizonCos(texel + offset, lod, P, V, lowCos0, falloff));
+            horizonCos1 = max(horizonCos1, HorizonCos(texel - offset, lod, P, V, lowCos1, falloff));
+        }
+
+        float h0 = n + clamp(-acos(horizonCos1) - n, -HALF_PI, HALF_PI);
+        float h1 = n + clamp(acos(horizonCos0) - n, -HALF_PI, HALF_PI);
+        float arc0 = (cosN + 2.0 * h0 * sin(n) - cos(2.0 * h0 - n)) * 0.25;
+        float arc1 = (cosN + 2.0 * h1 * sin(n) - cos(2.0 * h1 - n)) * 0.25;
+        visibility += projectedLength * (arc0 + arc1);
+    }
+
+    fragColor = vec2(clamp(visibility / float(SLICE_COUNT), 0.0, 1.0), depth);
+}
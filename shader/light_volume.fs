@@ -0,0 +1,43 @@
+#version 330 core
+out vec4 fragColor;
+
+flat in int lightIndex;
+
+uniform sampler2D gDepth;
+uniform sampler2D gNormal;
+uniform sampler2D gAlbedoSpec;
+uniform mat4 inverseViewProjection;
+
+uniform samplerBuffer lightData;
+uniform vec2 screenSize;
+
+#include "normal_encoding.glsl"
+
+void main() {
+    // 구가 덮은 픽셀의 G-buffer를 읽음
+    vec2 texCoord = gl_FragCoord.xy / screenSize;
+    float depth = texture(gDepth, texCoord).r;
+    if (depth >= 1.0)
+        discard;
+    vec4 world = inverseViewProjection * vec4(vec3(texCoord, depth) * 2.0 - 1.0, 1.0);
+    vec3 fragPos = world.xyz / world.w;
+    vec3 normal = DecodeNormal(texture(gNormal, texCoord).rg);
+    vec3 albedo = texture(gAlbedoSpec, texCoord).rgb;
+
+    vec4 positionRadius = texelFetch(lightData, lightIndex * 3);
+    vec3 toLight = positionRadius.xyz - fragPos;
+    float dist = length(toLight);
+    if (dist >= positionRadius.w)
+        discard;
+    vec3 color = texelFetch(lightData, lightIndex * 3 + 1).rgb;
+    vec3 attenuation = texelFetch(lightData, lightIndex * 3 + 2).xyz;
+    float att = 1.0 / (attenuation.x + attenuation.y * dist + attenuation.z * dist * dist);
+    // 반경에서 0이 되도록 부드럽게 줄임 (defer_light.fs와 같은 식)
+    float ratio = dist / positionRadius.w;
+    float window = clamp(1.0 - ratio * ratio * ratio * ratio, 0.0, 1.0);
+    // diffuse
+    vec3 lightDir = toLight / max(dist, 0.0001);
+    vec3 diffuse = max(dot(normal, lightDir), 0.0) * albedo * color * att * window * window;
+    // blend(GL_ONE, GL_ONE)로 ambient pass 결과에 더해짐
+    fragColor = vec4(diffuse, 0.0);
+}
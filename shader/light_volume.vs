@@ -0,0 +1,16 @@
+#version 330 core
+layout(location = 0) in vec3 aPos;
+
+// 광원마다 3 texel : (position, radius), (color, 0), (attenuation, 0)
+uniform samplerBuffer lightData;
+uniform mat4 viewProjection;
+uniform float volumeScale; // 다면체 구가 실제 구를 감싸도록 키우는 비율
+
+flat out int lightIndex;
+
+void main() {
+    // 인스턴스 하나가 광원 하나
+    lightIndex = gl_InstanceID;
+    vec4 positionRadius = texelFetch(lightData, gl_InstanceID * 3);
+    gl_Position = viewProjection * vec4(positionRadius.xyz + aPos * positionRadius.w * volumeScale, 1.0);
+}
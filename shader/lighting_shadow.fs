@@ -31,6 +31,15 @@ uniform Material material;
 uniform int blinn;
 uniform sampler2D shadowMap;
 
+// directional light의 cascaded shadow map (CascadedShadowMap)
+#define MAX_CASCADES 4
+uniform int useCascades;
+uniform sampler2DArray cascadeShadowMap;
+uniform mat4 cascadeViewProjection[MAX_CASCADES];
+uniform vec4 cascadeSplits; // cascade마다 끝나는 view space 깊이
+uniform int cascadeCount;
+uniform mat4 view;
+
 float ShadowCalculation(vec4 fragPosLight, vec3 normal, vec3 lightDir) {
   // perform perspective divide
   vec3 projCoords = fragPosLight.xyz / fragPosLight.w;
@@ -58,6 +67,39 @@ float ShadowCalculation(vec4 fragPosLight, vec3 normal, vec3 lightDir) {
   return shadow;
 }
 
+float CascadeShadowCalculation(vec3 fragPos, vec3 normal, vec3 lightDir) {
+  // 픽셀의 깊이가 속한 cascade를 고름. 마지막 구간보다 멀면 그림자 없음
+  float depth = -(view * vec4(fragPos, 1.0)).z;
+  if (depth > cascadeSplits[cascadeCount - 1])
+    return 0.0;
+  int cascade = 0;
+  for (int i = 0; i < cascadeCount - 1; ++i) {
+    if (depth > cascadeSplits[i])
+      cascade = i + 1;
+  }
+
+  mat4 lightTransform = cascadeViewProjection[cascade];
+  vec3 projCoords = (lightTransform * vec4(fragPos, 1.0)).xyz * 0.5 + 0.5; // orthographic이라 w = 1
+  if (projCoords.z > 1.0)
+    return 0.0;
+
+  // cascade마다 texel 하나가 덮는 world 크기가 다르므로 bias도 texel 크기에 비례하게 줌
+  // light view는 회전뿐이라 투영 행렬의 x, z 축 scale은 행 벡터의 길이와 같음
+  vec2 texelSize = 1.0 / textureSize(cascadeShadowMap, 0).xy;
+  float worldTexel = 2.0 * texelSize.x / length(vec3(lightTransform[0][0], lightTransform[1][0], lightTransform[2][0]));
+  float depthScale = 0.5 * length(vec3(lightTransform[0][2], lightTransform[1][2], lightTransform[2][2]));
+  float bias = worldTexel * depthScale * mix(1.5, 4.0, 1.0 - max(dot(normal, lightDir), 0.0));
+
+  float shadow = 0.0;
+  for(int x = -1; x <= 1; ++x) {
+    for(int y = -1; y <= 1; ++y) {
+      float pcfDepth = texture(cascadeShadowMap, vec3(projCoords.xy + vec2(x, y) * texelSize, cascade)).r;
+      shadow += projCoords.z - bias > pcfDepth ? 1.0 : 0.0;
+    }
+  }
+  return shadow / 9.0;
+}
+
 void main() {
 
   vec3 texColor = texture2D(material.diffuse, fs_in.texCoord).xyz;
@@ -101,7 +143,9 @@ void main() {
       spec = pow(max(dot(halfDir, pixelNorm), 0.0), material.shininess);
     }
     vec3 specular = spec * specColor * light.specular;
-    float shadow = ShadowCalculation(fs_in.fragPosLight, pixelNorm, lightDir);
+    float shadow = light.directional == 1 && useCascades == 1
+                   ? CascadeShadowCalculation(fs_in.fragPos, pixelNorm, lightDir)
+                   : ShadowCalculation(fs_in.fragPosLight, pixelNorm, lightDir);
 
     result += (diffuse + specular) * intensity * (1.0 - shadow);
   }
@@ -0,0 +1,15 @@
+#version 330 core
+
+out vec4 fragColor;
+in vec2 texCoord;
+uniform sampler2D tex; // 픽셀마다 G-buffer에 기록된 fragment 수
+
+// 0 : 검정, 1 : 파랑, 2 : 초록, 3 : 노랑, 4 : 빨강, 5 이상 : 흰색
+const vec3 HEAT[6] = vec3[6](
+    vec3(0.0), vec3(0.0, 0.2, 1.0), vec3(0.0, 0.8, 0.2),
+    vec3(1.0, 0.9, 0.0), vec3(1.0, 0.1, 0.0), vec3(1.0));
+
+void main() {
+    int count = int(texture(tex, texCoord).r + 0.5);
+    fragColor = vec4(HEAT[clamp(count, 0, 5)], 1.0);
+}
@@ -0,0 +1,29 @@
+#version 330 core
+#define MAX_CASCADES 4
+
+layout (triangles) in;
+layout (triangle_strip, max_vertices = 12) out;
+
+uniform mat4 cascadeViewProjection[MAX_CASCADES];
+uniform int cascadeCount;
+
+// 삼각형 하나를 cascade마다 복사해서 해당 layer에 그림
+void main() {
+    for (int cascade = 0; cascade < cascadeCount; ++cascade) {
+        vec4 clip[3];
+        for (int i = 0; i < 3; ++i)
+            clip[i] = cascadeViewProjection[cascade] * gl_in[i].gl_Position;
+        // 이 cascade의 범위 밖에 있는 삼각형은 내보내지 않음
+        if (all(lessThan(vec3(clip[0].x, clip[1].x, clip[2].x), vec3(-1.0))) ||
+            all(greaterThan(vec3(clip[0].x, clip[1].x, clip[2].x), vec3(1.0))) ||
+            all(lessThan(vec3(clip[0].y, clip[1].y, clip[2].y), vec3(-1.0))) ||
+            all(greaterThan(vec3(clip[0].y, clip[1].y, clip[2].y), vec3(1.0))))
+            continue;
+        for (int i = 0; i < 3; ++i) {
+            gl_Layer = cascade;
+            gl_Position = clip[i];
+            EmitVertex();
+        }
+        EndPrimitive();
+    }
+}
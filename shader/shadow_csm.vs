@@ -0,0 +1,9 @@
+#version 330 core
+layout (location = 0) in vec3 aPos;
+
+uniform mat4 modelTransform;
+
+// cascade별 투영은 geometry shader에서 곱함
+void main() {
+    gl_Position = modelTransform * vec4(aPos, 1.0);
+}
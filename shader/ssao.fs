@@ -1,15 +1,16 @@
 #version 330 core
 
-out float fragColor;
+out vec2 fragColor; // (AO, linear depth). 깊이는 bilateral blur에서 사용
 
 in vec2 texCoord;
 
-uniform sampler2D gPosition;
+uniform sampler2D linearDepth; // SSAO 해상도의 linear depth (ssao_depth.fs)
 uniform sampler2D gNormal;
 uniform sampler2D texNoise;
 
 uniform mat4 view;
 uniform mat4 projection;
+uniform int downsample; // SSAO 해상도 배율 (1, 2, 4)
 
 uniform vec2 noiseScale;
 uniform float radius;
@@ -17,18 +18,35 @@ uniform float radius;
 const int KERNEL_SIZE = 64;
 const float BIAS = 0.025; // acne 현상 보정값
 uniform vec3 samples[KERNEL_SIZE];
+// temporal 누적을 쓰면 프레임마다 kernel의 일부(sampleCount개, sampleOffset부터 KERNEL_SIZE / sampleCount 간격)만 사용
+uniform int sampleCount;
+uniform int sampleOffset;
+uniform vec2 temporalJitter; // x : 노이즈 회전(1 = 한 바퀴)
+
+#include "normal_encoding.glsl"
+
+// 화면 좌표와 linear depth로 view space 좌표를 복원 (대칭 원근 투영)
+vec3 GetViewPosition(vec2 uv, float depth) {
+    return vec3((uv * 2.0 - 1.0) * depth / vec2(projection[0][0], projection[1][1]), -depth);
+}
 
 void main() {
-    // 프레임버퍼에 기록된 월드좌표를 가져옴
-    vec4 worldPos = texture(gPosition, texCoord);
-    if(worldPos.w <= 0.0f)
-        discard;
-    // view transform
-    vec3 fragPos = (view * vec4(worldPos.xyz, 1.0)).xyz;
-    vec3 normal = (view * vec4(texture(gNormal, texCoord).xyz, 0.0)).xyz;
+    // linearDepth에는 mip chain이 있으므로 항상 level 0을 읽음
+    float depth = textureLod(linearDepth, texCoord, 0.0).r;
+    if(depth <= 0.0) {
+        fragColor = vec2(1.0, 0.0);
+        return;
+    }
+    // depth, normal은 블록의 왼쪽 아래 texel에서 가져온 값
+    ivec2 texel = ivec2(gl_FragCoord.xy) * downsample;
+    vec2 uv = (vec2(texel) + 0.5) / vec2(textureSize(gNormal, 0));
+    vec3 fragPos = GetViewPosition(uv, depth);
+    vec3 normal = (view * vec4(DecodeNormal(texelFetch(gNormal, texel, 0).rg), 0.0)).xyz;
     // 스크린을 분할해서 texNosie 크기(4x4)에 매칭했을 때 해당되는 노이즈값
     // 노이즈값은 랜덤으로 설정한 샘플링 방향 벡터로 입력 돼있음
     vec3 randomVec = texture(texNoise, texCoord * noiseScale).xyz;
+    float angle = temporalJitter.x * 6.28318531;
+    randomVec.xy = mat2(cos(angle), sin(angle), -sin(angle), cos(angle)) * randomVec.xy;
     
     // 그람슈미트 직교화 : 노말 벡터와 수직한 벡터를 구함
     vec3 tangent = normalize(randomVec - normal * dot(randomVec, normal));
@@ -36,17 +54,21 @@ void main() {
     mat3 TBN = mat3(tangent, bitangent, normal);
 
     float occlusion = 0.0;
-    for(int i = 0; i < KERNEL_SIZE; i++) {
-        vec3 sample = fragPos + TBN * samples[i] * radius;
+    int sampleStride = KERNEL_SIZE / sampleCount;
+    for(int i = 0; i < sampleCount; i++) {
+        vec3 sample = fragPos + TBN * samples[i * sampleStride + sampleOffset] * radius;
         vec4 screenSample = projection * vec4(sample, 1.0);
         screenSample.xyz /= screenSample.w;
         screenSample.xyz = screenSample.xyz * 0.5 + 0.5;
 
-        float sampleDepth = (view * texture(gPosition, screenSample.xy)).z;
+        float sampleLinear = textureLod(linearDepth, screenSample.xy, 0.0).r;
+        if (sampleLinear <= 0.0)
+            continue; // 아무것도 없는 곳
+        float sampleDepth = -sampleLinear;
         float rangeCheck = smoothstep(0.0, 1.0, radius / abs(fragPos.z - sampleDepth));
         occlusion += (sampleDepth >= sample.z + BIAS ? 1.0 : 0.0) * rangeCheck;
     }
 
-    fragColor = 1.0 - occlusion / KERNEL_SIZE;
+    fragColor = vec2(1.0 - occlusion / float(sampleCount), depth);
 
 }
\ No newline at end of file
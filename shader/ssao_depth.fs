@@ -0,0 +1,14 @@
+#version 330 core
+
+out float linearDepth;
+
+uniform sampler2D gDepth;
+uniform mat4 projection;
+uniform int downsample; // SSAO 해상도 배율 (1, 2, 4)
+
+void main() {
+    // 블록마다 왼쪽 아래 texel 하나를 사용. ssao.fs가 normal도 같은 texel에서 읽음
+    float depth = texelFetch(gDepth, ivec2(gl_FragCoord.xy) * downsample, 0).r;
+    // 카메라 앞쪽 거리(양수). 아무것도 그려지지 않은 픽셀은 0
+    linearDepth = depth >= 1.0 ? 0.0 : projection[3][2] / (depth * 2.0 - 1.0 + projection[2][2]);
+}
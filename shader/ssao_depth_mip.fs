@@ -0,0 +1,14 @@
+#version 330 core
+
+out float fragDepth;
+
+uniform sampler2D linearDepth; // GL_TEXTURE_BASE_LEVEL을 이전 level로 맞춘 상태
+
+void main() {
+    ivec2 texel = ivec2(gl_FragCoord.xy);
+    // 평균을 내면 경계에 없는 깊이가 생기므로 2x2 중 하나를 고름
+    // 고르는 위치를 texel마다 엇갈리게(rotated grid) 해서 한쪽으로 치우치지 않게 함
+    ivec2 pick = ivec2((texel.y & 1) ^ 1, (texel.x & 1) ^ 1);
+    ivec2 maxCoord = textureSize(linearDepth, 0) - 1;
+    fragDepth = texelFetch(linearDepth, min(texel * 2 + pick, maxCoord), 0).r;
+}
@@ -0,0 +1,55 @@
+#version 330 core
+
+out vec2 fragColor; // (AO, linear depth). 다음 프레임의 history
+
+uniform sampler2D current;    // 이번 프레임 AO (AO, linear depth)
+uniform sampler2D history;    // 이전 프레임 결과 (AO, linear depth)
+uniform int historyValid;
+uniform mat4 reprojection;    // 이번 프레임 view space -> 이전 프레임 clip space
+uniform mat4 projection;
+uniform vec2 screenSize;      // 전체 해상도
+uniform int downsample;       // SSAO 해상도 배율 (1, 2, 4)
+
+const float HISTORY_WEIGHT = 0.9;   // 약 10 프레임을 누적
+const float DEPTH_THRESHOLD = 0.1;  // 상대 깊이 차이가 이보다 크면 가려졌던 곳으로 보고 history를 버림
+
+void main() {
+    ivec2 texel = ivec2(gl_FragCoord.xy);
+    vec2 center = texelFetch(current, texel, 0).rg;
+    if (center.y <= 0.0 || historyValid == 0) {
+        fragColor = center;
+        return;
+    }
+
+    // SSAO 해상도 texel k는 전체 해상도 texel k * downsample의 위치
+    vec2 uv = (vec2(texel * downsample) + 0.5) / screenSize;
+    vec3 viewPos = vec3((uv * 2.0 - 1.0) * center.y / vec2(projection[0][0], projection[1][1]), -center.y);
+    // 물체는 움직이지 않으므로 카메라 움직임만으로 이전 위치를 구함
+    vec4 prevClip = reprojection * vec4(viewPos, 1.0);
+    vec2 prevUv = prevClip.xy / prevClip.w * 0.5 + 0.5;
+    if (prevClip.w <= 0.0 || any(lessThan(prevUv, vec2(0.0))) || any(greaterThan(prevUv, vec2(1.0)))) {
+        fragColor = center; // 화면 밖에서 들어온 곳
+        return;
+    }
+    vec2 historyTexel = (prevUv * screenSize - 0.5) / float(downsample);
+    vec2 prev = texture(history, (historyTexel + 0.5) / vec2(textureSize(history, 0))).rg;
+    // 이전 프레임의 linear depth는 prevClip.w
+    if (prev.y <= 0.0 || abs(prev.y - prevClip.w) / prevClip.w > DEPTH_THRESHOLD) {
+        fragColor = center;
+        return;
+    }
+
+    // 주변 3x3의 범위로 history를 제한해서 남은 ghosting을 줄임
+    float minAo = center.x;
+    float maxAo = center.x;
+    ivec2 maxCoord = textureSize(current, 0) - 1;
+    for (int y = -1; y <= 1; y++) {
+        for (int x = -1; x <= 1; x++) {
+            float ao = texelFetch(current, clamp(texel + ivec2(x, y), ivec2(0), maxCoord), 0).r;
+            minAo = min(minAo, ao);
+            maxAo = max(maxAo, ao);
+        }
+    }
+    float historyAo = clamp(prev.x, minAo, maxAo);
+    fragColor = vec2(mix(center.x, historyAo, HISTORY_WEIGHT), center.y);
+}
@@ -0,0 +1,50 @@
+#version 330 core
+
+out float fragColor;
+
+uniform sampler2D ssaoInput;   // 저해상도 AO
+uniform sampler2D linearDepth; // 저해상도 linear depth (ssao_depth.fs)
+uniform sampler2D gDepth;      // 전체 해상도 depth
+uniform mat4 projection;
+uniform int downsample;
+
+// 상대 깊이 차이가 이보다 크면 다른 표면으로 보고 섞지 않음
+const float DEPTH_THRESHOLD = 0.1;
+
+void main() {
+    float depth = texelFetch(gDepth, ivec2(gl_FragCoord.xy), 0).r;
+    if (depth >= 1.0) {
+        fragColor = 1.0;
+        return;
+    }
+    float linear = projection[3][2] / (depth * 2.0 - 1.0 + projection[2][2]);
+
+    // 저해상도 texel k는 전체 해상도 texel k * downsample의 값을 가짐
+    vec2 position = (gl_FragCoord.xy - 0.5) / float(downsample);
+    ivec2 base = ivec2(floor(position));
+    vec2 f = position - vec2(base);
+    ivec2 maxCoord = textureSize(linearDepth, 0) - 1;
+
+    // bilinear 가중치에 깊이 차이 가중치를 곱함 (bilateral upsampling)
+    float total = 0.0;
+    float totalWeight = 0.0;
+    float closestDiff = 1e30;
+    float closestAo = 1.0;
+    for (int i = 0; i < 4; i++) {
+        ivec2 offset = ivec2(i & 1, i >> 1);
+        ivec2 coord = clamp(base + offset, ivec2(0), maxCoord);
+        float sampleDepth = texelFetch(linearDepth, coord, 0).r;
+        float ao = texelFetch(ssaoInput, coord, 0).r;
+        float diff = abs(sampleDepth - linear) / linear;
+        vec2 bilinear = mix(1.0 - f, f, vec2(offset));
+        float weight = bilinear.x * bilinear.y * max(1.0 - diff / DEPTH_THRESHOLD, 0.0);
+        total += ao * weight;
+        totalWeight += weight;
+        if (diff < closestDiff) {
+            closestDiff = diff;
+            closestAo = ao;
+        }
+    }
+    // 네 texel 모두 다른 표면이면 깊이가 가장 가까운 texel 사용
+    fragColor = totalWeight > 0.0001 ? total / totalWeight : closestAo;
+}
@@ -1,4 +1,8 @@
 #include "buffer.h"
+#include "capture.h"
+#include "renderstats.h"
+#include <chrono>
+#include <cstring>
 
 BufferUPtr Buffer::CreateWithData(uint32_t bufferType, uint32_t usage, const void *data, size_t stride, size_t count)
 {
@@ -8,11 +12,31 @@ BufferUPtr Buffer::CreateWithData(uint32_t bufferType, uint32_t usage, const voi
     return std::move(buffer);
 }
 
+BufferUPtr Buffer::CreateStream(uint32_t bufferType, size_t stride, size_t count, uint32_t frameCount)
+{
+    auto buffer = BufferUPtr(new Buffer());
+    if (!buffer->InitStream(bufferType, stride, count, frameCount))
+        return nullptr;
+    return std::move(buffer);
+}
+
 Buffer::~Buffer()
 {
+    for (auto fence : m_fences)
+    {
+        if (fence)
+            glDeleteSync(fence);
+    }
     if (m_buffer)
     {
+        if (m_persistent)
+        {
+            Bind();
+            glUnmapBuffer(m_bufferType);
+        }
         glDeleteBuffers(1, &m_buffer);
+        if (m_memorySize)
+            RenderStats::TrackBuffer(-1, -(int64_t)m_memorySize);
     }
 }
 
@@ -30,5 +54,184 @@ bool Buffer::Init(uint32_t bufferType, uint32_t usage, const void *data, size_t
     glGenBuffers(1, &m_buffer); // buffer object 생성
     Bind();  // buffer object 지정
     glBufferData(m_bufferType, m_stride * m_count, data, usage); // buffer에 데이터 복사
+    m_memorySize = m_stride * m_count;
+    if (m_memorySize)
+        RenderStats::TrackBuffer(1, m_memorySize);
     return true;
-}
\ No newline at end of file
+}
+
+bool Buffer::InitStream(uint32_t bufferType, size_t stride, size_t count, uint32_t frameCount)
+{
+    m_bufferType = bufferType;
+    m_usage = GL_STREAM_DRAW;
+    m_stride = stride;
+    m_count = count;
+    m_stream = true;
+
+    // 영역 시작 위치가 uniform buffer offset 정렬 조건(최대 256)을 만족하도록 맞춤
+    const size_t alignment = 256;
+    m_regionSize = (stride * count + alignment - 1) / alignment * alignment;
+
+    glGenBuffers(1, &m_buffer);
+    Bind();
+
+    if (GLAD_GL_VERSION_4_4 || GLAD_GL_ARB_buffer_storage)
+    {
+        // persistent mapping : 한번 매핑한 포인터를 계속 사용하고 fence로 GPU 사용 여부만 확인
+        const GLbitfield flags = GL_MAP_WRITE_BIT | GL_MAP_PERSISTENT_BIT | GL_MAP_COHERENT_BIT;
+        m_fences.resize(frameCount, nullptr);
+        glBufferStorage(m_bufferType, m_regionSize * frameCount, nullptr, flags);
+        m_persistent = (uint8_t *)glMapBufferRange(m_bufferType, 0, m_regionSize * frameCount, flags);
+        if (!m_persistent)
+        {
+            SPDLOG_ERROR("failed to map persistent buffer");
+            return false;
+        }
+    }
+    else
+    {
+        // orphaning : 매 Map마다 저장공간을 새로 할당받아 GPU가 사용 중인 영역과 겹치지 않게 함
+        glBufferData(m_bufferType, m_regionSize, nullptr, m_usage);
+    }
+    m_memorySize = m_persistent ? m_regionSize * frameCount : m_regionSize;
+    if (m_memorySize)
+        RenderStats::TrackBuffer(1, m_memorySize);
+    return true;
+}
+
+void Buffer::WaitFence(uint32_t frameIndex)
+{
+    auto &fence = m_fences[frameIndex];
+    if (!fence)
+    {
+        m_fenceWaitTime = 0.0f;
+        return;
+    }
+
+    auto start = std::chrono::high_resolution_clock::now();
+    GLbitfield waitFlags = 0;
+    while (true)
+    {
+        auto result = glClientWaitSync(fence, waitFlags, 1000000); // 1ms
+        if (result == GL_ALREADY_SIGNALED || result == GL_CONDITION_SATISFIED)
+            break;
+        if (result == GL_WAIT_FAILED)
+        {
+            SPDLOG_ERROR("failed to wait buffer fence");
+            break;
+        }
+        waitFlags = GL_SYNC_FLUSH_COMMANDS_BIT;
+    }
+    auto end = std::chrono::high_resolution_clock::now();
+
+    glDeleteSync(fence);
+    fence = nullptr;
+
+    m_fenceWaitTime = std::chrono::duration<float, std::milli>(end - start).count();
+    m_totalFenceWaitTime += m_fenceWaitTime;
+    RenderStats::AddFenceWait(m_fenceWaitTime);
+}
+
+void *Buffer::Map()
+{
+    if (m_mapped)
+        return nullptr;
+    m_mapped = true;
+
+    if (m_persistent)
+    {
+        WaitFence(m_frameIndex);
+        m_mappedOffset = GetOffset();
+        m_mappedSize = m_regionSize;
+        m_mappedData = m_persistent + m_mappedOffset;
+        return m_mappedData;
+    }
+
+    Bind();
+    m_mappedOffset = 0;
+    if (m_stream)
+    {
+        glBufferData(m_bufferType, m_regionSize, nullptr, m_usage); // orphan
+        m_mappedSize = m_regionSize;
+        m_mappedData = (uint8_t *)glMapBufferRange(m_bufferType, 0, m_regionSize,
+                                                   GL_MAP_WRITE_BIT | GL_MAP_INVALIDATE_BUFFER_BIT);
+    }
+    else
+    {
+        m_mappedSize = GetSize();
+        m_mappedData = (uint8_t *)glMapBufferRange(m_bufferType, 0, GetSize(), GL_MAP_WRITE_BIT);
+    }
+    // 매핑에 실패하면 Unmap 없이도 다음 Map을 다시 시도할 수 있도록 상태를 되돌림
+    if (!m_mappedData)
+    {
+        SPDLOG_ERROR("failed to map buffer");
+        m_mapped = false;
+    }
+    return m_mappedData;
+}
+
+void Buffer::Unmap()
+{
+    if (!m_mapped)
+        return;
+    m_mapped = false;
+    if (m_mappedData)
+    {
+        FrameCapture::RecordUpdateBuffer(m_buffer, m_mappedOffset, m_mappedData, m_mappedSize);
+        RenderStats::AddBufferUpload(m_mappedSize);
+    }
+    m_mappedData = nullptr;
+
+    if (m_persistent)
+        return; // coherent mapping이므로 별도의 flush 불필요
+
+    Bind();
+    glUnmapBuffer(m_bufferType);
+}
+
+void Buffer::Update(const void *data, size_t count, size_t offset)
+{
+    if (offset + count > m_count)
+    {
+        SPDLOG_ERROR("buffer update out of range: {} + {} > {}", offset, count, m_count);
+        return;
+    }
+
+    if (m_stream)
+    {
+        // stream 버퍼는 매번 다른 영역에 쓰므로 중간부터 쓰면 앞부분에 몇 프레임 전 내용이 남음
+        // 처음부터 쓰는 경우만 허용하고, count 이후는 사용하지 않는 것으로 봄
+        if (offset != 0)
+        {
+            SPDLOG_ERROR("partial update on stream buffer: {} + {} / {}", offset, count, m_count);
+            return;
+        }
+        auto ptr = (uint8_t *)Map();
+        if (!ptr)
+            return;
+        memcpy(ptr, data, count * m_stride);
+        m_mappedSize = count * m_stride; // 실제로 쓴 만큼만 기록
+        Unmap();
+        return;
+    }
+
+    Bind();
+    glBufferSubData(m_bufferType, offset * m_stride, count * m_stride, data);
+    FrameCapture::RecordUpdateBuffer(m_buffer, offset * m_stride, data, count * m_stride);
+    RenderStats::AddBufferUpload(count * m_stride);
+}
+
+void Buffer::Fence()
+{
+    if (!m_stream)
+        return;
+
+    if (m_persistent)
+    {
+        // Map 없이 Fence가 두번 불리면 이전 fence가 남아 있으므로 지우고 새로 만듦
+        if (m_fences[m_frameIndex])
+            glDeleteSync(m_fences[m_frameIndex]);
+        m_fences[m_frameIndex] = glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0);
+        m_frameIndex = (m_frameIndex + 1) % (uint32_t)m_fences.size();
+    }
+}
@@ -1,6 +1,7 @@
 #pragma once
 
 #include "common.h"
+#include <vector>
 
 CLASS_PTR(Buffer)
 class Buffer
@@ -8,20 +9,56 @@ class Buffer
 public:
     static BufferUPtr CreateWithData(uint32_t bufferType, uint32_t usage,
                                      const void *data, size_t stride, size_t count);
+    // 매 프레임 갱신되는 데이터용 버퍼. frameCount개의 영역을 링 형태로 돌려가며 사용
+    static BufferUPtr CreateStream(uint32_t bufferType, size_t stride, size_t count,
+                                   uint32_t frameCount = 3);
     ~Buffer();
     uint32_t Get() const { return m_buffer; }
     void Bind() const;
 
+    // offset, count : stride 단위
+    // stream 버퍼는 매번 새 영역에 처음부터 count개를 씀(offset은 0만 가능). count 이후는 정의되지 않으므로
+    // 읽는 쪽이 count개만 사용해야 함 (BufferTexture는 glTexBufferRange로 범위를 제한)
+    void Update(const void *data, size_t count, size_t offset = 0);
+    void *Map();
+    void Unmap();
+    // stream 버퍼 : 현재 영역을 사용하는 draw 호출 이후에 호출. fence를 걸고 다음 영역으로 이동
+    void Fence();
+
     size_t GetStride() const { return m_stride; }
     size_t GetCount() const { return m_count; }
+    size_t GetSize() const { return m_stride * m_count; }
+    // 현재 프레임 영역의 byte offset (stream 버퍼가 아니면 항상 0)
+    size_t GetOffset() const { return m_persistent ? m_frameIndex * m_regionSize : 0; }
+    bool IsStream() const { return m_stream; }
+    bool IsPersistent() const { return m_persistent != nullptr; }
+    float GetFenceWaitTime() const { return m_fenceWaitTime; } // ms, 마지막 Map
+    float GetTotalFenceWaitTime() const { return m_totalFenceWaitTime; }
 
 private:
     Buffer() {}
     bool Init(uint32_t bufferType, uint32_t usage,
               const void *data, size_t stride, size_t count);
+    bool InitStream(uint32_t bufferType, size_t stride, size_t count, uint32_t frameCount);
+    void WaitFence(uint32_t frameIndex);
+
     uint32_t m_buffer{0};
     uint32_t m_bufferType{0};
     uint32_t m_usage{0};
     size_t m_stride{0};
     size_t m_count{0};
-};
\ No newline at end of file
+    size_t m_memorySize{0}; // 할당된 전체 byte (stream 버퍼는 모든 영역 포함)
+
+    // stream
+    bool m_stream{false};
+    bool m_mapped{false};
+    uint8_t *m_mappedData{nullptr}; // frame capture에 쓴 내용을 기록하기 위한 매핑 정보
+    size_t m_mappedOffset{0};
+    size_t m_mappedSize{0};
+    size_t m_regionSize{0};
+    uint32_t m_frameIndex{0};
+    uint8_t *m_persistent{nullptr}; // persistent mapping 포인터 (지원하지 않으면 nullptr)
+    std::vector<GLsync> m_fences;
+    float m_fenceWaitTime{0.0f};
+    float m_totalFenceWaitTime{0.0f};
+};
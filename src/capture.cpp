@@ -0,0 +1,1270 @@
+#include "capture.h"
+#include "framebuffer.h"
+#include <algorithm>
+#include <cstring>
+#include <fstream>
+#include <type_traits>
+#include <unordered_set>
+
+static const uint32_t CAPTURE_MAGIC = 0x50434C47; // "GLCP"
+static const uint32_t CAPTURE_VERSION = 6;
+
+const char *GetCaptureOpName(CaptureOp op)
+{
+    switch (op)
+    {
+    case CaptureOp::UseProgram:
+        return "use program";
+    case CaptureOp::Uniform:
+        return "uniform";
+    case CaptureOp::BindTexture:
+        return "bind texture";
+    case CaptureOp::BindVertexArray:
+        return "bind vertex array";
+    case CaptureOp::BindFramebuffer:
+        return "bind framebuffer";
+    case CaptureOp::UpdateBuffer:
+        return "update buffer";
+    case CaptureOp::SetState:
+        return "set state";
+    case CaptureOp::Clear:
+        return "clear";
+    case CaptureOp::Draw:
+        return "draw";
+    case CaptureOp::Blit:
+        return "blit";
+    default:
+        return "unknown";
+    }
+}
+
+// 저장/읽기가 같은 코드를 타도록 하나로 묶은 직렬화 도구
+class CaptureArchive
+{
+public:
+    CaptureArchive(std::fstream &file, bool loading) : m_file(file), m_loading(loading)
+    {
+        if (!m_loading)
+            return;
+        // 읽을 때 길이 값이 남은 파일 크기를 넘는지 확인하기 위해 전체 길이를 기록
+        auto start = m_file.tellg();
+        m_file.seekg(0, std::ios::end);
+        m_fileSize = (uint64_t)m_file.tellg();
+        m_file.seekg(start);
+    }
+
+    template <typename T>
+    void operator()(T &value)
+    {
+        if constexpr (std::is_trivially_copyable_v<T>)
+        {
+            if (m_loading)
+                m_file.read((char *)&value, sizeof(T));
+            else
+                m_file.write((const char *)&value, sizeof(T));
+        }
+        else
+        {
+            Serialize(*this, value);
+        }
+    }
+
+    void operator()(std::string &value)
+    {
+        uint64_t size = value.size();
+        (*this)(size);
+        if (m_loading)
+            value.resize(CheckSize(size, 1));
+        Bytes(value.data(), value.size());
+    }
+
+    void operator()(std::vector<uint8_t> &value)
+    {
+        uint64_t size = value.size();
+        (*this)(size);
+        if (m_loading)
+            value.resize(CheckSize(size, 1));
+        Bytes(value.data(), value.size());
+    }
+
+    template <typename T>
+    void operator()(std::vector<T> &value)
+    {
+        uint64_t size = value.size();
+        (*this)(size);
+        // 직렬화된 원소는 최소 1 byte 이상이므로 남은 크기로 개수의 상한을 정할 수 있음
+        if (m_loading)
+            value.resize(CheckSize(size, std::is_trivially_copyable_v<T> ? sizeof(T) : 1));
+        for (auto &item : value)
+            (*this)(item);
+    }
+
+    bool IsLoading() const { return m_loading; }
+
+private:
+    // 손상된 파일의 큰 길이 값으로 거대한 메모리를 할당하지 않도록
+    // 남은 파일 크기로 담을 수 없는 개수면 stream을 실패 상태로 만들고 0을 반환
+    size_t CheckSize(uint64_t count, uint64_t elementSize)
+    {
+        auto position = m_file.tellg();
+        if (!m_file.good() || position < 0)
+            return 0;
+        uint64_t remaining = m_fileSize - std::min(m_fileSize, (uint64_t)position);
+        if (count > remaining / elementSize)
+        {
+            m_file.setstate(std::ios::failbit);
+            return 0;
+        }
+        return (size_t)count;
+    }
+
+    void Bytes(void *data, uint64_t size)
+    {
+        if (m_loading)
+            m_file.read((char *)data, size);
+        else
+            m_file.write((const char *)data, size);
+    }
+
+    std::fstream &m_file;
+    bool m_loading;
+    uint64_t m_fileSize{0};
+};
+
+static void Serialize(CaptureArchive &ar, CaptureCommand &value)
+{
+    ar(value.op);
+    ar(value.args);
+    ar(value.name);
+    ar(value.data);
+}
+
+static void Serialize(CaptureArchive &ar, CaptureUniform &value)
+{
+    ar(value.name);
+    ar(value.type);
+    ar(value.data);
+}
+
+static void Serialize(CaptureArchive &ar, CaptureShader &value)
+{
+    ar(value.type);
+    ar(value.source);
+}
+
+static void Serialize(CaptureArchive &ar, CaptureProgram &value)
+{
+    ar(value.id);
+    ar(value.shaders);
+    ar(value.uniforms);
+    ar(value.binaryFormat);
+    ar(value.binary);
+}
+
+static void Serialize(CaptureArchive &ar, CaptureBuffer &value)
+{
+    ar(value.id);
+    ar(value.data);
+}
+
+static void Serialize(CaptureArchive &ar, CaptureTexture &value)
+{
+    ar(value.id);
+    ar(value.target);
+    ar(value.internalFormat);
+    ar(value.buffer);
+    ar(value.bufferOffset);
+    ar(value.bufferSize);
+    ar(value.width);
+    ar(value.height);
+    ar(value.layers);
+    ar(value.dataFormat);
+    ar(value.dataType);
+    ar(value.minFilter);
+    ar(value.magFilter);
+    ar(value.wrapS);
+    ar(value.wrapT);
+    ar(value.wrapR);
+    ar(value.borderColor);
+    ar(value.faces);
+}
+
+static void Serialize(CaptureArchive &ar, CaptureVertexArray &value)
+{
+    ar(value.id);
+    ar(value.elementBuffer);
+    ar(value.attribs);
+}
+
+static void Serialize(CaptureArchive &ar, CaptureFramebuffer &value)
+{
+    ar(value.id);
+    ar(value.attachments);
+    ar(value.drawBuffers);
+    ar(value.readBuffer);
+}
+
+static void Serialize(CaptureArchive &ar, CaptureData &value)
+{
+    ar(value.programs);
+    ar(value.buffers);
+    ar(value.textures);
+    ar(value.vertexArrays);
+    ar(value.framebuffers);
+    ar(value.commands);
+}
+
+bool CaptureData::Save(const std::string &filename) const
+{
+    std::fstream file(filename, std::ios::out | std::ios::binary);
+    if (!file.is_open())
+    {
+        SPDLOG_ERROR("failed to open capture file: {}", filename);
+        return false;
+    }
+
+    CaptureArchive ar(file, false);
+    uint32_t magic = CAPTURE_MAGIC;
+    uint32_t version = CAPTURE_VERSION;
+    ar(magic);
+    ar(version);
+    ar(const_cast<CaptureData &>(*this));
+    return file.good();
+}
+
+bool CaptureData::Load(const std::string &filename)
+{
+    std::fstream file(filename, std::ios::in | std::ios::binary);
+    if (!file.is_open())
+    {
+        SPDLOG_ERROR("failed to open capture file: {}", filename);
+        return false;
+    }
+
+    CaptureArchive ar(file, true);
+    uint32_t magic = 0, version = 0;
+    ar(magic);
+    ar(version);
+    if (magic != CAPTURE_MAGIC || version != CAPTURE_VERSION)
+    {
+        SPDLOG_ERROR("invalid capture file: {} (version {})", filename, version);
+        return false;
+    }
+    ar(*this);
+    if (!file.good())
+    {
+        SPDLOG_ERROR("failed to read capture file: {}", filename);
+        return false;
+    }
+    return true;
+}
+
+CaptureStats CaptureStats::Compute(const CaptureData &data)
+{
+    CaptureStats stats;
+    for (auto &command : data.commands)
+    {
+        if (command.op >= CaptureOp::Count)
+            continue;
+        stats.opCounts[(size_t)command.op]++;
+        if (command.op == CaptureOp::Draw)
+            stats.indexCount += (uint64_t)command.args[1] * std::max(command.args[4], 1u);
+    }
+    return stats;
+}
+
+void CaptureStats::Print() const
+{
+    for (size_t i = 0; i < opCounts.size(); i++)
+        SPDLOG_INFO("  {:<20} {:8}", GetCaptureOpName((CaptureOp)i), opCounts[i]);
+    SPDLOG_INFO("  {:<20} {:8}", "indices", indexCount);
+}
+
+void CaptureStats::PrintDiff(const CaptureStats &a, const CaptureStats &b)
+{
+    SPDLOG_INFO("  {:<20} {:>8} {:>8} {:>8}", "", "a", "b", "diff");
+    for (size_t i = 0; i < a.opCounts.size(); i++)
+    {
+        SPDLOG_INFO("  {:<20} {:8} {:8} {:+8}", GetCaptureOpName((CaptureOp)i),
+                    a.opCounts[i], b.opCounts[i], b.opCounts[i] - a.opCounts[i]);
+    }
+    SPDLOG_INFO("  {:<20} {:8} {:8} {:+8}", "indices", a.indexCount, b.indexCount,
+                (int64_t)b.indexCount - (int64_t)a.indexCount);
+}
+
+// ---------------------------------------------------------------------------
+// 기록
+
+struct CaptureRecorder
+{
+    std::string filename;
+    CaptureData data;
+    std::unordered_set<uint32_t> programs;
+    std::unordered_set<uint32_t> buffers;
+    std::unordered_set<uint32_t> textures;
+    std::unordered_set<uint32_t> vertexArrays;
+    std::unordered_set<uint32_t> framebuffers;
+    uint32_t framebuffer{0}; // 기록된 draw framebuffer (0 : 기본)
+    bool hasState{false};
+    CaptureState state;
+};
+
+static std::string s_captureRequest;
+static std::unique_ptr<CaptureRecorder> s_recorder;
+struct BufferTextureBinding
+{
+    uint32_t internalFormat{0};
+    uint32_t buffer{0};
+    uint64_t offset{0};
+    uint64_t size{0};
+};
+// texture buffer -> 연결된 버퍼와 범위
+static std::unordered_map<uint32_t, BufferTextureBinding> s_bufferTextures;
+
+// uniform 타입별 byte 크기. 지원하지 않는 타입은 0
+static size_t GetUniformSize(uint32_t type)
+{
+    switch (type)
+    {
+    case GL_FLOAT:
+    case GL_INT:
+    case GL_UNSIGNED_INT:
+    case GL_BOOL:
+    case GL_SAMPLER_2D:
+    case GL_SAMPLER_2D_SHADOW:
+    case GL_SAMPLER_2D_ARRAY:
+    case GL_SAMPLER_2D_ARRAY_SHADOW:
+    case GL_SAMPLER_CUBE:
+    case GL_SAMPLER_BUFFER:
+    case GL_INT_SAMPLER_BUFFER:
+    case GL_UNSIGNED_INT_SAMPLER_BUFFER:
+        return 4;
+    case GL_FLOAT_VEC2:
+    case GL_INT_VEC2:
+        return 8;
+    case GL_FLOAT_VEC3:
+    case GL_INT_VEC3:
+        return 12;
+    case GL_FLOAT_VEC4:
+    case GL_INT_VEC4:
+        return 16;
+    case GL_FLOAT_MAT3:
+        return 36;
+    case GL_FLOAT_MAT4:
+        return 64;
+    default:
+        return 0;
+    }
+}
+
+static bool IsFloatUniform(uint32_t type)
+{
+    return type == GL_FLOAT || type == GL_FLOAT_VEC2 || type == GL_FLOAT_VEC3 ||
+           type == GL_FLOAT_VEC4 || type == GL_FLOAT_MAT3 || type == GL_FLOAT_MAT4;
+}
+
+static void SnapshotBuffer(CaptureRecorder &recorder, uint32_t buffer)
+{
+    if (!buffer || recorder.buffers.count(buffer))
+        return;
+    recorder.buffers.insert(buffer);
+
+    int previous = 0;
+    glGetIntegerv(GL_COPY_READ_BUFFER_BINDING, &previous);
+    glBindBuffer(GL_COPY_READ_BUFFER, buffer);
+    int size = 0;
+    glGetBufferParameteriv(GL_COPY_READ_BUFFER, GL_BUFFER_SIZE, &size);
+
+    CaptureBuffer capture;
+    capture.id = buffer;
+    capture.data.resize(size);
+    if (size > 0)
+        glGetBufferSubData(GL_COPY_READ_BUFFER, 0, size, capture.data.data());
+    glBindBuffer(GL_COPY_READ_BUFFER, previous);
+    recorder.data.buffers.push_back(std::move(capture));
+}
+
+static void SnapshotTexture(CaptureRecorder &recorder, uint32_t target, uint32_t texture)
+{
+    if (!texture || recorder.textures.count(texture))
+        return;
+    if (target == GL_TEXTURE_BUFFER)
+    {
+        auto found = s_bufferTextures.find(texture);
+        if (found == s_bufferTextures.end())
+            return;
+        recorder.textures.insert(texture);
+        CaptureTexture capture;
+        capture.id = texture;
+        capture.target = target;
+        capture.internalFormat = found->second.internalFormat;
+        capture.buffer = found->second.buffer;
+        capture.bufferOffset = found->second.offset;
+        capture.bufferSize = found->second.size;
+        SnapshotBuffer(recorder, capture.buffer);
+        recorder.data.textures.push_back(std::move(capture));
+        return;
+    }
+    if (target != GL_TEXTURE_2D && target != GL_TEXTURE_2D_ARRAY && target != GL_TEXTURE_CUBE_MAP)
+        return;
+
+    int previous = 0;
+    glGetIntegerv(target == GL_TEXTURE_2D         ? GL_TEXTURE_BINDING_2D
+                  : target == GL_TEXTURE_2D_ARRAY ? GL_TEXTURE_BINDING_2D_ARRAY
+                                                  : GL_TEXTURE_BINDING_CUBE_MAP,
+                  &previous);
+    glBindTexture(target, texture);
+
+    uint32_t levelTarget = target == GL_TEXTURE_CUBE_MAP ? GL_TEXTURE_CUBE_MAP_POSITIVE_X : target;
+    CaptureTexture capture;
+    capture.id = texture;
+    capture.target = target;
+    int internalFormat = 0, depthSize = 0, stencilSize = 0, redSize = 0, redType = 0;
+    glGetTexLevelParameteriv(levelTarget, 0, GL_TEXTURE_WIDTH, &capture.width);
+    glGetTexLevelParameteriv(levelTarget, 0, GL_TEXTURE_HEIGHT, &capture.height);
+    if (target == GL_TEXTURE_2D_ARRAY)
+        glGetTexLevelParameteriv(levelTarget, 0, GL_TEXTURE_DEPTH, &capture.layers);
+    glGetTexLevelParameteriv(levelTarget, 0, GL_TEXTURE_INTERNAL_FORMAT, &internalFormat);
+    glGetTexLevelParameteriv(levelTarget, 0, GL_TEXTURE_DEPTH_SIZE, &depthSize);
+    glGetTexLevelParameteriv(levelTarget, 0, GL_TEXTURE_STENCIL_SIZE, &stencilSize);
+    glGetTexLevelParameteriv(levelTarget, 0, GL_TEXTURE_RED_SIZE, &redSize);
+    glGetTexLevelParameteriv(levelTarget, 0, GL_TEXTURE_RED_TYPE, &redType);
+
+    // 아직 저장공간이 없는 텍스처는 다음에 다시 시도
+    if (capture.width == 0 || capture.height == 0)
+    {
+        glBindTexture(target, previous);
+        return;
+    }
+    recorder.textures.insert(texture);
+
+    // 내용을 잃지 않는 읽기 형식 선택
+    capture.internalFormat = internalFormat;
+    size_t texelSize = 16;
+    if (depthSize > 0 && stencilSize > 0)
+    {
+        capture.dataFormat = GL_DEPTH_STENCIL;
+        capture.dataType = GL_UNSIGNED_INT_24_8;
+        texelSize = 4;
+    }
+    else if (depthSize > 0)
+    {
+        capture.dataFormat = GL_DEPTH_COMPONENT;
+        capture.dataType = GL_FLOAT;
+        texelSize = 4;
+    }
+    else if (redType == GL_UNSIGNED_INT || redType == GL_INT)
+    {
+        capture.dataFormat = GL_RGBA_INTEGER;
+        capture.dataType = redType;
+    }
+    else if (redType == GL_UNSIGNED_NORMALIZED && redSize <= 8)
+    {
+        capture.dataFormat = GL_RGBA;
+        capture.dataType = GL_UNSIGNED_BYTE;
+        texelSize = 4;
+    }
+    else
+    {
+        capture.dataFormat = GL_RGBA;
+        capture.dataType = GL_FLOAT;
+    }
+
+    glGetTexParameteriv(target, GL_TEXTURE_MIN_FILTER, &capture.minFilter);
+    glGetTexParameteriv(target, GL_TEXTURE_MAG_FILTER, &capture.magFilter);
+    glGetTexParameteriv(target, GL_TEXTURE_WRAP_S, &capture.wrapS);
+    glGetTexParameteriv(target, GL_TEXTURE_WRAP_T, &capture.wrapT);
+    glGetTexParameteriv(target, GL_TEXTURE_WRAP_R, &capture.wrapR);
+    glGetTexParameterfv(target, GL_TEXTURE_BORDER_COLOR, capture.borderColor);
+
+    int packAlignment = 4;
+    glGetIntegerv(GL_PACK_ALIGNMENT, &packAlignment);
+    glPixelStorei(GL_PACK_ALIGNMENT, 1);
+    int faceCount = target == GL_TEXTURE_CUBE_MAP ? 6 : 1;
+    capture.faces.resize(faceCount);
+    for (int i = 0; i < faceCount; i++)
+    {
+        capture.faces[i].resize((size_t)capture.width * capture.height * capture.layers * texelSize);
+        glGetTexImage(faceCount == 6 ? GL_TEXTURE_CUBE_MAP_POSITIVE_X + i : target, 0,
+                      capture.dataFormat, capture.dataType, capture.faces[i].data());
+    }
+    glPixelStorei(GL_PACK_ALIGNMENT, packAlignment);
+
+    glBindTexture(target, previous);
+    recorder.data.textures.push_back(std::move(capture));
+}
+
+static void SnapshotProgram(CaptureRecorder &recorder, uint32_t program)
+{
+    if (!program || recorder.programs.count(program))
+        return;
+    recorder.programs.insert(program);
+
+    CaptureProgram capture;
+    capture.id = program;
+
+    uint32_t shaders[8];
+    int shaderCount = 0;
+    glGetAttachedShaders(program, 8, &shaderCount, shaders);
+    for (int i = 0; i < shaderCount; i++)
+    {
+        CaptureShader shader;
+        int type = 0, length = 0;
+        glGetShaderiv(shaders[i], GL_SHADER_TYPE, &type);
+        glGetShaderiv(shaders[i], GL_SHADER_SOURCE_LENGTH, &length);
+        shader.type = type;
+        shader.source.resize(length);
+        if (length > 0)
+        {
+            glGetShaderSource(shaders[i], length, nullptr, shader.source.data());
+            shader.source.resize(length - 1); // null 문자 제외
+        }
+        capture.shaders.push_back(std::move(shader));
+    }
+    if (shaderCount == 0)
+    {
+        int length = 0;
+        glGetProgramiv(program, GL_PROGRAM_BINARY_LENGTH, &length);
+        capture.binary.resize(length);
+        if (length > 0)
+            glGetProgramBinary(program, length, &length, &capture.binaryFormat, capture.binary.data());
+    }
+
+    // 프레임 이전에 설정된 uniform 값
+    int uniformCount = 0;
+    glGetProgramiv(program, GL_ACTIVE_UNIFORMS, &uniformCount);
+    for (int i = 0; i < uniformCount; i++)
+    {
+        char name[256];
+        int length = 0, size = 0;
+        uint32_t type = 0;
+        glGetActiveUniform(program, i, sizeof(name), &length, &size, &type, name);
+        size_t valueSize = GetUniformSize(type);
+        if (valueSize == 0)
+            continue;
+
+        // 배열은 "name[0]"으로 나오므로 원소별로 나눔
+        std::string baseName(name, length);
+        if (size > 1 && baseName.size() > 3 && baseName.compare(baseName.size() - 3, 3, "[0]") == 0)
+            baseName.resize(baseName.size() - 3);
+        for (int element = 0; element < size; element++)
+        {
+            CaptureUniform uniform;
+            uniform.name = size > 1 ? fmt::format("{}[{}]", baseName, element) : baseName;
+            uniform.type = type;
+            int location = glGetUniformLocation(program, uniform.name.c_str());
+            if (location < 0)
+                continue;
+            uniform.data.resize(valueSize);
+            if (IsFloatUniform(type))
+                glGetUniformfv(program, location, (float *)uniform.data.data());
+            else if (type == GL_UNSIGNED_INT)
+                glGetUniformuiv(program, location, (uint32_t *)uniform.data.data());
+            else
+                glGetUniformiv(program, location, (int *)uniform.data.data());
+            capture.uniforms.push_back(std::move(uniform));
+        }
+    }
+    recorder.data.programs.push_back(std::move(capture));
+}
+
+// 현재 바인딩된 VAO의 구성과 참조하는 버퍼
+static void SnapshotVertexArray(CaptureRecorder &recorder)
+{
+    int vertexArray = 0;
+    glGetIntegerv(GL_VERTEX_ARRAY_BINDING, &vertexArray);
+    if (!vertexArray || recorder.vertexArrays.count(vertexArray))
+        return;
+    recorder.vertexArrays.insert(vertexArray);
+
+    CaptureVertexArray capture;
+    capture.id = vertexArray;
+    int elementBuffer = 0;
+    glGetIntegerv(GL_ELEMENT_ARRAY_BUFFER_BINDING, &elementBuffer);
+    capture.elementBuffer = elementBuffer;
+    SnapshotBuffer(recorder, elementBuffer);
+
+    int maxAttribs = 0;
+    glGetIntegerv(GL_MAX_VERTEX_ATTRIBS, &maxAttribs);
+    for (int i = 0; i < maxAttribs; i++)
+    {
+        int enabled = 0;
+        glGetVertexAttribiv(i, GL_VERTEX_ATTRIB_ARRAY_ENABLED, &enabled);
+        if (!enabled)
+            continue;
+
+        CaptureAttrib attrib;
+        int value = 0;
+        attrib.index = i;
+        glGetVertexAttribiv(i, GL_VERTEX_ATTRIB_ARRAY_BUFFER_BINDING, &value);
+        attrib.buffer = value;
+        glGetVertexAttribiv(i, GL_VERTEX_ATTRIB_ARRAY_SIZE, &attrib.size);
+        glGetVertexAttribiv(i, GL_VERTEX_ATTRIB_ARRAY_TYPE, &value);
+        attrib.type = value;
+        glGetVertexAttribiv(i, GL_VERTEX_ATTRIB_ARRAY_NORMALIZED, &value);
+        attrib.normalized = value;
+        glGetVertexAttribiv(i, GL_VERTEX_ATTRIB_ARRAY_INTEGER, &value);
+        attrib.integer = value;
+        glGetVertexAttribiv(i, GL_VERTEX_ATTRIB_ARRAY_STRIDE, &attrib.stride);
+        glGetVertexAttribiv(i, GL_VERTEX_ATTRIB_ARRAY_DIVISOR, &value);
+        attrib.divisor = value;
+        void *pointer = nullptr;
+        glGetVertexAttribPointerv(i, GL_VERTEX_ATTRIB_ARRAY_POINTER, &pointer);
+        attrib.offset = (uint64_t)pointer;
+
+        SnapshotBuffer(recorder, attrib.buffer);
+        capture.attribs.push_back(attrib);
+    }
+    recorder.data.vertexArrays.push_back(std::move(capture));
+}
+
+static bool ReadAttachment(uint32_t attachment, CaptureAttachment &capture)
+{
+    int type = GL_NONE;
+    glGetFramebufferAttachmentParameteriv(GL_FRAMEBUFFER, attachment,
+                                          GL_FRAMEBUFFER_ATTACHMENT_OBJECT_TYPE, &type);
+    if (type != GL_TEXTURE && type != GL_RENDERBUFFER)
+        return false;
+
+    int name = 0;
+    glGetFramebufferAttachmentParameteriv(GL_FRAMEBUFFER, attachment,
+                                          GL_FRAMEBUFFER_ATTACHMENT_OBJECT_NAME, &name);
+    capture.attachment = attachment;
+    capture.objectType = type;
+    capture.name = name;
+    if (type == GL_TEXTURE)
+    {
+        // 텍스처는 cube map face를 internalFormat 자리에 기록 (0이면 2D)
+        int face = 0;
+        glGetFramebufferAttachmentParameteriv(GL_FRAMEBUFFER, attachment,
+                                              GL_FRAMEBUFFER_ATTACHMENT_TEXTURE_CUBE_MAP_FACE, &face);
+        capture.internalFormat = face;
+        glGetFramebufferAttachmentParameteriv(GL_FRAMEBUFFER, attachment,
+                                              GL_FRAMEBUFFER_ATTACHMENT_TEXTURE_LEVEL, &capture.level);
+        glGetFramebufferAttachmentParameteriv(GL_FRAMEBUFFER, attachment,
+                                              GL_FRAMEBUFFER_ATTACHMENT_LAYERED, &capture.layered);
+        return true;
+    }
+
+    int previous = 0, internalFormat = 0;
+    glGetIntegerv(GL_RENDERBUFFER_BINDING, &previous);
+    glBindRenderbuffer(GL_RENDERBUFFER, name);
+    glGetRenderbufferParameteriv(GL_RENDERBUFFER, GL_RENDERBUFFER_WIDTH, &capture.width);
+    glGetRenderbufferParameteriv(GL_RENDERBUFFER, GL_RENDERBUFFER_HEIGHT, &capture.height);
+    glGetRenderbufferParameteriv(GL_RENDERBUFFER, GL_RENDERBUFFER_INTERNAL_FORMAT, &internalFormat);
+    capture.internalFormat = internalFormat;
+    glBindRenderbuffer(GL_RENDERBUFFER, previous);
+    return true;
+}
+
+static void SnapshotFramebuffer(CaptureRecorder &recorder, uint32_t framebuffer)
+{
+    if (!framebuffer || recorder.framebuffers.count(framebuffer))
+        return;
+    recorder.framebuffers.insert(framebuffer);
+
+    int previousDraw = 0, previousRead = 0;
+    glGetIntegerv(GL_DRAW_FRAMEBUFFER_BINDING, &previousDraw);
+    glGetIntegerv(GL_READ_FRAMEBUFFER_BINDING, &previousRead);
+    glBindFramebuffer(GL_FRAMEBUFFER, framebuffer);
+
+    CaptureFramebuffer capture;
+    capture.id = framebuffer;
+    int maxColorAttachments = 0;
+    glGetIntegerv(GL_MAX_COLOR_ATTACHMENTS, &maxColorAttachments);
+    for (int i = 0; i < std::min(maxColorAttachments, 8); i++)
+    {
+        CaptureAttachment attachment;
+        if (ReadAttachment(GL_COLOR_ATTACHMENT0 + i, attachment))
+            capture.attachments.push_back(attachment);
+    }
+
+    CaptureAttachment depth, stencil;
+    bool hasDepth = ReadAttachment(GL_DEPTH_ATTACHMENT, depth);
+    bool hasStencil = ReadAttachment(GL_STENCIL_ATTACHMENT, stencil);
+    if (hasDepth && hasStencil && depth.name == stencil.name && depth.objectType == stencil.objectType)
+    {
+        depth.attachment = GL_DEPTH_STENCIL_ATTACHMENT;
+        capture.attachments.push_back(depth);
+    }
+    else
+    {
+        if (hasDepth)
+            capture.attachments.push_back(depth);
+        if (hasStencil)
+            capture.attachments.push_back(stencil);
+    }
+
+    int maxDrawBuffers = 0;
+    glGetIntegerv(GL_MAX_DRAW_BUFFERS, &maxDrawBuffers);
+    for (int i = 0; i < std::min(maxDrawBuffers, 8); i++)
+    {
+        int drawBuffer = GL_NONE;
+        glGetIntegerv(GL_DRAW_BUFFER0 + i, &drawBuffer);
+        capture.drawBuffers.push_back(drawBuffer);
+    }
+    while (!capture.drawBuffers.empty() && capture.drawBuffers.back() == GL_NONE && capture.drawBuffers.size() > 1)
+        capture.drawBuffers.pop_back();
+    int readBuffer = GL_NONE;
+    glGetIntegerv(GL_READ_BUFFER, &readBuffer);
+    capture.readBuffer = readBuffer;
+
+    glBindFramebuffer(GL_DRAW_FRAMEBUFFER, previousDraw);
+    glBindFramebuffer(GL_READ_FRAMEBUFFER, previousRead);
+
+    for (auto &attachment : capture.attachments)
+    {
+        if (attachment.objectType != GL_TEXTURE)
+            continue;
+        // layered로 붙은 텍스처는 이 프로젝트에서 2D array뿐임 (CascadedShadowMap)
+        uint32_t target = attachment.layered          ? GL_TEXTURE_2D_ARRAY
+                          : attachment.internalFormat ? GL_TEXTURE_CUBE_MAP
+                                                      : GL_TEXTURE_2D;
+        SnapshotTexture(recorder, target, attachment.name);
+    }
+    recorder.data.framebuffers.push_back(std::move(capture));
+}
+
+static CaptureState ReadState()
+{
+    CaptureState state;
+    memset(&state, 0, sizeof(state)); // memcmp로 비교하므로 padding까지 초기화
+
+    glGetIntegerv(GL_VIEWPORT, state.viewport);
+    state.enableDepthTest = glIsEnabled(GL_DEPTH_TEST);
+    state.enableBlend = glIsEnabled(GL_BLEND);
+    state.enableCullFace = glIsEnabled(GL_CULL_FACE);
+    state.enableStencilTest = glIsEnabled(GL_STENCIL_TEST);
+
+    GLboolean depthMask = GL_TRUE;
+    GLboolean colorMask[4];
+    glGetBooleanv(GL_DEPTH_WRITEMASK, &depthMask);
+    glGetBooleanv(GL_COLOR_WRITEMASK, colorMask);
+    state.depthMask = depthMask;
+    for (int i = 0; i < 4; i++)
+        state.colorMask[i] = colorMask[i];
+
+    glGetIntegerv(GL_DEPTH_FUNC, (int *)&state.depthFunc);
+    glGetIntegerv(GL_BLEND_SRC_RGB, (int *)&state.blendSrcRGB);
+    glGetIntegerv(GL_BLEND_DST_RGB, (int *)&state.blendDstRGB);
+    glGetIntegerv(GL_BLEND_SRC_ALPHA, (int *)&state.blendSrcAlpha);
+    glGetIntegerv(GL_BLEND_DST_ALPHA, (int *)&state.blendDstAlpha);
+    glGetIntegerv(GL_CULL_FACE_MODE, (int *)&state.cullFaceMode);
+    glGetIntegerv(GL_STENCIL_FUNC, (int *)&state.stencilFunc);
+    glGetIntegerv(GL_STENCIL_VALUE_MASK, (int *)&state.stencilValueMask);
+    glGetIntegerv(GL_STENCIL_WRITEMASK, (int *)&state.stencilWriteMask);
+    glGetIntegerv(GL_STENCIL_REF, &state.stencilRef);
+    glGetIntegerv(GL_STENCIL_FAIL, (int *)&state.stencilFail);
+    glGetIntegerv(GL_STENCIL_PASS_DEPTH_FAIL, (int *)&state.stencilDepthFail);
+    glGetIntegerv(GL_STENCIL_PASS_DEPTH_PASS, (int *)&state.stencilDepthPass);
+    glGetFloatv(GL_COLOR_CLEAR_VALUE, state.clearColor);
+    glGetFloatv(GL_DEPTH_CLEAR_VALUE, &state.clearDepth);
+    glGetIntegerv(GL_STENCIL_CLEAR_VALUE, &state.clearStencil);
+    return state;
+}
+
+static void AddCommand(CaptureRecorder &recorder, CaptureOp op, std::initializer_list<uint32_t> args,
+                       const std::string &name = "", const void *data = nullptr, size_t size = 0)
+{
+    CaptureCommand command;
+    command.op = op;
+    std::copy(args.begin(), args.end(), command.args.begin());
+    command.name = name;
+    if (data && size > 0)
+        command.data.assign((const uint8_t *)data, (const uint8_t *)data + size);
+    recorder.data.commands.push_back(std::move(command));
+}
+
+// draw/clear 직전 : 바뀐 상태를 기록하고 사용하는 framebuffer를 저장
+static void RecordUse(CaptureRecorder &recorder)
+{
+    SnapshotFramebuffer(recorder, recorder.framebuffer);
+
+    auto state = ReadState();
+    if (recorder.hasState && memcmp(&state, &recorder.state, sizeof(state)) == 0)
+        return;
+    recorder.hasState = true;
+    recorder.state = state;
+    AddCommand(recorder, CaptureOp::SetState, {}, "", &state, sizeof(state));
+}
+
+void FrameCapture::Request(const std::string &filename)
+{
+    s_captureRequest = filename;
+}
+
+bool FrameCapture::IsRequested()
+{
+    return !s_captureRequest.empty();
+}
+
+bool FrameCapture::IsRecording()
+{
+    return s_recorder != nullptr;
+}
+
+void FrameCapture::BeginFrame()
+{
+    if (s_captureRequest.empty())
+        return;
+
+    s_recorder = std::make_unique<CaptureRecorder>();
+    s_recorder->filename = s_captureRequest;
+    s_captureRequest.clear();
+
+    // 프레임 시작 시점에 바인딩된 framebuffer
+    int framebuffer = 0;
+    glGetIntegerv(GL_DRAW_FRAMEBUFFER_BINDING, &framebuffer);
+    RecordBindFramebuffer((uint32_t)framebuffer == Framebuffer::GetDefault() ? 0 : framebuffer);
+}
+
+void FrameCapture::EndFrame()
+{
+    if (!s_recorder)
+        return;
+
+    auto recorder = std::move(s_recorder);
+    auto &data = recorder->data;
+    if (!data.Save(recorder->filename))
+        return;
+
+    SPDLOG_INFO("frame captured: {} ({} commands, {} programs, {} buffers, {} textures, {} framebuffers)",
+                recorder->filename, data.commands.size(), data.programs.size(), data.buffers.size(),
+                data.textures.size(), data.framebuffers.size());
+    CaptureStats::Compute(data).Print();
+}
+
+void FrameCapture::RegisterBufferTexture(uint32_t texture, uint32_t internalFormat, uint32_t buffer,
+                                         uint64_t offset, uint64_t size)
+{
+    s_bufferTextures[texture] = {internalFormat, buffer, offset, size};
+}
+
+void FrameCapture::UnregisterBufferTexture(uint32_t texture)
+{
+    s_bufferTextures.erase(texture);
+}
+
+void FrameCapture::RecordUseProgram(uint32_t program)
+{
+    if (!s_recorder)
+        return;
+    SnapshotProgram(*s_recorder, program);
+    AddCommand(*s_recorder, CaptureOp::UseProgram, {program});
+}
+
+void FrameCapture::RecordUniform(uint32_t program, const std::string &name, uint32_t type,
+                                 const void *data, size_t size)
+{
+    if (!s_recorder)
+        return;
+    SnapshotProgram(*s_recorder, program);
+    AddCommand(*s_recorder, CaptureOp::Uniform, {program, type}, name, data, size);
+}
+
+void FrameCapture::RecordBindTexture(uint32_t target, uint32_t texture)
+{
+    if (!s_recorder)
+        return;
+    int unit = GL_TEXTURE0;
+    glGetIntegerv(GL_ACTIVE_TEXTURE, &unit);
+    SnapshotTexture(*s_recorder, target, texture);
+    AddCommand(*s_recorder, CaptureOp::BindTexture, {(uint32_t)(unit - GL_TEXTURE0), target, texture});
+}
+
+void FrameCapture::RecordBindVertexArray(uint32_t vertexArray)
+{
+    if (!s_recorder)
+        return;
+    AddCommand(*s_recorder, CaptureOp::BindVertexArray, {vertexArray});
+}
+
+void FrameCapture::RecordBindFramebuffer(uint32_t framebuffer)
+{
+    if (!s_recorder)
+        return;
+    s_recorder->framebuffer = framebuffer;
+    AddCommand(*s_recorder, CaptureOp::BindFramebuffer, {framebuffer});
+}
+
+void FrameCapture::RecordUpdateBuffer(uint32_t buffer, size_t offset, const void *data, size_t size)
+{
+    if (!s_recorder)
+        return;
+    AddCommand(*s_recorder, CaptureOp::UpdateBuffer, {buffer, (uint32_t)offset}, "", data, size);
+}
+
+void FrameCapture::RecordClear(uint32_t mask)
+{
+    if (!s_recorder)
+        return;
+    RecordUse(*s_recorder);
+    AddCommand(*s_recorder, CaptureOp::Clear, {mask});
+}
+
+void FrameCapture::RecordDraw(uint32_t mode, uint32_t count, uint32_t type, size_t offset,
+                              uint32_t instanceCount)
+{
+    if (!s_recorder)
+        return;
+    RecordUse(*s_recorder);
+    SnapshotVertexArray(*s_recorder);
+    AddCommand(*s_recorder, CaptureOp::Draw, {mode, count, type, (uint32_t)offset, instanceCount});
+}
+
+void FrameCapture::RecordBlit(uint32_t readFramebuffer, uint32_t drawFramebuffer,
+                              int srcX0, int srcY0, int srcX1, int srcY1,
+                              int dstX0, int dstY0, int dstX1, int dstY1,
+                              uint32_t mask, uint32_t filter)
+{
+    if (!s_recorder)
+        return;
+    SnapshotFramebuffer(*s_recorder, readFramebuffer);
+    SnapshotFramebuffer(*s_recorder, drawFramebuffer);
+    AddCommand(*s_recorder, CaptureOp::Blit,
+               {readFramebuffer, drawFramebuffer,
+                (uint32_t)srcX0, (uint32_t)srcY0, (uint32_t)srcX1, (uint32_t)srcY1,
+                (uint32_t)dstX0, (uint32_t)dstY0, (uint32_t)dstX1, (uint32_t)dstY1,
+                mask, filter});
+}
+
+// ---------------------------------------------------------------------------
+// 재생
+
+FrameReplayUPtr FrameReplay::Load(const std::string &filename)
+{
+    auto replay = FrameReplayUPtr(new FrameReplay());
+    if (!replay->m_data.Load(filename))
+        return nullptr;
+    if (!replay->Init())
+        return nullptr;
+    return std::move(replay);
+}
+
+FrameReplay::~FrameReplay()
+{
+    for (auto &item : m_framebuffers)
+        glDeleteFramebuffers(1, &item.second);
+    if (!m_renderbuffers.empty())
+        glDeleteRenderbuffers((int)m_renderbuffers.size(), m_renderbuffers.data());
+    for (auto &item : m_vertexArrays)
+        glDeleteVertexArrays(1, &item.second);
+    for (auto &item : m_textures)
+        glDeleteTextures(1, &item.second);
+    for (auto &item : m_buffers)
+        glDeleteBuffers(1, &item.second);
+    for (auto &item : m_programs)
+        glDeleteProgram(item.second);
+}
+
+uint32_t FrameReplay::Find(const std::unordered_map<uint32_t, uint32_t> &table, uint32_t id) const
+{
+    auto found = table.find(id);
+    return found != table.end() ? found->second : 0;
+}
+
+bool FrameReplay::Init()
+{
+    for (auto &capture : m_data.buffers)
+    {
+        uint32_t buffer = 0;
+        glGenBuffers(1, &buffer);
+        glBindBuffer(GL_COPY_WRITE_BUFFER, buffer);
+        glBufferData(GL_COPY_WRITE_BUFFER, capture.data.size(), capture.data.data(), GL_DYNAMIC_DRAW);
+        m_buffers[capture.id] = buffer;
+    }
+
+    glPixelStorei(GL_UNPACK_ALIGNMENT, 1);
+    for (auto &capture : m_data.textures)
+    {
+        uint32_t texture = 0;
+        glGenTextures(1, &texture);
+        glBindTexture(capture.target, texture);
+        m_textures[capture.id] = texture;
+        if (capture.target == GL_TEXTURE_BUFFER)
+        {
+            if (capture.bufferSize > 0 && (GLAD_GL_VERSION_4_3 || GLAD_GL_ARB_texture_buffer_range))
+                glTexBufferRange(GL_TEXTURE_BUFFER, capture.internalFormat, Find(m_buffers, capture.buffer),
+                                 capture.bufferOffset, capture.bufferSize);
+            else
+                glTexBuffer(GL_TEXTURE_BUFFER, capture.internalFormat, Find(m_buffers, capture.buffer));
+            continue;
+        }
+        if (capture.target == GL_TEXTURE_2D_ARRAY)
+        {
+            glTexImage3D(GL_TEXTURE_2D_ARRAY, 0, capture.internalFormat, capture.width, capture.height,
+                         capture.layers, 0, capture.dataFormat, capture.dataType,
+                         capture.faces.empty() ? nullptr : capture.faces[0].data());
+        }
+        for (size_t i = 0; capture.target != GL_TEXTURE_2D_ARRAY && i < capture.faces.size(); i++)
+        {
+            uint32_t target = capture.target == GL_TEXTURE_CUBE_MAP ? GL_TEXTURE_CUBE_MAP_POSITIVE_X + (uint32_t)i
+                                                                   : GL_TEXTURE_2D;
+            glTexImage2D(target, 0, capture.internalFormat, capture.width, capture.height, 0,
+                         capture.dataFormat, capture.dataType, capture.faces[i].data());
+        }
+        glTexParameteri(capture.target, GL_TEXTURE_MIN_FILTER, capture.minFilter);
+        glTexParameteri(capture.target, GL_TEXTURE_MAG_FILTER, capture.magFilter);
+        glTexParameteri(capture.target, GL_TEXTURE_WRAP_S, capture.wrapS);
+        glTexParameteri(capture.target, GL_TEXTURE_WRAP_T, capture.wrapT);
+        glTexParameteri(capture.target, GL_TEXTURE_WRAP_R, capture.wrapR);
+        glTexParameterfv(capture.target, GL_TEXTURE_BORDER_COLOR, capture.borderColor);
+        if (capture.minFilter != GL_NEAREST && capture.minFilter != GL_LINEAR)
+            glGenerateMipmap(capture.target);
+    }
+    glPixelStorei(GL_UNPACK_ALIGNMENT, 4);
+
+    for (auto &capture : m_data.programs)
+    {
+        uint32_t program = glCreateProgram();
+        m_programs[capture.id] = program;
+        for (auto &captureShader : capture.shaders)
+        {
+            uint32_t shader = glCreateShader(captureShader.type);
+            const char *source = captureShader.source.c_str();
+            glShaderSource(shader, 1, &source, nullptr);
+            glCompileShader(shader);
+            glAttachShader(program, shader);
+            glDeleteShader(shader); // program이 삭제될 때 같이 삭제됨
+        }
+        if (!capture.binary.empty())
+            glProgramBinary(program, capture.binaryFormat, capture.binary.data(), (int)capture.binary.size());
+        else
+            glLinkProgram(program);
+        int success = 0;
+        glGetProgramiv(program, GL_LINK_STATUS, &success);
+        if (!success)
+        {
+            char infoLog[1024];
+            glGetProgramInfoLog(program, 1024, nullptr, infoLog);
+            SPDLOG_ERROR("failed to link captured program {}: {}", capture.id, infoLog);
+            return false;
+        }
+
+        glUseProgram(program);
+        for (auto &uniform : capture.uniforms)
+            ApplyUniform(GetUniformLocation(capture.id, uniform.name), uniform.type, uniform.data);
+    }
+    glUseProgram(0);
+
+    for (auto &capture : m_data.vertexArrays)
+    {
+        uint32_t vertexArray = 0;
+        glGenVertexArrays(1, &vertexArray);
+        glBindVertexArray(vertexArray);
+        glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, Find(m_buffers, capture.elementBuffer));
+        for (auto &attrib : capture.attribs)
+        {
+            glBindBuffer(GL_ARRAY_BUFFER, Find(m_buffers, attrib.buffer));
+            glEnableVertexAttribArray(attrib.index);
+            if (attrib.integer)
+                glVertexAttribIPointer(attrib.index, attrib.size, attrib.type, attrib.stride,
+                                       (const void *)attrib.offset);
+            else
+                glVertexAttribPointer(attrib.index, attrib.size, attrib.type, attrib.normalized,
+                                      attrib.stride, (const void *)attrib.offset);
+            glVertexAttribDivisor(attrib.index, attrib.divisor);
+        }
+        m_vertexArrays[capture.id] = vertexArray;
+    }
+    glBindVertexArray(0);
+
+    for (auto &capture : m_data.framebuffers)
+    {
+        uint32_t framebuffer = 0;
+        glGenFramebuffers(1, &framebuffer);
+        glBindFramebuffer(GL_FRAMEBUFFER, framebuffer);
+        for (auto &attachment : capture.attachments)
+        {
+            if (attachment.objectType == GL_TEXTURE && attachment.layered)
+            {
+                glFramebufferTexture(GL_FRAMEBUFFER, attachment.attachment,
+                                     Find(m_textures, attachment.name), attachment.level);
+                continue;
+            }
+            if (attachment.objectType == GL_TEXTURE)
+            {
+                uint32_t target = attachment.internalFormat ? attachment.internalFormat : GL_TEXTURE_2D;
+                glFramebufferTexture2D(GL_FRAMEBUFFER, attachment.attachment, target,
+                                       Find(m_textures, attachment.name), attachment.level);
+                continue;
+            }
+            uint32_t renderbuffer = 0;
+            glGenRenderbuffers(1, &renderbuffer);
+            glBindRenderbuffer(GL_RENDERBUFFER, renderbuffer);
+            glRenderbufferStorage(GL_RENDERBUFFER, attachment.internalFormat, attachment.width, attachment.height);
+            glFramebufferRenderbuffer(GL_FRAMEBUFFER, attachment.attachment, GL_RENDERBUFFER, renderbuffer);
+            m_renderbuffers.push_back(renderbuffer);
+        }
+        glDrawBuffers((int)capture.drawBuffers.size(), capture.drawBuffers.data());
+        glReadBuffer(capture.readBuffer);
+
+        auto status = glCheckFramebufferStatus(GL_FRAMEBUFFER);
+        if (status != GL_FRAMEBUFFER_COMPLETE)
+        {
+            SPDLOG_ERROR("failed to create captured framebuffer {}: {:x}", capture.id, status);
+            return false;
+        }
+        m_framebuffers[capture.id] = framebuffer;
+    }
+    glBindRenderbuffer(GL_RENDERBUFFER, 0);
+    Framebuffer::BindToDefault();
+
+    SPDLOG_INFO("capture loaded: {} commands, {} programs, {} buffers, {} textures, {} framebuffers",
+                m_data.commands.size(), m_data.programs.size(), m_data.buffers.size(),
+                m_data.textures.size(), m_data.framebuffers.size());
+    return true;
+}
+
+int FrameReplay::GetUniformLocation(uint32_t program, const std::string &name)
+{
+    auto key = fmt::format("{}:{}", program, name);
+    auto found = m_uniformLocations.find(key);
+    if (found != m_uniformLocations.end())
+        return found->second;
+    int location = glGetUniformLocation(Find(m_programs, program), name.c_str());
+    m_uniformLocations[key] = location;
+    return location;
+}
+
+void FrameReplay::ApplyUniform(int location, uint32_t type, const std::vector<uint8_t> &data) const
+{
+    if (location < 0 || data.size() < GetUniformSize(type))
+        return;
+
+    auto floats = (const float *)data.data();
+    auto ints = (const int *)data.data();
+    switch (type)
+    {
+    case GL_FLOAT:
+        glUniform1fv(location, 1, floats);
+        break;
+    case GL_FLOAT_VEC2:
+        glUniform2fv(location, 1, floats);
+        break;
+    case GL_FLOAT_VEC3:
+        glUniform3fv(location, 1, floats);
+        break;
+    case GL_FLOAT_VEC4:
+        glUniform4fv(location, 1, floats);
+        break;
+    case GL_FLOAT_MAT3:
+        glUniformMatrix3fv(location, 1, GL_FALSE, floats);
+        break;
+    case GL_FLOAT_MAT4:
+        glUniformMatrix4fv(location, 1, GL_FALSE, floats);
+        break;
+    case GL_UNSIGNED_INT:
+        glUniform1uiv(location, 1, (const uint32_t *)data.data());
+        break;
+    case GL_INT_VEC2:
+        glUniform2iv(location, 1, ints);
+        break;
+    case GL_INT_VEC3:
+        glUniform3iv(location, 1, ints);
+        break;
+    case GL_INT_VEC4:
+        glUniform4iv(location, 1, ints);
+        break;
+    default: // int, bool, sampler
+        glUniform1iv(location, 1, ints);
+        break;
+    }
+}
+
+void FrameReplay::ApplyState(const CaptureState &state) const
+{
+    auto enable = [](uint32_t cap, uint32_t enabled)
+    {
+        if (enabled)
+            glEnable(cap);
+        else
+            glDisable(cap);
+    };
+
+    glViewport(state.viewport[0], state.viewport[1], state.viewport[2], state.viewport[3]);
+    enable(GL_DEPTH_TEST, state.enableDepthTest);
+    enable(GL_BLEND, state.enableBlend);
+    enable(GL_CULL_FACE, state.enableCullFace);
+    enable(GL_STENCIL_TEST, state.enableStencilTest);
+    glDepthFunc(state.depthFunc);
+    glDepthMask(state.depthMask ? GL_TRUE : GL_FALSE);
+    glBlendFuncSeparate(state.blendSrcRGB, state.blendDstRGB, state.blendSrcAlpha, state.blendDstAlpha);
+    glCullFace(state.cullFaceMode);
+    glStencilFunc(state.stencilFunc, state.stencilRef, state.stencilValueMask);
+    glStencilMask(state.stencilWriteMask);
+    glStencilOp(state.stencilFail, state.stencilDepthFail, state.stencilDepthPass);
+    glColorMask(state.colorMask[0], state.colorMask[1], state.colorMask[2], state.colorMask[3]);
+    glClearColor(state.clearColor[0], state.clearColor[1], state.clearColor[2], state.clearColor[3]);
+    glClearDepth(state.clearDepth);
+    glClearStencil(state.clearStencil);
+}
+
+void FrameReplay::Replay()
+{
+    auto bindFramebuffer = [&](uint32_t target, uint32_t id)
+    {
+        glBindFramebuffer(target, id ? Find(m_framebuffers, id) : Framebuffer::GetDefault());
+    };
+
+    uint32_t program = 0;
+    for (auto &command : m_data.commands)
+    {
+        auto &args = command.args;
+        switch (command.op)
+        {
+        case CaptureOp::UseProgram:
+            program = args[0];
+            glUseProgram(Find(m_programs, program));
+            break;
+        case CaptureOp::Uniform:
+            if (args[0] == program)
+                ApplyUniform(GetUniformLocation(args[0], command.name), args[1], command.data);
+            break;
+        case CaptureOp::BindTexture:
+            glActiveTexture(GL_TEXTURE0 + args[0]);
+            glBindTexture(args[1], Find(m_textures, args[2]));
+            break;
+        case CaptureOp::BindVertexArray:
+            glBindVertexArray(Find(m_vertexArrays, args[0]));
+            break;
+        case CaptureOp::BindFramebuffer:
+            bindFramebuffer(GL_FRAMEBUFFER, args[0]);
+            break;
+        case CaptureOp::UpdateBuffer:
+        {
+            uint32_t buffer = Find(m_buffers, args[0]);
+            if (!buffer)
+                break;
+            glBindBuffer(GL_COPY_WRITE_BUFFER, buffer);
+            glBufferSubData(GL_COPY_WRITE_BUFFER, args[1], command.data.size(), command.data.data());
+            break;
+        }
+        case CaptureOp::SetState:
+            if (command.data.size() == sizeof(CaptureState))
+                ApplyState(*(const CaptureState *)command.data.data());
+            break;
+        case CaptureOp::Clear:
+            glClear(args[0]);
+            break;
+        case CaptureOp::Draw:
+            if (args[4] > 0)
+                glDrawElementsInstanced(args[0], args[1], args[2], (const void *)(uintptr_t)args[3], args[4]);
+            else
+                glDrawElements(args[0], args[1], args[2], (const void *)(uintptr_t)args[3]);
+            break;
+        case CaptureOp::Blit:
+            bindFramebuffer(GL_READ_FRAMEBUFFER, args[0]);
+            bindFramebuffer(GL_DRAW_FRAMEBUFFER, args[1]);
+            glBlitFramebuffer(args[2], args[3], args[4], args[5], args[6], args[7], args[8], args[9],
+                              args[10], args[11]);
+            break;
+        default:
+            break;
+        }
+    }
+
+    glBindVertexArray(0);
+    glUseProgram(0);
+    Framebuffer::BindToDefault();
+}
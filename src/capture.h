@@ -0,0 +1,232 @@
+#pragma once
+
+#include "common.h"
+#include <array>
+#include <unordered_map>
+#include <vector>
+
+// 한 프레임 동안 Program, Material, Buffer, Texture, Framebuffer, Mesh가 호출한 GL 명령과
+// 그 명령이 참조한 리소스(버퍼/텍스처 내용, 쉐이더 소스, VAO/FBO 구성)를 파일로 저장하고
+// 다시 읽어서 같은 명령을 반복 재생할 수 있게 함
+
+enum class CaptureOp : uint32_t
+{
+    UseProgram,      // program
+    Uniform,         // program, type, count / name, data
+    BindTexture,     // unit, target, texture
+    BindVertexArray, // vertexArray
+    BindFramebuffer, // framebuffer (0 : 기본 framebuffer)
+    UpdateBuffer,    // buffer, offset / data
+    SetState,        // data(CaptureState)
+    Clear,           // mask
+    Draw,            // mode, count, type, offset, instanceCount
+    Blit,            // read, draw, src x0 y0 x1 y1, dst x0 y0 x1 y1, mask, filter
+    Count,
+};
+
+const char *GetCaptureOpName(CaptureOp op);
+
+struct CaptureCommand
+{
+    CaptureOp op{CaptureOp::Count};
+    std::array<uint32_t, 12> args{};
+    std::string name;
+    std::vector<uint8_t> data;
+};
+
+// draw/clear 시점의 고정 기능 상태. Context가 GL을 직접 호출해서 바꾸는 상태도 있으므로 GL에서 읽어옴
+struct CaptureState
+{
+    int viewport[4];
+    uint32_t enableDepthTest;
+    uint32_t enableBlend;
+    uint32_t enableCullFace;
+    uint32_t enableStencilTest;
+    uint32_t depthFunc;
+    uint32_t depthMask;
+    uint32_t blendSrcRGB, blendDstRGB, blendSrcAlpha, blendDstAlpha;
+    uint32_t cullFaceMode;
+    uint32_t stencilFunc, stencilValueMask, stencilWriteMask;
+    int stencilRef;
+    uint32_t stencilFail, stencilDepthFail, stencilDepthPass;
+    uint32_t colorMask[4];
+    float clearColor[4];
+    float clearDepth;
+    int clearStencil;
+};
+
+struct CaptureUniform
+{
+    std::string name;
+    uint32_t type{0}; // GL_FLOAT, GL_FLOAT_VEC3, GL_INT, ...
+    std::vector<uint8_t> data;
+};
+
+struct CaptureShader
+{
+    uint32_t type{0};
+    std::string source;
+};
+
+struct CaptureProgram
+{
+    uint32_t id{0};
+    std::vector<CaptureShader> shaders;
+    std::vector<CaptureUniform> uniforms; // 처음 사용할 때의 uniform 값
+    // binary cache에서 불러온 program은 쉐이더 소스가 없으므로 binary를 저장
+    // 같은 드라이버에서만 재생 가능
+    uint32_t binaryFormat{0};
+    std::vector<uint8_t> binary;
+};
+
+struct CaptureBuffer
+{
+    uint32_t id{0};
+    std::vector<uint8_t> data;
+};
+
+struct CaptureTexture
+{
+    uint32_t id{0};
+    uint32_t target{0}; // GL_TEXTURE_2D, GL_TEXTURE_2D_ARRAY, GL_TEXTURE_CUBE_MAP, GL_TEXTURE_BUFFER
+    uint32_t internalFormat{0};
+    uint32_t buffer{0}; // GL_TEXTURE_BUFFER의 데이터 버퍼
+    uint64_t bufferOffset{0}; // GL_TEXTURE_BUFFER가 연결된 범위(byte). size가 0이면 버퍼 전체
+    uint64_t bufferSize{0};
+    int width{0};
+    int height{0};
+    int layers{1}; // GL_TEXTURE_2D_ARRAY의 layer 수
+    uint32_t dataFormat{0};
+    uint32_t dataType{0};
+    int minFilter{0}, magFilter{0}, wrapS{0}, wrapT{0}, wrapR{0};
+    float borderColor[4]{};
+    std::vector<std::vector<uint8_t>> faces; // level 0 내용. 2D/array는 1개, cube map은 6개
+};
+
+struct CaptureAttrib
+{
+    uint32_t index{0};
+    uint32_t buffer{0};
+    int size{0};
+    uint32_t type{0};
+    uint32_t normalized{0};
+    uint32_t integer{0};
+    int stride{0};
+    uint64_t offset{0};
+    uint32_t divisor{0};
+};
+
+struct CaptureVertexArray
+{
+    uint32_t id{0};
+    uint32_t elementBuffer{0};
+    std::vector<CaptureAttrib> attribs;
+};
+
+struct CaptureAttachment
+{
+    uint32_t attachment{0};
+    uint32_t objectType{0}; // GL_TEXTURE, GL_RENDERBUFFER
+    uint32_t name{0};
+    uint32_t internalFormat{0}; // renderbuffer
+    int width{0};
+    int height{0};
+    int level{0}; // texture mip level
+    int layered{0}; // 1이면 array 전체를 붙임 (glFramebufferTexture)
+};
+
+struct CaptureFramebuffer
+{
+    uint32_t id{0};
+    std::vector<CaptureAttachment> attachments;
+    std::vector<uint32_t> drawBuffers;
+    uint32_t readBuffer{0};
+};
+
+struct CaptureData
+{
+    std::vector<CaptureProgram> programs;
+    std::vector<CaptureBuffer> buffers;
+    std::vector<CaptureTexture> textures;
+    std::vector<CaptureVertexArray> vertexArrays;
+    std::vector<CaptureFramebuffer> framebuffers;
+    std::vector<CaptureCommand> commands;
+
+    bool Save(const std::string &filename) const;
+    bool Load(const std::string &filename);
+};
+
+// 명령 종류별 호출 횟수와 그려진 index 수
+struct CaptureStats
+{
+    std::array<int, (size_t)CaptureOp::Count> opCounts{};
+    uint64_t indexCount{0};
+
+    static CaptureStats Compute(const CaptureData &data);
+    void Print() const;
+    // 두 캡처의 호출 횟수 차이를 출력
+    static void PrintDiff(const CaptureStats &a, const CaptureStats &b);
+};
+
+// 기록 : 래퍼 클래스들이 GL 호출과 함께 Record 함수를 부름. 기록 중이 아니면 바로 반환
+class FrameCapture
+{
+public:
+    // 다음 BeginFrame부터 EndFrame까지를 기록해서 filename에 저장
+    static void Request(const std::string &filename);
+    static bool IsRequested();
+    static bool IsRecording();
+    static void BeginFrame();
+    static void EndFrame();
+
+    // texture buffer는 GL 3.3에서 연결된 버퍼와 형식을 조회할 수 없으므로 생성할 때 알려줌
+    // size가 0이면 버퍼 전체, 아니면 glTexBufferRange로 연결한 범위(byte)
+    static void RegisterBufferTexture(uint32_t texture, uint32_t internalFormat, uint32_t buffer,
+                                      uint64_t offset = 0, uint64_t size = 0);
+    static void UnregisterBufferTexture(uint32_t texture);
+
+    static void RecordUseProgram(uint32_t program);
+    static void RecordUniform(uint32_t program, const std::string &name, uint32_t type,
+                              const void *data, size_t size);
+    static void RecordBindTexture(uint32_t target, uint32_t texture);
+    static void RecordBindVertexArray(uint32_t vertexArray);
+    static void RecordBindFramebuffer(uint32_t framebuffer);
+    static void RecordUpdateBuffer(uint32_t buffer, size_t offset, const void *data, size_t size);
+    static void RecordClear(uint32_t mask);
+    static void RecordDraw(uint32_t mode, uint32_t count, uint32_t type, size_t offset,
+                           uint32_t instanceCount = 0);
+    static void RecordBlit(uint32_t readFramebuffer, uint32_t drawFramebuffer,
+                           int srcX0, int srcY0, int srcX1, int srcY1,
+                           int dstX0, int dstY0, int dstX1, int dstY1,
+                           uint32_t mask, uint32_t filter);
+};
+
+// 재생 : 캡처 파일의 리소스를 새로 만들고 명령을 그대로 다시 호출
+// 기본 framebuffer(0)에 대한 명령은 Framebuffer::GetDefault()로 바인딩됨
+CLASS_PTR(FrameReplay)
+class FrameReplay
+{
+public:
+    static FrameReplayUPtr Load(const std::string &filename);
+    ~FrameReplay();
+
+    void Replay();
+    const CaptureData &GetData() const { return m_data; }
+
+private:
+    FrameReplay() {}
+    bool Init();
+    int GetUniformLocation(uint32_t program, const std::string &name);
+    void ApplyUniform(int location, uint32_t type, const std::vector<uint8_t> &data) const;
+    void ApplyState(const CaptureState &state) const;
+    uint32_t Find(const std::unordered_map<uint32_t, uint32_t> &table, uint32_t id) const;
+
+    CaptureData m_data;
+    std::unordered_map<uint32_t, uint32_t> m_programs;
+    std::unordered_map<uint32_t, uint32_t> m_buffers;
+    std::unordered_map<uint32_t, uint32_t> m_textures;
+    std::unordered_map<uint32_t, uint32_t> m_vertexArrays;
+    std::unordered_map<uint32_t, uint32_t> m_framebuffers;
+    std::vector<uint32_t> m_renderbuffers;
+    std::unordered_map<std::string, int> m_uniformLocations; // "program:name"
+};
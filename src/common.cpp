@@ -1,6 +1,9 @@
 #include "common.h"
+#include <cfloat>
+#include <cmath>
 #include <fstream>
 #include <sstream>
+#include <random>
 
 // optional - 어떤 값이 있는지 없는지를 포인터 없이 반환
 std::optional<std::string> LoadTextFile(const std::string &filename)
@@ -30,9 +33,27 @@ glm::vec3 GetAttenuationCoeff(float distance)
     return glm::vec3(kc, glm::max(kl, 0.0f), glm::max(kq * kq, 0.0f));
 }
 
+float GetAttenuationRadius(const glm::vec3 &attenuation, float threshold)
+{
+    // kc + kl * d + kq * d^2 = 1 / threshold 의 양의 근
+    float kc = attenuation.x, kl = attenuation.y, kq = attenuation.z;
+    float c = kc - 1.0f / threshold;
+    if (kq <= 0.0f)
+        return kl > 0.0f ? -c / kl : FLT_MAX;
+    return (-kl + sqrtf(kl * kl - 4.0f * kq * c)) / (2.0f * kq);
+}
+
+// 플랫폼마다 결과가 다른 rand() 대신 시드를 지정할 수 있는 mt19937 사용
+static std::mt19937 s_random(1);
+
+void SetRandomSeed(uint32_t seed)
+{
+    s_random.seed(seed);
+}
+
 float RandomRange(float minValue, float maxValue)
 {
-    return ((float)rand() / (float)RAND_MAX) *
-               (maxValue - minValue) +
-           minValue;
+    // 구현마다 다른 uniform_real_distribution 대신 직접 [0, 1]로 변환
+    float t = (float)s_random() / (float)std::mt19937::max();
+    return t * (maxValue - minValue) + minValue;
 }
\ No newline at end of file
@@ -18,6 +18,10 @@
 
 std::optional<std::string> LoadTextFile(const std::string &filename);
 glm::vec3 GetAttenuationCoeff(float distance);
+// 감쇠(kc, kl, kq)가 threshold 아래로 떨어지는 거리. 광원의 영향 반경으로 사용
+float GetAttenuationRadius(const glm::vec3 &attenuation, float threshold = 5.0f / 256.0f);
+// 같은 시드면 모든 플랫폼에서 같은 순서의 값이 나옴
+void SetRandomSeed(uint32_t seed);
 float RandomRange(float minValue = 0.0f, float maxValue = 1.0f);
 
 template <class... Ts>
@@ -2,6 +2,19 @@
 #include "image.h"
 #include <imgui.h>
 #include "texture.h"
+#include "capture.h"
+#include "renderstats.h"
+#include <glm/gtc/constants.hpp>
+#include <chrono>
+#include <cstring>
+
+// UpdateCamera의 원근 투영 범위. light cluster의 깊이 slice도 같은 범위를 사용
+static const float CAMERA_NEAR = 0.01f;
+static const float CAMERA_FAR = 100.0f;
+static const float CAMERA_FOVY = 45.0f;
+static const int SHADOW_MAP_SIZE = 1024; // cascade도 layer마다 같은 크기
+static const int SSAO_DEPTH_MIP_COUNT = 4; // gtao.fs에서 lod 3까지 읽음
+static const int SSAO_TEMPORAL_SAMPLE_COUNT = 16; // temporal 누적을 쓸 때 프레임당 kernel 샘플 수
 
 Context::Context()
 {
@@ -11,26 +24,38 @@ Context::~Context()
 {
 }
 
-ContextUPtr Context::Create()
+ContextUPtr Context::Create(const SceneOption &option)
 {
     auto context = ContextUPtr(new Context());
-    if (!context->Init())
+    if (!context->Init(option))
         return nullptr;
     return std::move(context);
 }
 
-bool Context::Init()
+bool Context::Init(const SceneOption &option)
 {
+    m_sceneOption = option;
+    SetRandomSeed(option.seed);
+
     glEnable(GL_MULTISAMPLE);
     glClearColor(0.1f, 0.2f, 0.3f, 0.0f);
     bool isSuccess = true;
     m_box = Mesh::CreateBox();
     m_plane = Mesh::CreatePlane();
+    m_jobSystem = JobSystem::Create();
+    m_profiler = Profiler::Create();
 
     try
     {
         InitParameters();
+        auto shaderStart = std::chrono::steady_clock::now();
         InitShader();
+        m_shaderInitTime = std::chrono::duration<float, std::milli>(
+                               std::chrono::steady_clock::now() - shaderStart)
+                               .count();
+        auto &cacheStats = Program::GetCacheStats();
+        SPDLOG_INFO("shader init: {:.1f} ms (binary cache hits {}, misses {})",
+                    m_shaderInitTime, cacheStats.hits, cacheStats.misses);
         InitMaterial();
         InitObject();
     }
@@ -58,13 +83,25 @@ void Context::InitShader()
 
     m_grassProgram = Program::Create("./shader/grass.vs", "./shader/grass.fs");
     m_lightingShadowProgram = Program::Create("./shader/lighting_shadow.vs", "./shader/lighting_shadow.fs");
+    m_shadowCascadeProgram = Program::Create("./shader/shadow_csm.vs", "./shader/shadow_csm.gs", "./shader/depth_only.fs");
     m_normalProgram = Program::Create("./shader/normal.vs", "./shader/normal.fs");
 
     m_deferGeoProgram = Program::Create("./shader/defer_geo.vs", "./shader/defer_geo.fs");
     m_deferLightProgram = Program::Create("./shader/defer_light.vs", "./shader/defer_light.fs");
+    m_lightVolumeProgram = Program::Create("./shader/light_volume.vs", "./shader/light_volume.fs");
+    m_depthOnlyProgram = Program::Create("./shader/depth_only.vs", "./shader/depth_only.fs");
+    m_overdrawProgram = Program::Create("./shader/depth_only.vs", "./shader/simple.fs");
+    m_overdrawViewProgram = Program::Create("./shader/blur_5x5.vs", "./shader/overdraw.fs");
 
     m_ssaoProgram = Program::Create("./shader/ssao.vs", "./shader/ssao.fs");
+    m_ssaoDepthProgram = Program::Create("./shader/ssao.vs", "./shader/ssao_depth.fs");
+    m_ssaoDepthMipProgram = Program::Create("./shader/ssao.vs", "./shader/ssao_depth_mip.fs");
+    m_gtaoProgram = Program::Create("./shader/ssao.vs", "./shader/gtao.fs");
+    m_ssaoTemporalProgram = Program::Create("./shader/ssao.vs", "./shader/ssao_temporal.fs");
+    m_ssaoUpsampleProgram = Program::Create("./shader/ssao.vs", "./shader/ssao_upsample.fs");
     m_blurProgram = Program::Create("./shader/blur_5x5.vs", "./shader/blur_5x5.fs");
+    m_separableBlurProgram = Program::Create("./shader/blur_5x5.vs", "./shader/blur_separable.fs");
+    m_bilateralBlurProgram = Program::Create("./shader/blur_5x5.vs", "./shader/blur_bilateral.fs");
 }
 
 void Context::InitMaterial()
@@ -74,29 +111,43 @@ void Context::InitMaterial()
 
     TexturePtr grayTexture = Texture::CreateFromImage(ImagePtr(Image::CreateSingleColorImage(4, 4, vec4(0.5f, 0.5f, 0.5f, 1.0f))));
 
-    TexturePtr groundTexture = Texture::CreateFromImage(ImagePtr(Image::Load("./image/marble.jpg")));
-    TexturePtr boxTexture = Texture::CreateFromImage(ImagePtr(Image::Load("./image/container.jpg")));
-    TexturePtr box2Texture = Texture::CreateFromImage(ImagePtr(Image::Load("./image/container2.png")));
-    TexturePtr box2SpecTexture = Texture::CreateFromImage(ImagePtr(Image::Load("./image/container2_specular.png")));
-    TexturePtr wallTexture = Texture::CreateFromImage(ImagePtr(Image::Load("./image/brickwall.jpg")));
-    TexturePtr wallNormalTexture = Texture::CreateFromImage(ImagePtr(Image::Load("./image/brickwall_normal.jpg")));
-    TexturePtr planeTexture = Texture::CreateFromImage(ImagePtr(Image::Load("./image/blending_transparent_window.png")));
-    TexturePtr grassTexture = Texture::CreateFromImage(ImagePtr(Image::Load("./image/grass.png")));
+    // 이미지 디코딩은 worker 스레드에서 병렬로 처리하고 텍스처 생성만 GL 스레드에서 함
+    auto images = LoadImages({
+        "./image/marble.jpg",
+        "./image/container.jpg",
+        "./image/container2.png",
+        "./image/container2_specular.png",
+        "./image/brickwall.jpg",
+        "./image/brickwall_normal.jpg",
+        "./image/blending_transparent_window.png",
+        "./image/grass.png",
+    });
+    TexturePtr groundTexture = Texture::CreateFromImage(images[0]);
+    TexturePtr boxTexture = Texture::CreateFromImage(images[1]);
+    TexturePtr box2Texture = Texture::CreateFromImage(images[2]);
+    TexturePtr box2SpecTexture = Texture::CreateFromImage(images[3]);
+    TexturePtr wallTexture = Texture::CreateFromImage(images[4]);
+    TexturePtr wallNormalTexture = Texture::CreateFromImage(images[5]);
+    TexturePtr planeTexture = Texture::CreateFromImage(images[6]);
+    TexturePtr grassTexture = Texture::CreateFromImage(images[7]);
 
     // skybox
-    auto cubeRight = Image::Load("./image/skybox/right.jpg", false);
-    auto cubeLeft = Image::Load("./image/skybox/left.jpg", false);
-    auto cubeTop = Image::Load("./image/skybox/top.jpg", false);
-    auto cubeBottom = Image::Load("./image/skybox/bottom.jpg", false);
-    auto cubeFront = Image::Load("./image/skybox/front.jpg", false);
-    auto cubeBack = Image::Load("./image/skybox/back.jpg", false);
+    auto cubeImages = LoadImages({
+                                     "./image/skybox/right.jpg",
+                                     "./image/skybox/left.jpg",
+                                     "./image/skybox/top.jpg",
+                                     "./image/skybox/bottom.jpg",
+                                     "./image/skybox/front.jpg",
+                                     "./image/skybox/back.jpg",
+                                 },
+                                 false);
     m_skyboxTexture = CubeTexture::CreateFromImages({
-        cubeRight.get(),
-        cubeLeft.get(),
-        cubeTop.get(),
-        cubeBottom.get(),
-        cubeFront.get(),
-        cubeBack.get(),
+        cubeImages[0].get(),
+        cubeImages[1].get(),
+        cubeImages[2].get(),
+        cubeImages[3].get(),
+        cubeImages[4].get(),
+        cubeImages[5].get(),
     });
 
     m_skyboxMaterial = MaterialPtr(new Material(m_skyboxProgram));
@@ -133,6 +184,7 @@ void Context::InitMaterial()
 
     shadowmapMaterial = MaterialPtr(new Material(m_simpleProgram));
     shadowmapMaterial->SetProperty("color", vec4(1.0f, 1.0f, 1.0f, 1.0f));
+    shadowCascadeMaterial = MaterialPtr(new Material(m_shadowCascadeProgram));
 
     deferredGeoGroundMaterial = MaterialPtr(new Material(m_deferGeoProgram));
     deferredGeoGroundMaterial->SetProperty("material.diffuse", groundTexture);
@@ -142,10 +194,26 @@ void Context::InitMaterial()
     deferredGeoBoxMaterial->SetProperty("material.diffuse", boxTexture);
     deferredGeoBoxMaterial->SetProperty("material.specular", darkGrayTexture);
 
-    deferredLightMaterial = DeferredMaterialPtr(new DeferredMaterial(m_deferLightProgram, m_deferLights.size()));
+    deferredLightMaterial = DeferredMaterialPtr(new DeferredMaterial(m_deferLightProgram));
+    lightVolumeMaterial = LightVolumeMaterialPtr(new LightVolumeMaterial(m_lightVolumeProgram));
+    depthOnlyMaterial = MaterialPtr(new Material(m_depthOnlyProgram));
+    overdrawMaterial = MaterialPtr(new Material(m_overdrawProgram));
+    overdrawMaterial->SetProperty("color", vec4(1.0f)); // blend(GL_ONE, GL_ONE)로 fragment마다 1씩 더함
+    overdrawViewMaterial = TextureMaterialPtr(new TextureMaterial(m_overdrawViewProgram));
 
     ssaoMaterial = SSAOMaterialPtr(new SSAOMaterial(m_ssaoProgram));
+    // kernel은 바뀌지 않으므로 한번만 올림. noiseScale은 CreateSsaoFramebuffers에서 설정
+    ssaoMaterial->SetStaticProperty("samples", m_ssaoSamples);
+    ssaoMaterial->SetStaticProperty("radius", m_ssaoRadius);
+    gtaoMaterial = SSAOMaterialPtr(new SSAOMaterial(m_gtaoProgram));
+    gtaoMaterial->SetStaticProperty("radius", m_ssaoRadius);
     ssaoBlurMaterial = TextureMaterialPtr(new TextureMaterial(m_blurProgram));
+    separableBlurMaterial = BlurMaterialPtr(new BlurMaterial(m_separableBlurProgram));
+    bilateralBlurMaterial = BlurMaterialPtr(new BlurMaterial(m_bilateralBlurProgram));
+    ssaoDepthMaterial = SSAODepthMaterialPtr(new SSAODepthMaterial(m_ssaoDepthProgram));
+    ssaoDepthMipMaterial = SSAODepthMipMaterialPtr(new SSAODepthMipMaterial(m_ssaoDepthMipProgram));
+    ssaoTemporalMaterial = SSAOTemporalMaterialPtr(new SSAOTemporalMaterial(m_ssaoTemporalProgram));
+    ssaoUpsampleMaterial = SSAOUpsampleMaterialPtr(new SSAOUpsampleMaterial(m_ssaoUpsampleProgram));
 
     std::vector<glm::vec3> ssaoNoise;
     ssaoNoise.resize(16);
@@ -161,35 +229,143 @@ void Context::InitMaterial()
     m_ssaoNoiseTexture->SetWrap(GL_REPEAT, GL_REPEAT);
     glTexSubImage2D(GL_TEXTURE_2D, 0, 0, 0, 4, 4, GL_RGB, GL_FLOAT, ssaoNoise.data());
 
-    m_shadowMap = ShadowMap::Create(1024, 1024);
+    m_shadowMap = ShadowMap::Create(SHADOW_MAP_SIZE, SHADOW_MAP_SIZE);
+    SetShadowCascadeCount(m_shadowCascadeCount);
+}
+
+void Context::SetShadowCascadeCount(int count)
+{
+    m_shadowCascadeCount = glm::clamp(count, 0, CascadedShadowMap::MAX_CASCADES);
+    m_cascadedShadowMap = m_shadowCascadeCount > 0
+                              ? CascadedShadowMap::Create(SHADOW_MAP_SIZE, m_shadowCascadeCount)
+                              : nullptr;
+}
+
+std::vector<ImagePtr> Context::LoadImages(const std::vector<std::string> &filenames, bool flipVertical)
+{
+    std::vector<ImagePtr> images(filenames.size());
+    std::vector<std::string> errors(filenames.size());
+    m_jobSystem->ParallelFor(filenames.size(), [&](size_t begin, size_t end)
+                             {
+        for (size_t i = begin; i < end; i++)
+        {
+            // job 안에서 던진 예외는 잡아서 GL 스레드에서 다시 던짐
+            try
+            {
+                images[i] = Image::Load(filenames[i], flipVertical);
+            }
+            catch (std::string error)
+            {
+                errors[i] = error;
+            }
+        } },
+                             1);
+
+    for (auto &error : errors)
+    {
+        if (!error.empty())
+            throw error;
+    }
+    return images;
 }
 
 void Context::InitObject()
 {
+    m_scene = Scene::Create();
+    auto boxMesh = m_scene->AddMesh(m_box);
+    auto planeMesh = m_scene->AddMesh(m_plane);
+
+    auto shadowed = RENDER_FORWARD | RENDER_SHADOW_CASTER;
+    m_scene->CreateRenderable(Transform(vec3(0.0f, -0.5f, 0.0f), vec3(1.0f, 1.0f, 1.0f), vec3(15.0f, 1.0f, 15.0f)),
+                              boxMesh, m_scene->AddMaterial(m_groundMaterial), shadowed);
+    Transform box1Transform(vec3(3.0f, 0.75f, -1.0f), vec3(0.0f, 1.0f, 0.0f), vec3(1.5f, 1.5f, 1.5f));
+    auto box1 = m_scene->CreateRenderable(box1Transform, boxMesh, m_scene->AddMaterial(m_box1Material), shadowed);
+
+    // benchmark용 추가 박스
+    auto boxMaterial = m_scene->AddMaterial(m_box2Material);
+    for (int i = 0; i < m_sceneOption.boxCount; i++)
+    {
+        float scale = RandomRange(0.2f, 0.6f);
+        m_scene->CreateRenderable(Transform(vec3(RandomRange(-7.0f, 7.0f), scale * 0.5f, RandomRange(-7.0f, 7.0f)),
+                                            vec3(0.0f, RandomRange(0.0f, 360.0f), 0.0f), vec3(scale)),
+                                  boxMesh, boxMaterial, shadowed);
+    }
+
+    // 반투명 평면은 생성 순서(먼 것부터)대로 그려짐
+    auto planeMaterial = m_scene->AddMaterial(m_planeMaterial);
+    auto transparent = RENDER_FORWARD | RENDER_TRANSPARENT;
+    m_scene->CreateRenderable(Transform(vec3(0, 0.5f, 4.0f), vec3(0), vec3(1)), planeMesh, planeMaterial, transparent);
+    m_scene->CreateRenderable(Transform(vec3(0.2f, 0.5f, 5.0f), vec3(0), vec3(1)), planeMesh, planeMaterial, transparent);
+    m_scene->CreateRenderable(Transform(vec3(0.4f, 0.5f, 6.0f), vec3(0), vec3(1)), planeMesh, planeMaterial, transparent);
+
+    m_scene->CreateRenderable(Transform(vec3(-20.0f, -0.5f, 0.0f), vec3(1.0f, 1.0f, 1.0f), vec3(15.0f, 1.0f, 15.0f)),
+                              boxMesh, m_scene->AddMaterial(deferredGeoGroundMaterial), RENDER_DEFERRED);
+    Transform deferredBoxTransform(vec3(-20.0f, 0.75f, 0.0f), vec3(0.0f, 1.0f, 0.0f), vec3(1.5f, 1.5f, 1.5f));
+    auto deferredBox = m_scene->CreateRenderable(deferredBoxTransform, boxMesh,
+                                                 m_scene->AddMaterial(deferredGeoBoxMaterial), RENDER_DEFERRED);
+
+    // 박스 회전은 simulation tick에서 계산
+    m_simulation = Simulation::Create(m_camera, m_light);
+    m_simulation->AddAnimatedEntity(box1, box1Transform, vec3(0.0f, 30.0f, 0.0f));
+    m_simulation->AddAnimatedEntity(deferredBox, deferredBoxTransform, vec3(0.0f, -45.0f, 0.0f));
+    m_simulation->SetAnimation(m_animation);
+    if (m_simulationThread)
+        m_simulation->Start();
+
+    m_shadowDepthQueue = RenderQueue::Create();
+    m_shadowedQueue = RenderQueue::Create();
+    m_deferredQueue = RenderQueue::Create();
+    m_transparentQueue = RenderQueue::Create();
+
     objSkybox = ObjectUPtr(new Object(m_box, m_camera.Pos, vec3(1), vec3(50), m_skyboxMaterial));
-    objGround = ObjectUPtr(new Object(m_box, vec3(0.0f, -0.5f, 0.0f), vec3(1.0f, 1.0f, 1.0f), vec3(15.0f, 1.0f, 15.0f), m_groundMaterial));
-    objBox1 = ObjectUPtr(new Object(m_box, vec3(3.0f, 0.75f, -1.0f), vec3(0.0f, 1.0f, 0.0f), vec3(1.5f, 1.5f, 1.5f), m_box1Material));
     stencilBox = StencilBoxUPtr(new StencilBox(m_box, vec3(-5.0f, 0.75f, 3.0f), vec3(0, 20, 0), vec3(1.5f), m_box2Material));
-    objPlane1 = ObjectUPtr(new Object(m_plane, vec3(0, 0.5f, 4.0f), vec3(0), vec3(1), m_planeMaterial));
-    objPlane2 = ObjectUPtr(new Object(m_plane, vec3(0.2f, 0.5f, 5.0f), vec3(0), vec3(1), m_planeMaterial));
-    objPlane3 = ObjectUPtr(new Object(m_plane, vec3(0.4f, 0.5f, 6.0f), vec3(0), vec3(1), m_planeMaterial));
     objCubemap = CubemapUPtr(new Cubemap(m_box, vec3(0.0f, 0.75f, 0.0f), vec3(0, 40, 0), vec3(2.f), m_cubeMapMaterial));
     objGrass = ObjectUPtr(new Object(m_plane, vec3(0.0f, 0.5f, 0.0f), vec3(0), vec3(0.5f), m_grassMaterial));
-    objGrass->ActiveInstancing(10000, 3, 3, 1);
+    objGrass->ActiveInstancing(m_sceneOption.grassCount, 3, 4, 1);
+    m_grassTrampleGrid = GrassTrample::Create();
 
     objWall = WallUPtr(new Wall(m_plane, vec3(0.0f, 3.0f, -8.0f), vec3(-45, 0, 0), vec3(8), m_wallMaterial));
     objDeferredPlane = DeferredPlanePtr(new DeferredPlane(m_plane, Transform(vec3(0), vec3(0), vec3(2)), deferredLightMaterial));
-    objDeferredGround = ObjectUPtr(new Object(m_box, vec3(-20.0f, -0.5f, 0.0f), vec3(1.0f, 1.0f, 1.0f), vec3(15.0f, 1.0f, 15.0f), deferredGeoGroundMaterial));
-    objDeferredBox = ObjectUPtr(new Object(m_box, vec3(-20.0f, 0.75f, 0.0f), vec3(0.0f, 1.0f, 0.0f), vec3(1.5f, 1.5f, 1.5f), deferredGeoBoxMaterial));
+    m_lightCluster = LightCluster::Create();
+    // 위도/경도 분할 구의 면이 반지름 1인 구를 감싸도록 1 / (cos(pi / 위도) * cos(pi / 경도)) 만큼 키움
+    const uint32_t latiSegmentCount = 12, longiSegmentCount = 16;
+    MeshPtr sphere = Mesh::CreateSphere(latiSegmentCount, longiSegmentCount);
+    float volumeScale = 1.0f / (cosf(pi<float>() / latiSegmentCount) * cosf(pi<float>() / longiSegmentCount));
+    objLightVolumes = LightVolumesUPtr(new LightVolumes(sphere, lightVolumeMaterial, volumeScale));
     objSSAOPlane = SSAOPlaneUPtr(new SSAOPlane(m_plane, Transform(vec3(0), vec3(0), vec3(2.f)), ssaoMaterial));
     objBlurPlane = BlurPlaneUPtr(new BlurPlane(m_plane, Transform(vec3(0), vec3(0), vec3(2.f)), ssaoBlurMaterial));
+    objSeparableBlurPlane = BlurPlaneUPtr(new BlurPlane(m_plane, Transform(vec3(0), vec3(0), vec3(2.f)), separableBlurMaterial));
+    objBilateralBlurPlane = BlurPlaneUPtr(new BlurPlane(m_plane, Transform(vec3(0), vec3(0), vec3(2.f)), bilateralBlurMaterial));
+    objSSAODepthPlane = SSAODepthPlaneUPtr(new SSAODepthPlane(m_plane, Transform(vec3(0), vec3(0), vec3(2.f)), ssaoDepthMaterial));
+    objSSAODepthMipPlane = SSAODepthMipPlaneUPtr(new SSAODepthMipPlane(m_plane, Transform(vec3(0), vec3(0), vec3(2.f)), ssaoDepthMipMaterial));
+    objGTAOPlane = SSAOPlaneUPtr(new SSAOPlane(m_plane, Transform(vec3(0), vec3(0), vec3(2.f)), gtaoMaterial));
+    objSSAOTemporalPlane = SSAOTemporalPlaneUPtr(new SSAOTemporalPlane(m_plane, Transform(vec3(0), vec3(0), vec3(2.f)), ssaoTemporalMaterial));
+    objSSAOUpsamplePlane = SSAOUpsamplePlaneUPtr(new SSAOUpsamplePlane(m_plane, Transform(vec3(0), vec3(0), vec3(2.f)), ssaoUpsampleMaterial));
+    objOverdrawPlane = BlurPlaneUPtr(new BlurPlane(m_plane, Transform(vec3(0), vec3(0), vec3(2.f)), overdrawViewMaterial));
 
     m_model = ModelUPtr(new Model("./model/backpack.obj", modelMaterial, Transform(vec3(-20.f, 0.5f, 3.0f), vec3(-90, 0, 0), vec3(0.5f))));
+    // 복사본은 원본 뒤쪽으로 8열 격자로 배치
+    for (int i = 0; i < m_sceneOption.modelCount; i++)
+    {
+        vec3 offset = vec3((float)(i % 8) * 2.0f - 7.0f, 0.0f, (float)(i / 8) * 2.0f);
+        m_modelTransforms.push_back(Transform(vec3(-20.f, 0.5f, 3.0f) + (i == 0 ? vec3(0.0f) : offset),
+                                              vec3(-90, 0, 0), vec3(0.5f)));
+    }
 }
 
 void Context::InitParameters()
 {
-    m_deferLights.resize(32);
+    m_lightingMode = m_sceneOption.lightingMode;
+    m_depthPrepass = m_sceneOption.depthPrepass;
+    m_ssaoResolution = m_sceneOption.ssaoResolution;
+    m_ssaoBlur = m_sceneOption.ssaoBlur;
+    m_ssaoMode = m_sceneOption.ssaoMode;
+    m_ssaoTemporal = m_sceneOption.ssaoTemporal;
+    m_light.directional = m_sceneOption.directionalLight;
+    m_shadowCascadeCount = m_sceneOption.shadowCascades;
+    auto attenuation = GetAttenuationCoeff(m_sceneOption.lightRange);
+    float radius = GetAttenuationRadius(attenuation);
+    m_deferLights.resize(glm::max(m_sceneOption.lightCount, 0));
     for (size_t i = 0; i < m_deferLights.size(); i++)
     {
         m_deferLights[i].position = glm::vec3(
@@ -200,6 +376,8 @@ void Context::InitParameters()
             RandomRange(0.0f, i < 3 ? 1.0f : 0.0f),
             RandomRange(0.0f, i < 3 ? 1.0f : 0.0f),
             RandomRange(0.0f, i < 3 ? 1.0f : 0.0f));
+        m_deferLights[i].attenuation = attenuation;
+        m_deferLights[i].radius = radius;
     }
 
     m_ssaoSamples.resize(64);
@@ -270,50 +448,195 @@ void Context::UpdateLight(mat4 &projection, mat4 &view)
     m_lightingShadowProgram->SetUniform("material.specular", 1);
 }
 
-void Context::UpdateCamera()
+void Context::SetCamera(const Camera &camera)
 {
-    m_camera.Front = rotate(mat4(1.0f), radians(m_camera.Yaw), vec3(0.0f, 1.0f, 0.0f)) *
-                     rotate(mat4(1.0f), radians(m_camera.Pitch), vec3(1.0f, 0.0f, 0.0f)) *
-                     vec4(0.0f, 0.0f, -1.0f, 0.0f); // 4차원 성분이 0이면 벡터, 1이면 점
+    m_camera = camera;
+    m_cameraEditVersion = m_simulation->SetCamera(camera);
+}
 
+void Context::SetSimulationThread(bool threaded)
+{
+    m_simulationThread = threaded;
+    if (threaded)
+        m_simulation->Start();
+    else
+        m_simulation->Stop();
+}
+
+void Context::UpdateSimulation()
+{
+    // 스레드를 쓰지 않으면 main loop의 Timer 간격만큼 simulation을 진행
+    if (!m_simulation->IsThreaded())
+        m_simulation->Advance(m_frameTime);
+
+    // 직전 tick과 최신 tick 사이를 보간해서 tick rate보다 높은 프레임에서도 부드럽게 움직이도록 함
+    auto &snapshot = m_simulation->Acquire();
+    float alpha = m_simulation->GetAlpha();
+    // UI에서 바꾼 값이 아직 simulation에 반영되지 않았으면 이전 snapshot으로 덮어쓰지 않음
+    if (snapshot.cameraVersion >= m_cameraEditVersion)
+    {
+        m_camera = snapshot.camera;
+        m_camera.Pos = mix(snapshot.prevCamera.Pos, snapshot.camera.Pos, alpha);
+        m_camera.Front = normalize(mix(snapshot.prevCamera.Front, snapshot.camera.Front, alpha));
+    }
+    if (snapshot.lightVersion >= m_lightEditVersion)
+        m_light = snapshot.light;
+    for (auto &entity : snapshot.transforms)
+    {
+        auto &prev = entity.previous;
+        auto &curr = entity.transform;
+        m_scene->SetTransform(entity.entity,
+                              Transform(mix(prev.GetPosition(), curr.GetPosition(), alpha),
+                                        slerp(prev.GetRotation(), curr.GetRotation(), alpha),
+                                        mix(prev.GetScale(), curr.GetScale(), alpha)));
+    }
+}
+
+void Context::UpdateCamera()
+{
+    // Front는 simulation에서 계산됨
     // 종횡비 4:3, 세로화각 45도의 원근 투영
-    m_camera.projection = perspective(radians(45.0f), (float)m_width / (float)m_height, 0.01f, 100.0f);
+    m_camera.projection = perspective(radians(CAMERA_FOVY), (float)m_width / (float)m_height, CAMERA_NEAR, CAMERA_FAR);
     m_camera.view = lookAt(m_camera.Pos, m_camera.Pos + m_camera.Front, m_camera.Up);
 }
 
-void Context::DrawShadowedObjects(const mat4 &view, const mat4 &projection, const MaterialPtr &optionMat)
+void Context::UpdateGrass()
 {
-    objGround->Render(view, projection, optionMat);
-    objBox1->Render(view, projection, optionMat);
-    stencilBox->Render(view, projection, optionMat, m_simpleProgram, vec4(1.0f, 1.0f, 0.5f, 1.0f), 1.05f);
+    m_grassMaterial->SetProperty("time", m_time);
+    if (!m_grassTrample)
+        return;
+
+    // 카메라 근처의 풀은 눕히고, 나머지는 서서히 원래대로 복구
+    // 격자로 주변 풀만 찾으므로 인스턴스 수가 많아도 매 프레임 전체를 순회하지 않음
+    vec3 localCam = inverse(objGrass->trf.GetTransform()) * vec4(m_camera.Pos, 1.0f);
+    bool nearGround = localCam.y < 4.0f;
+    m_grassTrampleGrid->Update(objGrass->GetInstances(), vec2(localCam.x, localCam.z), nearGround);
+}
+
+void Context::GetLightTransform(mat4 &view, mat4 &projection) const
+{
+    view = lookAt(m_light.position,
+                  m_light.position + m_light.direction,
+                  vec3(0.0f, 1.0f, 0.0f));
+
+    projection = m_light.directional ? ortho(-10.0f, 10.0f, -10.0f, 10.0f, 1.0f, 30.0f)
+                                     : perspective(radians((m_light.cutoff[0] + m_light.cutoff[1]) * 2.0f), 1.0f, 1.0f, 20.0f);
+}
+
+void Context::BuildRenderQueues()
+{
+    auto start = std::chrono::high_resolution_clock::now();
+
+    mat4 lightView, lightProjection;
+    GetLightTransform(lightView, lightProjection);
+    if (UseCascadedShadow())
+    {
+        // 카메라에 맞춘 cascade를 먼저 계산하고 shadow caster는 모든 cascade를 감싸는 범위로 culling
+        m_cascadedShadowMap->Update(m_camera.view, radians(CAMERA_FOVY), (float)m_width / (float)m_height,
+                                    CAMERA_NEAR, m_shadowDistance, m_light.direction, m_shadowSplitLambda);
+        lightView = m_cascadedShadowMap->GetLightView();
+        lightProjection = m_cascadedShadowMap->GetBoundsProjection();
+    }
+
+    m_scene->GetChunks(COMPONENT_RENDERABLE, m_renderChunks);
+    size_t chunkCount = m_renderChunks.size();
+    m_shadowDepthQueue->Begin(RENDER_SHADOW_CASTER, lightView, lightProjection, RenderSortMode::State, chunkCount);
+    m_shadowedQueue->Begin(RENDER_SHADOW_CASTER, m_camera.view, m_camera.projection, RenderSortMode::State, chunkCount);
+    m_deferredQueue->Begin(RENDER_DEFERRED, m_camera.view, m_camera.projection, RenderSortMode::State, chunkCount);
+    m_transparentQueue->Begin(RENDER_TRANSPARENT, m_camera.view, m_camera.projection, RenderSortMode::BackToFront, chunkCount);
+    RenderQueue *queues[] = {m_shadowDepthQueue.get(), m_shadowedQueue.get(),
+                             m_deferredQueue.get(), m_transparentQueue.get()};
+
+    // chunk마다 transform 계산 + 모든 pass의 packet 기록을 하나의 job으로 처리
+    auto recordChunk = [&](size_t i)
+    {
+        auto &chunk = *m_renderChunks[i];
+        Scene::UpdateChunkTransforms(chunk);
+        for (auto queue : queues)
+            queue->Record(chunk, i);
+    };
+
+    if (m_parallelRecord)
+    {
+        JobCounter counter;
+        for (size_t i = 0; i < chunkCount; i++)
+            m_jobSystem->Submit([&, i]
+                                { recordChunk(i); },
+                                &counter);
+        m_jobSystem->Wait(&counter);
+
+        JobCounter sortCounter;
+        for (auto queue : queues)
+            m_jobSystem->Submit([queue]
+                                { queue->Finish(); },
+                                &sortCounter);
+        m_jobSystem->Wait(&sortCounter);
+    }
+    else
+    {
+        for (size_t i = 0; i < chunkCount; i++)
+            recordChunk(i);
+        for (auto queue : queues)
+            queue->Finish();
+    }
+
+    auto end = std::chrono::high_resolution_clock::now();
+    m_recordTime = std::chrono::duration<float, std::milli>(end - start).count();
 }
 
-void Context::DrawShadowedObjects(const Camera &cam, const MaterialPtr &optionMat)
+void Context::DrawShadowedObjects(const RenderQueue &queue, const mat4 &view, const mat4 &projection, const MaterialPtr &optionMat)
 {
-    DrawShadowedObjects(cam.view, cam.projection, optionMat);
+    queue.Execute(*m_scene, optionMat);
+    stencilBox->Render(view, projection, optionMat, m_simpleProgram, vec4(1.0f, 1.0f, 0.5f, 1.0f), 1.05f);
 }
 
 void Context::GenerateShadowMap()
 {
-    auto lightView = lookAt(m_light.position,
-                            m_light.position + m_light.direction,
-                            vec3(0.0f, 1.0f, 0.0f));
+    if (UseCascadedShadow())
+    {
+        m_cascadedShadowMap->Bind();
+        Framebuffer::Clear(GL_DEPTH_BUFFER_BIT);
+        glViewport(0, 0, m_cascadedShadowMap->GetResolution(), m_cascadedShadowMap->GetResolution());
+
+        // geometry shader가 삼각형을 cascade마다 복사하므로 모든 layer를 한 번에 그림
+        int cascadeCount = m_cascadedShadowMap->GetCascadeCount();
+        m_shadowCascadeProgram->Use();
+        m_shadowCascadeProgram->SetUniform("cascadeCount", cascadeCount);
+        for (int i = 0; i < cascadeCount; i++)
+            m_shadowCascadeProgram->SetUniform(fmt::format("cascadeViewProjection[{}]", i),
+                                               m_cascadedShadowMap->GetViewProjection(i));
+        // near plane보다 광원 쪽에 있는 caster도 잘리지 않고 near 깊이로 기록되게 함
+        glEnable(GL_DEPTH_CLAMP);
+        DrawShadowedObjects(*m_shadowDepthQueue, m_cascadedShadowMap->GetLightView(),
+                            m_cascadedShadowMap->GetBoundsProjection(), shadowCascadeMaterial);
+        glDisable(GL_DEPTH_CLAMP);
+
+        Framebuffer::BindToDefault();
+        glViewport(0, 0, m_width, m_height);
+        return;
+    }
 
-    auto lightProjection = m_light.directional ? ortho(-10.0f, 10.0f, -10.0f, 10.0f, 1.0f, 30.0f)
-                                               : perspective(radians((m_light.cutoff[0] + m_light.cutoff[1]) * 2.0f), 1.0f, 1.0f, 20.0f);
+    mat4 lightView, lightProjection;
+    GetLightTransform(lightView, lightProjection);
 
     m_shadowMap->Bind();
-    glClear(GL_DEPTH_BUFFER_BIT);
+    Framebuffer::Clear(GL_DEPTH_BUFFER_BIT);
     glViewport(0, 0,
                m_shadowMap->GetShadowMap()->GetWidth(),
                m_shadowMap->GetShadowMap()->GetHeight());
 
     // 광원에서 shadow depth map을 그림
-    DrawShadowedObjects(lightView, lightProjection, shadowmapMaterial);
+    DrawShadowedObjects(*m_shadowDepthQueue, lightView, lightProjection, shadowmapMaterial);
     //
 
     Framebuffer::BindToDefault();
     glViewport(0, 0, m_width, m_height);
+}
+
+void Context::RenderShadowedObjects()
+{
+    mat4 lightView, lightProjection;
+    GetLightTransform(lightView, lightProjection);
 
     m_lightingShadowProgram->Use();
     m_lightingShadowProgram->SetUniform("viewPos", m_camera.Pos);
@@ -333,11 +656,98 @@ void Context::GenerateShadowMap()
     glActiveTexture(GL_TEXTURE0 + shadowMapTexNum);
     m_shadowMap->GetShadowMap()->Bind();
     m_lightingShadowProgram->SetUniform("shadowMap", shadowMapTexNum);
+
+    // sampler 종류가 다르면 같은 unit을 가리킬 수 없으므로 cascade를 쓰지 않아도 unit은 지정
+    const int cascadeShadowMapTexNum = 13;
+    m_lightingShadowProgram->SetUniform("cascadeShadowMap", cascadeShadowMapTexNum);
+    m_lightingShadowProgram->SetUniform("useCascades", UseCascadedShadow() ? 1 : 0);
+    if (UseCascadedShadow())
+    {
+        glActiveTexture(GL_TEXTURE0 + cascadeShadowMapTexNum);
+        m_cascadedShadowMap->GetShadowMap()->Bind();
+        int cascadeCount = m_cascadedShadowMap->GetCascadeCount();
+        m_lightingShadowProgram->SetUniform("cascadeCount", cascadeCount);
+        m_lightingShadowProgram->SetUniform("cascadeSplits", m_cascadedShadowMap->GetSplitDepths());
+        m_lightingShadowProgram->SetUniform("view", m_camera.view);
+        for (int i = 0; i < cascadeCount; i++)
+            m_lightingShadowProgram->SetUniform(fmt::format("cascadeViewProjection[{}]", i),
+                                                m_cascadedShadowMap->GetViewProjection(i));
+    }
     glActiveTexture(GL_TEXTURE0);
 
     // shadowed Material
 
-    DrawShadowedObjects(m_camera);
+    DrawShadowedObjects(*m_shadowedQueue, m_camera.view, m_camera.projection);
+}
+
+void Context::DrawDeferredGeometry(const MaterialPtr &positionOnlyMat)
+{
+    if (positionOnlyMat)
+    {
+        m_deferredQueue->Execute(*m_scene, positionOnlyMat, true);
+        for (auto &trf : m_modelTransforms)
+        {
+            m_model->SetTransform(trf);
+            m_model->RenderPositionOnly(m_camera.view, m_camera.projection, positionOnlyMat);
+        }
+        return;
+    }
+
+    m_deferredQueue->Execute(*m_scene);
+    for (auto &trf : m_modelTransforms)
+    {
+        m_model->SetTransform(trf);
+        m_model->Render(m_camera.view, m_camera.projection);
+    }
+}
+
+void Context::RenderOverdraw()
+{
+    if (!m_overdrawFramebuffer)
+    {
+        // fragment 수를 세는 쪽은 장면을 depth test하며 그리므로 depth가 필요하고, 시각화 쪽은 full-screen pass만 그림
+        m_overdrawFramebuffer = Framebuffer::Create({
+            Texture::Create(m_width, m_height, GL_R16F, GL_FLOAT),
+        });
+        m_overdrawViewFramebuffer = Framebuffer::CreateColorOnly({
+            Texture::Create(m_width, m_height, GL_RGBA),
+        });
+    }
+
+    // G-buffer pass와 같은 순서, 같은 depth 상태로 depth test를 통과한 fragment 수를 셈
+    m_overdrawFramebuffer->Bind();
+    glClearColor(0.0f, 0.0f, 0.0f, 0.0f);
+    Framebuffer::Clear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT);
+    glViewport(0, 0, m_width, m_height);
+    if (m_depthPrepass)
+    {
+        glColorMask(GL_FALSE, GL_FALSE, GL_FALSE, GL_FALSE);
+        DrawDeferredGeometry(depthOnlyMaterial);
+        glColorMask(GL_TRUE, GL_TRUE, GL_TRUE, GL_TRUE);
+        glDepthFunc(GL_EQUAL);
+        glDepthMask(GL_FALSE);
+    }
+    glEnable(GL_BLEND);
+    glBlendFunc(GL_ONE, GL_ONE);
+    DrawDeferredGeometry(overdrawMaterial);
+    glDisable(GL_BLEND);
+    glDepthFunc(GL_LESS);
+    glDepthMask(GL_TRUE);
+
+    // 가장 작은 mip level(1x1)이 화면 전체의 평균. 결과를 기다리므로 시각화할 때만 사용
+    auto countTexture = m_overdrawFramebuffer->GetColorAttachment();
+    countTexture->Bind();
+    glGenerateMipmap(GL_TEXTURE_2D);
+    int topLevel = (int)floorf(log2f((float)glm::max(m_width, m_height)));
+    glGetTexImage(GL_TEXTURE_2D, topLevel, GL_RED, GL_FLOAT, &m_overdrawAverage);
+
+    m_overdrawViewFramebuffer->Bind();
+    glViewport(0, 0, m_width, m_height);
+    Framebuffer::Clear(GL_COLOR_BUFFER_BIT);
+    glDisable(GL_DEPTH_TEST);
+    objOverdrawPlane->Render(countTexture);
+    glEnable(GL_DEPTH_TEST);
+    glDisable(GL_BLEND); // TextureMaterial이 켠 blend
 }
 
 void Context::RenderDeffered()
@@ -346,65 +756,196 @@ void Context::RenderDeffered()
 
     m_deferGeoFramebuffer->Bind();
     glClearColor(0.0f, 0.0f, 0.0f, 0.0f);
-    glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT);
+    Framebuffer::Clear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT);
     glViewport(0, 0, m_width, m_height);
 
-    objDeferredGround->Render(m_camera.view, m_camera.projection);
-    objDeferredBox->Render(m_camera.view, m_camera.projection);
-    m_model->Render(m_camera.view, m_camera.projection);
+    // depth pre-pass : 가장 가까운 면의 depth만 먼저 기록하고
+    // G-buffer pass는 GL_EQUAL로 보이는 fragment만 MRT에 기록
+    if (m_depthPrepass)
+    {
+        PROFILE_SCOPE(m_profiler.get(), "depth pre-pass");
+        glColorMask(GL_FALSE, GL_FALSE, GL_FALSE, GL_FALSE);
+        DrawDeferredGeometry(depthOnlyMaterial);
+        glColorMask(GL_TRUE, GL_TRUE, GL_TRUE, GL_TRUE);
+    }
 
-    m_ssaoFramebuffer->Bind();
-    glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT);
-    glViewport(0, 0, m_width, m_height);
-    objSSAOPlane->Render(m_camera, m_deferGeoFramebuffer, m_ssaoNoiseTexture, vec2(m_width, m_height), m_ssaoRadius, m_ssaoSamples);
+    {
+        PROFILE_SCOPE(m_profiler.get(), "g-buffer");
+        if (m_depthPrepass)
+        {
+            glDepthFunc(GL_EQUAL);
+            glDepthMask(GL_FALSE);
+        }
+        DrawDeferredGeometry();
+        glDepthFunc(GL_LESS);
+        glDepthMask(GL_TRUE);
+    }
 
-    m_ssaoBlurFramebuffer->Bind();
-    glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT);
-    glViewport(0, 0, m_width, m_height);
-    objBlurPlane->Render(m_ssaoFramebuffer->GetColorAttachment(0));
+    if (m_showOverdraw)
+    {
+        PROFILE_SCOPE(m_profiler.get(), "overdraw");
+        RenderOverdraw();
+    }
+
+    // SSAO는 1 / downsample 해상도에서 계산하고 blur 후 전체 해상도로 키움
+    int downsample = GetSsaoDownsample();
+    auto ssaoTarget = m_ssaoFramebuffer->GetColorAttachment();
+    // SSAO 단계의 target은 모두 depth가 없는 full-screen pass이므로 depth test를 끔
+    glDisable(GL_DEPTH_TEST);
+    {
+        PROFILE_SCOPE(m_profiler.get(), "ssao");
+        m_ssaoDepthFramebuffer->Bind();
+        glViewport(0, 0, ssaoTarget->GetWidth(), ssaoTarget->GetHeight());
+        Framebuffer::Clear(GL_COLOR_BUFFER_BIT);
+        objSSAODepthPlane->Render(m_camera, m_deferGeoFramebuffer, downsample);
+
+        if (m_ssaoMode == SsaoMode::Horizon)
+            BuildSsaoDepthMips();
+
+        m_ssaoFramebuffer->Bind();
+        glViewport(0, 0, ssaoTarget->GetWidth(), ssaoTarget->GetHeight());
+        Framebuffer::Clear(GL_COLOR_BUFFER_BIT);
+        // temporal 누적을 쓰면 프레임마다 kernel의 다른 부분과 다른 노이즈 회전을 사용 (R2 수열)
+        int kernelSize = (int)m_ssaoSamples.size();
+        int sampleCount = m_ssaoTemporal ? SSAO_TEMPORAL_SAMPLE_COUNT : kernelSize;
+        int sampleOffset = m_ssaoTemporal ? (int)(m_ssaoFrame % (uint32_t)(kernelSize / sampleCount)) : 0;
+        vec2 jitter = m_ssaoTemporal ? fract(vec2(0.7548777f, 0.5698403f) * (float)m_ssaoFrame) : vec2(0.0f);
+        m_ssaoFrame++;
+        auto &aoPlane = m_ssaoMode == SsaoMode::Horizon ? objGTAOPlane : objSSAOPlane;
+        aoPlane->Render(m_camera, m_deferGeoFramebuffer, m_ssaoDepthFramebuffer, m_ssaoNoiseTexture, downsample,
+                        sampleOffset, sampleCount, jitter);
+    }
+
+    // 이전 프레임 결과를 재투영해서 누적. blur는 누적된 결과에 적용
+    auto ssaoResult = ssaoTarget;
+    if (m_ssaoTemporal)
+    {
+        PROFILE_SCOPE(m_profiler.get(), "ssao temporal");
+        m_ssaoHistory->GetTarget()->Bind();
+        Framebuffer::Clear(GL_COLOR_BUFFER_BIT);
+        glViewport(0, 0, ssaoTarget->GetWidth(), ssaoTarget->GetHeight());
+        objSSAOTemporalPlane->Render(m_camera, ssaoTarget, *m_ssaoHistory,
+                                     m_ssaoPrevViewProjection * inverse(m_camera.view),
+                                     vec2((float)m_width, (float)m_height), downsample);
+        m_ssaoHistory->Swap();
+        ssaoResult = m_ssaoHistory->GetHistory();
+    }
+    m_ssaoPrevViewProjection = m_camera.projection * m_camera.view;
+
+    {
+        PROFILE_SCOPE(m_profiler.get(), "ssao blur");
+        glViewport(0, 0, ssaoTarget->GetWidth(), ssaoTarget->GetHeight());
+        if (m_ssaoBlur == SsaoBlur::Box)
+        {
+            m_ssaoBlurFramebuffer->Bind();
+            Framebuffer::Clear(GL_COLOR_BUFFER_BIT);
+            objBlurPlane->Render(ssaoResult);
+        }
+        else
+        {
+            // 가로 pass는 (AO, depth)를 그대로 넘기고 세로 pass 결과는 AO만 남김(GL_RED)
+            auto &blurPlane = m_ssaoBlur == SsaoBlur::Bilateral ? objBilateralBlurPlane : objSeparableBlurPlane;
+            m_ssaoBlurTempFramebuffer->Bind();
+            Framebuffer::Clear(GL_COLOR_BUFFER_BIT);
+            blurPlane->Render(ssaoResult, vec2(1.0f, 0.0f));
+            m_ssaoBlurFramebuffer->Bind();
+            Framebuffer::Clear(GL_COLOR_BUFFER_BIT);
+            blurPlane->Render(m_ssaoBlurTempFramebuffer->GetColorAttachment(), vec2(0.0f, 1.0f));
+        }
+    }
+
+    if (m_ssaoUpsampleFramebuffer)
+    {
+        PROFILE_SCOPE(m_profiler.get(), "ssao upsample");
+        m_ssaoUpsampleFramebuffer->Bind();
+        glViewport(0, 0, m_width, m_height);
+        Framebuffer::Clear(GL_COLOR_BUFFER_BIT);
+        objSSAOUpsamplePlane->Render(m_camera, m_deferGeoFramebuffer, m_ssaoDepthFramebuffer,
+                                     m_ssaoBlurFramebuffer->GetColorAttachment(), downsample);
+    }
+    glEnable(GL_DEPTH_TEST);
+
+    {
+        PROFILE_SCOPE(m_profiler.get(), "light culling");
+        m_lightCluster->Update(m_deferLights, m_camera.view, m_camera.projection,
+                               CAMERA_NEAR, CAMERA_FAR, m_lightingMode == DeferredLightingMode::Clustered);
+    }
 
     //
+    PROFILE_SCOPE(m_profiler.get(), "deferred lighting");
     Framebuffer::BindToDefault();
     glViewport(0, 0, m_width, m_height);
     glClearColor(m_clearColor.r, m_clearColor.g, m_clearColor.b, m_clearColor.a);
-    glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT | GL_STENCIL_BUFFER_BIT);
+    Framebuffer::Clear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT | GL_STENCIL_BUFFER_BIT);
 
-    objDeferredPlane->Render(m_camera, m_deferGeoFramebuffer, m_ssaoBlurFramebuffer, m_deferLights, m_useSsao);
+    // light volume 방식은 full-screen pass에서 ambient만 계산하고 광원은 구를 그려서 더함
+    bool lightVolume = m_lightingMode == DeferredLightingMode::LightVolume;
+    objDeferredPlane->Render(m_camera, m_deferGeoFramebuffer,
+                             m_ssaoUpsampleFramebuffer ? m_ssaoUpsampleFramebuffer : m_ssaoBlurFramebuffer, *m_lightCluster,
+                             lightVolume ? 0 : (int)m_deferLights.size(),
+                             m_lightingMode == DeferredLightingMode::Clustered, m_useSsao);
 
     //// forward 쉐이딩 전환
-    glBindFramebuffer(GL_READ_FRAMEBUFFER, m_deferGeoFramebuffer->Get());
-    glBindFramebuffer(GL_DRAW_FRAMEBUFFER, 0);
     // read buffer의 뎁스 정보(GL_DEPTH_BUFFER_BIT)를 draw 버퍼에 복사함
-    glBlitFramebuffer(0, 0, m_width, m_height,
-                      0, 0, m_width, m_height,
-                      GL_DEPTH_BUFFER_BIT, GL_NEAREST);
-    glBindFramebuffer(GL_FRAMEBUFFER, 0);
+    m_deferGeoFramebuffer->BlitToDefault(m_width, m_height, GL_DEPTH_BUFFER_BIT);
+    Framebuffer::BindToDefault();
+
+    // light volume은 복사한 depth로 장면 표면에 닿지 않는 픽셀을 걸러냄
+    if (lightVolume)
+        objLightVolumes->Render(m_camera, m_deferGeoFramebuffer, *m_lightCluster, (int)m_deferLights.size());
 }
 
-void Context::Render()
+void Context::Render(const Timer &timer)
 {
-    RenderIMGUI();
+    m_frameTime = (float)timer.GetDeltaTime();
+    m_time = (float)timer.GetTime();
+
+    FrameCapture::BeginFrame();
+    RenderStats::BeginFrame();
+    m_profiler->BeginFrame();
+    if (m_uiEnabled)
+    {
+        PROFILE_SCOPE(m_profiler.get(), "ui");
+        RenderIMGUI();
+    }
 
     // m_framebuffer->Bind();
 
-    glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT | GL_STENCIL_BUFFER_BIT);
+    Framebuffer::Clear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT | GL_STENCIL_BUFFER_BIT);
     glEnable(GL_DEPTH_TEST);
 
-    UpdateCamera();
+    {
+        PROFILE_SCOPE(m_profiler.get(), "simulation");
+        UpdateSimulation();
+        UpdateCamera();
+    }
+    {
+        PROFILE_SCOPE(m_profiler.get(), "render queue");
+        BuildRenderQueues();
+    }
 
     RenderDeffered();
-    UpdateLight(m_camera.projection, m_camera.view);
 
-    GenerateShadowMap();
-    objSkybox->Render(m_camera.view, m_camera.projection);
+    {
+        PROFILE_SCOPE(m_profiler.get(), "shadow map");
+        GenerateShadowMap();
+    }
 
-    objPlane1->Render(m_camera);
-    objPlane2->Render(m_camera);
-    objPlane3->Render(m_camera);
+    {
+        PROFILE_SCOPE(m_profiler.get(), "forward");
+        UpdateLight(m_camera.projection, m_camera.view);
+        RenderShadowedObjects();
+        objSkybox->Render(m_camera.view, m_camera.projection);
+
+        m_transparentQueue->Execute(*m_scene);
 
-    objCubemap->Render(m_camera);
-    objGrass->Render(m_camera);
-    objWall->Render(m_camera, m_light.position, m_wallMaterial);
+        objCubemap->Render(m_camera);
+        UpdateGrass();
+        objGrass->Render(m_camera);
+        objWall->Render(m_camera, m_light.position, m_wallMaterial);
+    }
+    m_profiler->EndFrame();
+    FrameCapture::EndFrame();
 
     //// post process
     // Framebuffer::BindToDefault();
@@ -425,21 +966,140 @@ void Context::RenderIMGUI()
     {
         if (ImGui::CollapsingHeader("light", ImGuiTreeNodeFlags_DefaultOpen))
         {
-            ImGui::Checkbox("l.directional", &m_light.directional);
-            ImGui::DragFloat3("l.position", value_ptr(m_light.position), 0.01f);
-            ImGui::DragFloat3("l.direction", value_ptr(m_light.direction), 0.01f);
-            ImGui::DragFloat("l.distance", &m_light.distance, 0.5f, 0, 3000.0f);
-            ImGui::DragFloat2("l.cutoff", value_ptr(m_light.cutoff), 0.5f, 0, 180.0f);
-            ImGui::ColorEdit3("l.ambient", value_ptr(m_light.ambient));
-            ImGui::ColorEdit3("l.diffuse", value_ptr(m_light.diffuse));
-            ImGui::ColorEdit3("l.specular", value_ptr(m_light.specular));
+            bool lightChanged = false;
+            lightChanged |= ImGui::Checkbox("l.directional", &m_light.directional);
+            lightChanged |= ImGui::DragFloat3("l.position", value_ptr(m_light.position), 0.01f);
+            lightChanged |= ImGui::DragFloat3("l.direction", value_ptr(m_light.direction), 0.01f);
+            lightChanged |= ImGui::DragFloat("l.distance", &m_light.distance, 0.5f, 0, 3000.0f);
+            lightChanged |= ImGui::DragFloat2("l.cutoff", value_ptr(m_light.cutoff), 0.5f, 0, 180.0f);
+            lightChanged |= ImGui::ColorEdit3("l.ambient", value_ptr(m_light.ambient));
+            lightChanged |= ImGui::ColorEdit3("l.diffuse", value_ptr(m_light.diffuse));
+            lightChanged |= ImGui::ColorEdit3("l.specular", value_ptr(m_light.specular));
+            if (lightChanged)
+                m_lightEditVersion = m_simulation->SetLight(m_light);
             ImGui::Checkbox("flash light", &m_freshLightMode);
             ImGui::Checkbox("l.blinn", &m_blinn);
             ImGui::Checkbox("use SSao", &m_useSsao);
-            ImGui::DragFloat("ssao radius", &m_ssaoRadius, 0.01f, 0.f, 5.0f);
+            const char *modeNames[] = {"hemisphere", "horizon (GTAO)"};
+            int mode = (int)m_ssaoMode;
+            if (ImGui::Combo("ssao mode", &mode, modeNames, 2))
+            {
+                m_ssaoMode = (SsaoMode)mode;
+                m_ssaoHistory->Invalidate();
+            }
+            if (ImGui::Checkbox("ssao temporal", &m_ssaoTemporal))
+                m_ssaoHistory->Invalidate();
+            if (ImGui::DragFloat("ssao radius", &m_ssaoRadius, 0.01f, 0.f, 5.0f))
+            {
+                ssaoMaterial->SetStaticProperty("radius", m_ssaoRadius);
+                gtaoMaterial->SetStaticProperty("radius", m_ssaoRadius);
+                m_ssaoHistory->Invalidate();
+            }
+            const char *resolutionNames[] = {"full", "half", "quarter"};
+            int resolution = (int)m_ssaoResolution;
+            if (ImGui::Combo("ssao resolution", &resolution, resolutionNames, 3))
+            {
+                m_ssaoResolution = (SsaoResolution)resolution;
+                CreateSsaoFramebuffers();
+            }
+            const char *blurNames[] = {"box 5x5", "separable gaussian", "bilateral"};
+            int blur = (int)m_ssaoBlur;
+            if (ImGui::Combo("ssao blur", &blur, blurNames, 3))
+                m_ssaoBlur = (SsaoBlur)blur;
         }
 
-        ImGui::Checkbox("animation", &m_animation);
+        if (ImGui::CollapsingHeader("shadow"))
+        {
+            int cascadeCount = m_shadowCascadeCount;
+            if (ImGui::SliderInt("cascades", &cascadeCount, 0, CascadedShadowMap::MAX_CASCADES))
+                SetShadowCascadeCount(cascadeCount);
+            ImGui::DragFloat("split lambda", &m_shadowSplitLambda, 0.01f, 0.0f, 1.0f);
+            ImGui::DragFloat("shadow distance", &m_shadowDistance, 0.5f, 1.0f, CAMERA_FAR);
+            if (!m_light.directional)
+                ImGui::Text("cascades are used only for the directional light");
+            else if (m_cascadedShadowMap)
+            {
+                auto splits = m_cascadedShadowMap->GetSplitDepths();
+                ImGui::Text("splits: %.2f / %.2f / %.2f / %.2f", splits.x, splits.y, splits.z, splits.w);
+            }
+        }
+
+        if (ImGui::CollapsingHeader("deferred lights"))
+        {
+            const char *modeNames[] = {"full-screen", "clustered", "light volume"};
+            int mode = (int)m_lightingMode;
+            if (ImGui::Combo("lighting", &mode, modeNames, 3))
+                m_lightingMode = (DeferredLightingMode)mode;
+            auto grid = m_lightCluster->GetGridSize();
+            ImGui::Text("lights: %d, clusters: %d x %d x %d", (int)m_deferLights.size(), grid.x, grid.y, grid.z);
+            ImGui::Text("light indices: %d, max per cluster: %d",
+                        (int)m_lightCluster->GetIndexCount(), m_lightCluster->GetMaxLightsPerCluster());
+            ImGui::Text("cluster build: %.3f ms", m_lightCluster->GetBuildTime());
+        }
+
+        if (ImGui::CollapsingHeader("deferred geometry"))
+        {
+            ImGui::Checkbox("depth pre-pass", &m_depthPrepass);
+            ImGui::Checkbox("show overdraw", &m_showOverdraw);
+            if (m_showOverdraw)
+                ImGui::Text("g-buffer fragments per pixel: %.2f", m_overdrawAverage);
+        }
+
+        if (ImGui::Checkbox("animation", &m_animation))
+            m_simulation->SetAnimation(m_animation);
+
+        if (ImGui::CollapsingHeader("simulation"))
+        {
+            bool threaded = m_simulationThread;
+            if (ImGui::Checkbox("simulation thread", &threaded))
+                SetSimulationThread(threaded);
+            float tickRate = m_simulation->GetTickRate();
+            if (ImGui::DragFloat("tick rate(Hz)", &tickRate, 1.0f, 10.0f, 240.0f))
+                m_simulation->SetTickRate(tickRate);
+            ImGui::Text("frame: %.3f ms, tick: %.3f ms, alpha: %.2f",
+                        m_frameTime * 1000.0f, m_simulation->GetTickTime(), m_simulation->GetAlpha());
+            ImGui::Text("snapshot latency: %.2f ms (avg %.2f ms)",
+                        m_simulation->GetSnapshotLatency(), m_simulation->GetAverageLatency());
+        }
+
+        if (ImGui::CollapsingHeader("profiler"))
+            RenderProfilerIMGUI();
+
+        if (ImGui::CollapsingHeader("render queue"))
+        {
+            ImGui::Checkbox("parallel record", &m_parallelRecord);
+            ImGui::Text("threads: %d, record: %.3f ms", (int)m_jobSystem->GetThreadCount(), m_recordTime);
+            ImGui::Text("packets: shadow %d / forward %d / deferred %d / transparent %d",
+                        (int)m_shadowDepthQueue->GetPacketCount(), (int)m_shadowedQueue->GetPacketCount(),
+                        (int)m_deferredQueue->GetPacketCount(), (int)m_transparentQueue->GetPacketCount());
+        }
+
+        if (ImGui::CollapsingHeader("grass"))
+        {
+            auto instances = objGrass->GetInstances();
+            ImGui::Text("instances: %d (drawn %d, bent %d)", (int)instances->GetCount(),
+                        (int)instances->GetDrawCount(), (int)m_grassTrampleGrid->GetBentCount());
+            ImGui::Text("upload: %.1f KB, pending pages: %d",
+                        instances->GetLastUploadSize() / 1024.0f, (int)instances->GetPendingPageCount());
+            ImGui::Checkbox("trample", &m_grassTrample);
+            int budgetKB = (int)(instances->GetUploadBudget() / 1024);
+            if (ImGui::DragInt("upload budget(KB)", &budgetKB, 16.0f, 16, 64 * 1024))
+                instances->SetUploadBudget((size_t)budgetKB * 1024);
+            if (ImGui::Button("add 1000"))
+            {
+                for (int i = 0; i < 1000; i++)
+                    objGrass->AddInstance(vec4(RandomRange(-5.0f, 5.0f), radians(RandomRange(0.0f, 360.0f)),
+                                               RandomRange(-5.0f, 5.0f), 0.0f));
+                m_grassTrampleGrid->Invalidate();
+            }
+            ImGui::SameLine();
+            if (ImGui::Button("remove 1000"))
+            {
+                for (int i = 0; i < 1000 && instances->GetCount() > 0; i++)
+                    objGrass->RemoveInstance((size_t)rand() % instances->GetCount());
+                m_grassTrampleGrid->Invalidate();
+            }
+        }
 
         if (ImGui::ColorEdit4("clear color", value_ptr(m_clearColor)))
         {
@@ -448,16 +1108,20 @@ void Context::RenderIMGUI()
         ImGui::DragFloat("gamma", &m_gamma, 0.01f, 0.0f, 2.0f);
 
         ImGui::Separator();
-        ImGui::DragFloat3("camera pos", value_ptr(m_camera.Pos), 0.01f);
-        ImGui::DragFloat("camera yaw", &m_camera.Yaw), 0.5f;
-        ImGui::DragFloat("camera pitch", &m_camera.Pitch, 0.5f, -89, 89);
+        bool cameraChanged = false;
+        cameraChanged |= ImGui::DragFloat3("camera pos", value_ptr(m_camera.Pos), 0.01f);
+        cameraChanged |= ImGui::DragFloat("camera yaw", &m_camera.Yaw, 0.5f);
+        cameraChanged |= ImGui::DragFloat("camera pitch", &m_camera.Pitch, 0.5f, -89, 89);
         ImGui::Separator();
         if (ImGui::Button("reset camera"))
         {
             m_camera.Yaw = 0;
             m_camera.Pitch = 0;
             m_camera.Pos = vec3(0, 0, 3);
+            cameraChanged = true;
         }
+        if (cameraChanged)
+            m_cameraEditVersion = m_simulation->SetCamera(m_camera);
     }
 
     float aspectRatio = (float)m_width / m_height;
@@ -469,59 +1133,206 @@ void Context::RenderIMGUI()
     if (ImGui::Begin("G-Buffers"))
     {
         const char *bufferNames[] = {
-            "position",
-            "normal",
+            "normal (octahedral)",
             "albedo/specular",
+            "depth",
         };
         static int bufferSelect = 0;
         ImGui::Combo("buffer", &bufferSelect, bufferNames, 3);
         float width = ImGui::GetContentRegionAvailWidth(); // 화면에 그릴 수 있는 window size
         float height = width * ((float)m_height / (float)m_width);
-        auto selectedAttachment =
-            m_deferGeoFramebuffer->GetColorAttachment(bufferSelect);
+        auto selectedAttachment = bufferSelect < m_deferGeoFramebuffer->GetColorAttachmentCount()
+                                      ? m_deferGeoFramebuffer->GetColorAttachment(bufferSelect)
+                                      : m_deferGeoFramebuffer->GetDepthAttachment();
         ImGui::Image((ImTextureID)selectedAttachment->Get(),
                      ImVec2(width, height), ImVec2(0, 1), ImVec2(1, 0));
     }
     ImGui::End();
 
+    if (m_showOverdraw && m_overdrawViewFramebuffer)
+    {
+        if (ImGui::Begin("Overdraw", &m_showOverdraw))
+        {
+            ImGui::Text("0 black, 1 blue, 2 green, 3 yellow, 4 red, 5+ white");
+            float width = ImGui::GetContentRegionAvailWidth();
+            float height = width * ((float)m_height / (float)m_width);
+            ImGui::Image((ImTextureID)m_overdrawViewFramebuffer->GetColorAttachment()->Get(),
+                         ImVec2(width, height), ImVec2(0, 1), ImVec2(1, 0));
+        }
+        ImGui::End();
+    }
+
     if (ImGui::Begin("SSAO"))
     {
-        const char *bufferNames[] = {"original", "blurred"};
+        const char *bufferNames[] = {"original", "blurred", "upsampled"};
         static int bufferSelect = 0;
-        ImGui::Combo("buffer", &bufferSelect, bufferNames, 2);
+        ImGui::Combo("buffer", &bufferSelect, bufferNames, 3);
 
         float width = ImGui::GetContentRegionAvailWidth();
         float height = width * ((float)m_height / (float)m_width);
-        auto selectedAttachment = bufferSelect == 0 ? m_ssaoFramebuffer->GetColorAttachment() : m_ssaoBlurFramebuffer->GetColorAttachment();
+        auto selectedAttachment = bufferSelect == 0 ? m_ssaoFramebuffer->GetColorAttachment()
+                                  : bufferSelect == 1 ? m_ssaoBlurFramebuffer->GetColorAttachment()
+                                                      : GetAmbientOcclusion();
 
+        // original은 (AO, depth)이므로 red 채널만 표시
+        ImVec4 tint = bufferSelect == 0 ? ImVec4(1, 0, 0, 1) : ImVec4(1, 1, 1, 1);
         ImGui::Image((ImTextureID)selectedAttachment->Get(),
-                     ImVec2(width, height), ImVec2(0, 1), ImVec2(1, 0));
+                     ImVec2(width, height), ImVec2(0, 1), ImVec2(1, 0), tint);
     }
     ImGui::End();
+
+    if (ImGui::Begin("Render Stats"))
+        RenderStatsIMGUI();
+    ImGui::End();
 }
 
-void Context::ProcessInput(GLFWwindow *window)
+void Context::RenderStatsIMGUI()
 {
-    if (!m_camera.Control)
-        return;
+    auto &frame = RenderStats::GetLastFrame();
+    auto &memory = RenderStats::GetMemory();
+    const float MB = 1024.0f * 1024.0f;
+
+    auto &history = RenderStats::GetDrawCallHistory();
+    if (!history.empty())
+    {
+        ImGui::PlotLines("draw calls", history.data(), (int)history.size(), 0, nullptr,
+                         0.0f, FLT_MAX, ImVec2(0, 40));
+    }
 
-    const float cameraSpeed = 0.05f;
-    if (glfwGetKey(window, GLFW_KEY_W) == GLFW_PRESS)
-        m_camera.Pos += cameraSpeed * m_camera.Front;
-    if (glfwGetKey(window, GLFW_KEY_S) == GLFW_PRESS)
-        m_camera.Pos -= cameraSpeed * m_camera.Front;
+    ImGui::Text("draw calls: %d (instanced %d)", frame.drawCalls, frame.instancedDrawCalls);
+    ImGui::Text("triangles: %llu", (unsigned long long)frame.triangles);
+    ImGui::Text("instances: %llu", (unsigned long long)frame.instances);
+    ImGui::Text("binds: program %d, texture %d, vao %d, framebuffer %d",
+                frame.programBinds, frame.textureBinds, frame.vertexArrayBinds, frame.framebufferBinds);
+    ImGui::Text("clears: %d", frame.clears);
+    ImGui::Text("buffer uploads: %d (%.2f MB)", frame.bufferUploads, frame.bufferUploadBytes / MB);
+    ImGui::Text("stream fence wait: %.3f ms", frame.fenceWaitMs);
+    ImGui::Separator();
+    ImGui::Text("buffers: %d (%.2f MB)", memory.bufferCount, memory.bufferBytes / MB);
+    ImGui::Text("textures: %d (%.2f MB)", memory.textureCount, memory.textureBytes / MB);
+    ImGui::Text("framebuffers: %d (depth/stencil %.2f MB)", memory.framebufferCount, memory.renderbufferBytes / MB);
+    ImGui::Text("total: %.2f MB", memory.GetTotalBytes() / MB);
+    ImGui::Separator();
+    auto &cacheStats = Program::GetCacheStats();
+    ImGui::Text("shader init: %.1f ms (binary cache hits %d, misses %d)",
+                m_shaderInitTime, cacheStats.hits, cacheStats.misses);
+}
 
-    auto cameraRight = normalize(cross(m_camera.Up, -m_camera.Front));
-    if (glfwGetKey(window, GLFW_KEY_D) == GLFW_PRESS)
-        m_camera.Pos += cameraSpeed * cameraRight;
-    if (glfwGetKey(window, GLFW_KEY_A) == GLFW_PRESS)
-        m_camera.Pos -= cameraSpeed * cameraRight;
+void Context::RenderProfilerIMGUI()
+{
+    bool enabled = m_profiler->IsEnabled();
+    if (ImGui::Checkbox("enable", &enabled))
+        m_profiler->SetEnabled(enabled);
+    ImGui::SameLine();
+    ImGui::Checkbox("pause", &m_profilerPause);
+    ImGui::SameLine();
+    if (ImGui::Button("export trace"))
+        m_profiler->ExportChromeTrace("./profile.json");
+    ImGui::SameLine();
+    // 다음 프레임의 GL 명령을 저장. ComputerGraphics --replay ./frame.glcap 로 재생
+    if (ImGui::Button("capture frame"))
+        FrameCapture::Request("./frame.glcap");
+
+    auto &history = m_profiler->GetHistory();
+    if (history.empty())
+        return;
+    if (!m_profilerPause)
+        m_profilerFrame = history.back();
+    auto &frame = m_profilerFrame;
+
+    // 최상위 구간의 CPU/GPU 평균 (history 전체)
+    ImGui::Text("frame %d: cpu %.3f ms", (int)frame.index, frame.cpuTime);
+    ImGui::Columns(3, "profiler", false);
+    ImGui::Text("pass");
+    ImGui::NextColumn();
+    ImGui::Text("cpu ms (avg)");
+    ImGui::NextColumn();
+    ImGui::Text("gpu ms (avg)");
+    ImGui::NextColumn();
+    for (auto &sample : frame.samples)
+    {
+        double cpuSum = 0.0, gpuSum = 0.0;
+        int count = 0;
+        for (auto &past : history)
+        {
+            for (auto &pastSample : past.samples)
+            {
+                if (strcmp(pastSample.name, sample.name) != 0)
+                    continue;
+                cpuSum += pastSample.cpuEnd - pastSample.cpuStart;
+                gpuSum += pastSample.gpuTime;
+                count++;
+                break;
+            }
+        }
+        ImGui::Text("%*s%s", (int)sample.depth * 2, "", sample.name);
+        ImGui::NextColumn();
+        ImGui::Text("%.3f (%.3f)", sample.cpuEnd - sample.cpuStart, count ? cpuSum / count : 0.0);
+        ImGui::NextColumn();
+        if (sample.gpuTime >= 0.0)
+            ImGui::Text("%.3f (%.3f)", sample.gpuTime, count ? gpuSum / count : 0.0);
+        else
+            ImGui::Text("-");
+        ImGui::NextColumn();
+    }
+    ImGui::Columns(1);
+
+    // timeline : 위쪽은 CPU 구간(깊이별 한 줄), 마지막 줄은 GPU 구간을 제출 순서대로 이어 붙임
+    uint32_t maxDepth = 0;
+    for (auto &sample : frame.samples)
+        maxDepth = glm::max(maxDepth, sample.depth);
+    const float rowHeight = 18.0f;
+    float width = ImGui::GetContentRegionAvailWidth();
+    float height = rowHeight * (maxDepth + 2);
+    double gpuTotal = 0.0;
+    for (auto &sample : frame.samples)
+        gpuTotal += glm::max(sample.gpuTime, 0.0);
+    double scale = width / glm::max(glm::max(frame.cpuTime, gpuTotal), 0.001);
+
+    auto drawList = ImGui::GetWindowDrawList();
+    ImVec2 origin = ImGui::GetCursorScreenPos();
+    drawList->AddRectFilled(origin, ImVec2(origin.x + width, origin.y + height), IM_COL32(30, 30, 30, 255));
+
+    auto drawBar = [&](const char *name, double start, double duration, float row, ImU32 color)
+    {
+        ImVec2 min(origin.x + (float)(start * scale), origin.y + row * rowHeight);
+        ImVec2 max(min.x + glm::max((float)(duration * scale), 1.0f), min.y + rowHeight - 1.0f);
+        drawList->AddRectFilled(min, max, color);
+        drawList->PushClipRect(min, max, true);
+        drawList->AddText(ImVec2(min.x + 2.0f, min.y + 2.0f), IM_COL32(255, 255, 255, 255), name);
+        drawList->PopClipRect();
+        if (ImGui::IsMouseHoveringRect(min, max))
+            ImGui::SetTooltip("%s : %.3f ms", name, duration);
+    };
+
+    double gpuCursor = 0.0;
+    for (auto &sample : frame.samples)
+    {
+        // 이름별로 색을 고정
+        ImU32 hash = (ImU32)std::hash<std::string>()(sample.name);
+        ImU32 color = IM_COL32(80 + hash % 120, 80 + (hash >> 8) % 120, 80 + (hash >> 16) % 120, 255);
+        drawBar(sample.name, sample.cpuStart, sample.cpuEnd - sample.cpuStart, (float)sample.depth, color);
+        if (sample.gpuTime >= 0.0)
+        {
+            drawBar(sample.name, gpuCursor, sample.gpuTime, (float)(maxDepth + 1), color);
+            gpuCursor += sample.gpuTime;
+        }
+    }
+    ImGui::Dummy(ImVec2(width, height));
+    ImGui::Text("rows: cpu (by depth) / gpu");
+}
 
-    auto cameraUp = normalize(cross(-m_camera.Front, cameraRight));
-    if (glfwGetKey(window, GLFW_KEY_E) == GLFW_PRESS)
-        m_camera.Pos += cameraSpeed * cameraUp;
-    if (glfwGetKey(window, GLFW_KEY_Q) == GLFW_PRESS)
-        m_camera.Pos -= cameraSpeed * cameraUp;
+void Context::ProcessInput(GLFWwindow *window)
+{
+    // 키 상태만 기록하고 카메라 이동은 simulation tick에서 처리
+    m_input.forward = glfwGetKey(window, GLFW_KEY_W) == GLFW_PRESS;
+    m_input.backward = glfwGetKey(window, GLFW_KEY_S) == GLFW_PRESS;
+    m_input.right = glfwGetKey(window, GLFW_KEY_D) == GLFW_PRESS;
+    m_input.left = glfwGetKey(window, GLFW_KEY_A) == GLFW_PRESS;
+    m_input.up = glfwGetKey(window, GLFW_KEY_E) == GLFW_PRESS;
+    m_input.down = glfwGetKey(window, GLFW_KEY_Q) == GLFW_PRESS;
+    m_simulation->SetInput(m_input);
+    m_input.mouseDelta = vec2(0.0f);
 }
 
 void Context::Reshape(int width, int height)
@@ -534,44 +1345,104 @@ void Context::Reshape(int width, int height)
         Texture::Create(width, height, GL_RGBA),
     });
 
-    m_deferGeoFramebuffer = Framebuffer::Create({
-        Texture::Create(width, height, GL_RGBA16F, GL_FLOAT),      // position
-        Texture::Create(width, height, GL_RGBA16F, GL_FLOAT),      // normal
-        Texture::Create(width, height, GL_RGBA, GL_UNSIGNED_BYTE), // albedo
-    });
+    // compact G-buffer (픽셀당 12 byte) : position은 depth에서 복원
+    // depth는 기본 framebuffer로 blit 하므로 같은 GL_DEPTH24_STENCIL8 형식 사용
+    auto depthTexture = TexturePtr(Texture::Create(width, height, GL_DEPTH24_STENCIL8, GL_UNSIGNED_INT_24_8));
+    depthTexture->SetFilter(GL_NEAREST, GL_NEAREST);
+    m_deferGeoFramebuffer = Framebuffer::Create(
+        {
+            Texture::Create(width, height, GL_RG16, GL_UNSIGNED_SHORT), // normal (octahedral)
+            Texture::Create(width, height, GL_RGBA, GL_UNSIGNED_BYTE),  // albedo, specular
+        },
+        depthTexture);
 
-    m_ssaoFramebuffer = Framebuffer::Create({
-        Texture::Create(width, height, GL_RED),
-    });
+    CreateSsaoFramebuffers();
 
-    m_ssaoBlurFramebuffer = Framebuffer::Create({
+    // overdraw 시각화용은 켜져 있을 때 다시 만듦
+    m_overdrawFramebuffer = nullptr;
+    m_overdrawViewFramebuffer = nullptr;
+}
+void Context::CreateSsaoFramebuffers()
+{
+    int downsample = GetSsaoDownsample();
+    int width = glm::max(m_width / downsample, 1);
+    int height = glm::max(m_height / downsample, 1);
+
+    // linear depth는 보간하면 경계에서 없는 깊이가 생기므로 nearest
+    auto linearDepth = TexturePtr(Texture::Create(width, height, GL_R32F, GL_FLOAT));
+    m_ssaoDepthFramebuffer = Framebuffer::CreateColorOnly({linearDepth});
+
+    // Horizon 모드에서 먼 step은 낮은 해상도 mip에서 읽음. glGenerateMipmap은 level 저장 공간 할당용
+    int mipCount = glm::min(SSAO_DEPTH_MIP_COUNT, (int)floorf(log2f((float)glm::max(width, height))) + 1);
+    linearDepth->Bind();
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAX_LEVEL, mipCount - 1);
+    glGenerateMipmap(GL_TEXTURE_2D);
+    linearDepth->SetFilter(GL_NEAREST_MIPMAP_NEAREST, GL_NEAREST);
+    m_ssaoDepthMipFramebuffers.clear();
+    for (int level = 1; level < mipCount; level++)
+        m_ssaoDepthMipFramebuffers.push_back(Framebuffer::CreateColorOnly({linearDepth}, level));
+
+    // bilateral blur가 AO와 깊이를 한 번에 읽도록 (AO, linear depth)를 같이 저장
+    // separable blur는 bilinear filter로 두 texel씩 묶어 읽으므로 GL_LINEAR 유지
+    m_ssaoFramebuffer = Framebuffer::CreateColorOnly({
+        Texture::Create(width, height, GL_RG16F, GL_FLOAT),
+    });
+    m_ssaoBlurTempFramebuffer = Framebuffer::CreateColorOnly({
+        Texture::Create(width, height, GL_RG16F, GL_FLOAT),
+    });
+    // 재투영 위치는 texel 사이에 걸리므로 GL_LINEAR로 읽음
+    m_ssaoHistory = HistoryBuffer::Create(width, height, GL_RG16F, GL_FLOAT);
+    auto noiseScale = vec2((float)width / (float)m_ssaoNoiseTexture->GetWidth(),
+                           (float)height / (float)m_ssaoNoiseTexture->GetHeight());
+    ssaoMaterial->SetStaticProperty("noiseScale", noiseScale);
+    gtaoMaterial->SetStaticProperty("noiseScale", noiseScale);
+
+    m_ssaoBlurFramebuffer = Framebuffer::CreateColorOnly({
         Texture::Create(width, height, GL_RED),
     });
+
+    m_ssaoUpsampleFramebuffer = nullptr;
+    if (downsample > 1)
+    {
+        m_ssaoUpsampleFramebuffer = Framebuffer::CreateColorOnly({
+            Texture::Create(m_width, m_height, GL_RED),
+        });
+    }
 }
-void Context::MouseMove(double x, double y)
-{
-    if (!m_camera.Control)
-        return;
 
-    static vec2 prevPos = vec2((float)x, (float)y);
-    auto pos = vec2((float)x, (float)y);
-    auto deltaPos = pos - prevPos;
+void Context::BuildSsaoDepthMips()
+{
+    // 그리는 level이 읽는 범위(base ~ max level)에 들어가지 않도록 base, max level을 이전 level로 제한
+    auto linearDepth = m_ssaoDepthFramebuffer->GetColorAttachment();
+    int maxLevel = (int)m_ssaoDepthMipFramebuffers.size();
+    for (int level = 1; level <= maxLevel; level++)
+    {
+        linearDepth->Bind();
+        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_BASE_LEVEL, level - 1);
+        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAX_LEVEL, level - 1);
 
-    const float cameraRotSpeed = 0.5f;
-    m_camera.Yaw -= deltaPos.x * cameraRotSpeed;
-    m_camera.Pitch -= deltaPos.y * cameraRotSpeed;
+        m_ssaoDepthMipFramebuffers[level - 1]->Bind();
+        glViewport(0, 0, glm::max(linearDepth->GetWidth() >> level, 1), glm::max(linearDepth->GetHeight() >> level, 1));
+        objSSAODepthMipPlane->Render(linearDepth);
+    }
+    linearDepth->Bind();
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_BASE_LEVEL, 0);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAX_LEVEL, maxLevel);
+}
 
-    if (m_camera.Yaw < 0.0f)
-        m_camera.Yaw += 360.0f;
-    if (m_camera.Yaw > 360.0f)
-        m_camera.Yaw -= 360.0f;
+TexturePtr Context::GetAmbientOcclusion() const
+{
+    return (m_ssaoUpsampleFramebuffer ? m_ssaoUpsampleFramebuffer : m_ssaoBlurFramebuffer)->GetColorAttachment();
+}
 
-    if (m_camera.Pitch > 89.0f)
-        m_camera.Pitch = 89.0f;
-    if (m_camera.Pitch < -89.0f)
-        m_camera.Pitch = -89.0f;
+void Context::MouseMove(double x, double y)
+{
+    if (!m_input.control)
+        return;
 
-    prevPos = pos;
+    auto pos = vec2((float)x, (float)y);
+    m_input.mouseDelta += pos - m_prevMousePos;
+    m_prevMousePos = pos;
 }
 
 void Context::MouseButton(int button, int action, double x, double y)
@@ -582,11 +1453,11 @@ void Context::MouseButton(int button, int action, double x, double y)
         {
             // 마우스 조작 시작 시점에 현재 마우스 커서 위치 저장
             m_prevMousePos = vec2((float)x, (float)y);
-            m_camera.Control = true;
+            m_input.control = true;
         }
         else if (action == GLFW_RELEASE)
         {
-            m_camera.Control = false;
+            m_input.control = false;
         }
     }
 }
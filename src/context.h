@@ -10,41 +10,66 @@
 #include "model.h"
 #include "framebuffer.h"
 #include "object.h"
+#include "grasstrample.h"
 #include "shadowmap.h"
+#include "scene.h"
+#include "renderqueue.h"
+#include "jobsystem.h"
+#include "simulation.h"
+#include "profiler.h"
+#include "lightcluster.h"
 
 using namespace glm;
 using namespace std;
 
-struct Camera
+// deferred 조명 방식
+enum class DeferredLightingMode
 {
-public:
-    mat4 projection;
-    mat4 view;
-    vec3 Pos{vec3(0.0f, 2.0f, 12.0f)};
-    float Pitch{0.0f};
-    float Yaw{0.0f};
-    vec3 Front{vec3(0.0f, 0.0f, -1.0f)};
-    vec3 Up{vec3(0.0f, 1.0f, 0.0f)};
-    bool Control{false};
+    FullScreen,  // 모든 픽셀에서 모든 광원을 계산
+    Clustered,   // 픽셀이 속한 cluster의 광원만 계산 (LightCluster)
+    LightVolume, // 광원마다 반경 크기의 구를 그려서 구가 덮은 픽셀만 계산
+};
+
+// SSAO 계산 해상도. 전체 해상도가 아니면 깊이를 고려해서 키움(bilateral upsampling)
+enum class SsaoResolution
+{
+    Full,
+    Half,
+    Quarter,
+};
+
+// AO 계산 방식
+enum class SsaoMode
+{
+    Hemisphere, // 반구 안의 무작위 샘플 64개를 투영해서 깊이 비교 (ssao.fs)
+    Horizon,    // 방향마다 horizon을 찾아 보이는 각도를 적분 (GTAO, gtao.fs). 샘플 16개
 };
 
-struct Light
+// SSAO blur 방식
+enum class SsaoBlur
 {
-    bool directional{false};
-    vec3 position{vec3(2.0f, 4.0f, 4.0f)};
-    vec3 direction{vec3(-0.5f, -1.5f, -1.0f)};
-    // inner cut-off angle, offset angle
-    vec2 cutoff{vec2(50.0f, 5.0f)};
-    float distance{150.0f};
-    vec3 ambient{vec3(0.8f, 0.8f, 0.8f)};
-    vec3 diffuse{vec3(0.5f, 0.5f, 0.5f)};
-    vec3 specular{vec3(1.0f, 1.0f, 1.0f)};
+    Box,       // 5x5 box filter (25번 읽음)
+    Gaussian,  // 가로, 세로 9-tap gaussian (pass당 5번 읽음)
+    Bilateral, // Gaussian에 깊이 차이 가중치를 곱해서 경계를 보존
 };
 
-struct DeferLight
+// 장면 구성. 기본값은 원래 장면이고 benchmark에서 개수를 바꿔서 사용
+struct SceneOption
 {
-    glm::vec3 position;
-    glm::vec3 color;
+    uint32_t seed{1};      // RandomRange 시드. 같은 값이면 항상 같은 장면
+    int boxCount{0};       // 바닥 위에 추가로 놓는 박스 (forward, shadow caster)
+    int grassCount{10000}; // 풀 인스턴스
+    int lightCount{32};    // deferred 광원
+    float lightRange{13.0f};       // deferred 광원의 감쇠 거리 (GetAttenuationCoeff)
+    DeferredLightingMode lightingMode{DeferredLightingMode::Clustered};
+    int modelCount{1};     // backpack 모델 복사본
+    bool depthPrepass{false};      // G-buffer pass 전에 depth만 먼저 그림
+    SsaoResolution ssaoResolution{SsaoResolution::Half};
+    SsaoBlur ssaoBlur{SsaoBlur::Bilateral};
+    SsaoMode ssaoMode{SsaoMode::Hemisphere};
+    bool ssaoTemporal{false};      // 프레임마다 일부 샘플만 계산하고 history에 누적
+    bool directionalLight{false};  // forward 광원을 directional light로 시작
+    int shadowCascades{3};         // directional light의 cascade 수 (0이면 고정 범위 shadow map 하나)
 };
 
 CLASS_PTR(Context)
@@ -54,29 +79,51 @@ public:
     Context();
     ~Context();
 
-    static ContextUPtr Create();
-    void Render();
+    static ContextUPtr Create(const SceneOption &option = SceneOption());
+    void Render(const Timer &timer);
     void RenderIMGUI();
+    void RenderProfilerIMGUI();
+    void RenderStatsIMGUI();
     void ProcessInput(GLFWwindow *window);
     void Reshape(int width, int height);
     void MouseMove(double x, double y);
     void MouseButton(int button, int action, double x, double y);
 
+    // headless 실행 등 외부에서 제어할 때 사용
+    void SetUIEnabled(bool enabled) { m_uiEnabled = enabled; }
+    void SetCamera(const Camera &camera);
+    void SetSimulationThread(bool threaded);
+    const Profiler *GetProfiler() const { return m_profiler.get(); }
+    float GetShaderInitTime() const { return m_shaderInitTime; }
+    // 조명 pass가 사용하는 전체 해상도 AO (GL_RED)
+    TexturePtr GetAmbientOcclusion() const;
+
 private:
-    bool Init();
+    bool Init(const SceneOption &option);
     void InitShader();
     void InitMaterial();
     void InitObject();
     void InitParameters();
+    std::vector<ImagePtr> LoadImages(const std::vector<std::string> &filenames, bool flipVertical = true);
 
     void UpdateLight(mat4 &projection, mat4 &view);
+    void UpdateSimulation();
     void UpdateCamera();
-    void DrawShadowedObjects(const mat4 &view, const mat4 &projection,
-                             const MaterialPtr &optionMat = nullptr);
-    void DrawShadowedObjects(const Camera &cam,
+    void UpdateGrass();
+    void GetLightTransform(mat4 &view, mat4 &projection) const;
+    bool UseCascadedShadow() const { return m_light.directional && m_cascadedShadowMap; }
+    void SetShadowCascadeCount(int count);
+    void DrawDeferredGeometry(const MaterialPtr &positionOnlyMat = nullptr);
+    void RenderOverdraw();
+    void CreateSsaoFramebuffers();
+    void BuildSsaoDepthMips();
+    int GetSsaoDownsample() const { return 1 << (int)m_ssaoResolution; }
+    void BuildRenderQueues();
+    void DrawShadowedObjects(const RenderQueue &queue, const mat4 &view, const mat4 &projection,
                              const MaterialPtr &optionMat = nullptr);
 
     void GenerateShadowMap();
+    void RenderShadowedObjects();
     void RenderDeffered();
 
 private:
@@ -101,17 +148,50 @@ private:
     ProgramPtr m_grassProgram;
 
     // shadow map
-    ShadowMapUPtr m_shadowMap;
+    ShadowMapUPtr m_shadowMap;                   // spot light, cascade를 쓰지 않는 directional light
+    CascadedShadowMapUPtr m_cascadedShadowMap;   // directional light. cascade 수가 0이면 nullptr
+    ProgramPtr m_shadowCascadeProgram;
+    int m_shadowCascadeCount{3};
+    float m_shadowSplitLambda{0.75f}; // 0 : 균등 분할, 1 : 로그 분할
+    float m_shadowDistance{30.0f};    // 카메라에서 이 거리까지만 그림자를 그림
 
     // deferred shading
     FramebufferPtr m_deferGeoFramebuffer;
     ProgramPtr m_deferGeoProgram;
     ProgramPtr m_deferLightProgram;
+    ProgramPtr m_lightVolumeProgram;
+    ProgramPtr m_depthOnlyProgram;
+    bool m_depthPrepass{false};
+
+    // overdraw 시각화 : G-buffer pass와 같은 depth 상태로 fragment 수를 세서 heat map으로 표시
+    ProgramPtr m_overdrawProgram;
+    ProgramPtr m_overdrawViewProgram;
+    FramebufferPtr m_overdrawFramebuffer;     // R16F, fragment 수
+    FramebufferPtr m_overdrawViewFramebuffer; // heat map
+    bool m_showOverdraw{false};
+    float m_overdrawAverage{0.0f}; // 화면 픽셀당 평균 fragment 수
 
     // ssao
-    FramebufferPtr m_ssaoFramebuffer;
+    FramebufferPtr m_ssaoDepthFramebuffer;    // SSAO 해상도 linear depth (R32F)
+    std::vector<FramebufferPtr> m_ssaoDepthMipFramebuffers; // linear depth의 level 1부터 (Horizon 모드)
+    FramebufferPtr m_ssaoFramebuffer;         // (AO, linear depth) RG16F
+    FramebufferPtr m_ssaoBlurTempFramebuffer; // separable blur 가로 pass 결과 (RG16F)
+    FramebufferPtr m_ssaoUpsampleFramebuffer; // 전체 해상도 결과. SSAO 해상도가 Full이면 nullptr
+    HistoryBufferUPtr m_ssaoHistory;          // temporal 누적 결과 (AO, linear depth) RG16F
     ProgramPtr m_ssaoProgram;
+    ProgramPtr m_ssaoDepthProgram;
+    ProgramPtr m_ssaoDepthMipProgram;
+    ProgramPtr m_gtaoProgram;
+    ProgramPtr m_ssaoTemporalProgram;
+    ProgramPtr m_ssaoUpsampleProgram;
+    SsaoResolution m_ssaoResolution{SsaoResolution::Half};
+    SsaoBlur m_ssaoBlur{SsaoBlur::Bilateral};
+    SsaoMode m_ssaoMode{SsaoMode::Hemisphere};
+    bool m_ssaoTemporal{false};
+    uint32_t m_ssaoFrame{0};        // temporal 누적에서 kernel 부분과 노이즈를 고르는 번호
+    mat4 m_ssaoPrevViewProjection{1.0f};
     ModelUPtr m_model; // for test rendering
+    std::vector<Transform> m_modelTransforms;
     TexturePtr m_ssaoNoiseTexture;
 
     std::vector<glm::vec3> m_ssaoSamples;
@@ -120,6 +200,8 @@ private:
 
 
     ProgramPtr m_blurProgram;
+    ProgramPtr m_separableBlurProgram;
+    ProgramPtr m_bilateralBlurProgram;
     FramebufferPtr m_ssaoBlurFramebuffer;
 
 private:
@@ -129,6 +211,7 @@ private:
     MaterialPtr m_box2Material;
     MaterialPtr modelMaterial;
     MaterialPtr shadowmapMaterial;
+    MaterialPtr shadowCascadeMaterial;
     NormalMapMaterialPtr m_wallMaterial;
     TextureMaterialPtr m_grassMaterial;
     CubemapMaterialPtr m_cubeMapMaterial;
@@ -137,27 +220,64 @@ private:
     MaterialPtr deferredGeoBoxMaterial;
     MaterialPtr deferredGeoGroundMaterial;
     MaterialPtr deferredLightMaterial;
+    MaterialPtr lightVolumeMaterial;
+    MaterialPtr depthOnlyMaterial;
+    MaterialPtr overdrawMaterial;
+    MaterialPtr overdrawViewMaterial;
     MaterialPtr ssaoMaterial;
     MaterialPtr ssaoBlurMaterial;
+    MaterialPtr separableBlurMaterial;
+    MaterialPtr bilateralBlurMaterial;
+    MaterialPtr ssaoDepthMaterial;
+    MaterialPtr ssaoDepthMipMaterial;
+    MaterialPtr gtaoMaterial;
+    MaterialPtr ssaoTemporalMaterial;
+    MaterialPtr ssaoUpsampleMaterial;
 
     vector<DeferLight> m_deferLights;
+    LightClusterUPtr m_lightCluster;
+    DeferredLightingMode m_lightingMode{DeferredLightingMode::Clustered};
 
 private:
+    SceneOption m_sceneOption;
+
+    // 일반 오브젝트(바닥, 박스, 반투명 평면 등)는 scene에서 관리
+    SceneUPtr m_scene;
+
+    // pass별 draw packet. worker 스레드에서 만들고 GL 스레드에서 재생
+    JobSystemUPtr m_jobSystem;
+    RenderQueueUPtr m_shadowDepthQueue;
+    RenderQueueUPtr m_shadowedQueue;
+    RenderQueueUPtr m_deferredQueue;
+    RenderQueueUPtr m_transparentQueue;
+    std::vector<SceneChunk *> m_renderChunks;
+    bool m_parallelRecord{true};
+    float m_recordTime{0.0f}; // ms
+
+    ProfilerUPtr m_profiler;
+    ProfileFrame m_profilerFrame; // UI에 표시 중인 프레임
+    bool m_profilerPause{false};
+    bool m_uiEnabled{true};
+    float m_shaderInitTime{0.0f}; // ms, InitShader에 걸린 시간
+
     ObjectUPtr objSkybox;
-    ObjectUPtr objGround;
-    ObjectUPtr objBox1;
     StencilBoxUPtr stencilBox;
-    ObjectUPtr objPlane1;
-    ObjectUPtr objPlane2;
-    ObjectUPtr objPlane3;
     CubemapUPtr objCubemap;
     ObjectUPtr objGrass;
+    GrassTrampleUPtr m_grassTrampleGrid;
     WallUPtr objWall;
     DeferredPlanePtr objDeferredPlane;
-    ObjectUPtr objDeferredGround;
-    ObjectUPtr objDeferredBox;
+    LightVolumesUPtr objLightVolumes;
     SSAOPlaneUPtr objSSAOPlane;
+    SSAODepthPlaneUPtr objSSAODepthPlane;
+    SSAODepthMipPlaneUPtr objSSAODepthMipPlane;
+    SSAOPlaneUPtr objGTAOPlane;
+    SSAOTemporalPlaneUPtr objSSAOTemporalPlane;
+    SSAOUpsamplePlaneUPtr objSSAOUpsamplePlane;
     BlurPlaneUPtr objBlurPlane;
+    BlurPlaneUPtr objSeparableBlurPlane;
+    BlurPlaneUPtr objBilateralBlurPlane;
+    BlurPlaneUPtr objOverdrawPlane;
 
 private:
     // 창 크기
@@ -165,13 +285,23 @@ private:
     int m_height{480};
 
 private:
+    // 카메라, 광원, 애니메이션은 simulation이 갱신하고 렌더 스레드는 snapshot을 복사해서 사용
+    SimulationUPtr m_simulation;
+    bool m_simulationThread{true};
+    // 마지막으로 보낸 SetCamera/SetLight 번호. snapshot에 반영되기 전까지는 UI 값을 유지
+    uint64_t m_cameraEditVersion{0};
+    uint64_t m_lightEditVersion{0};
+    InputState m_input;
     Camera m_camera;
+    float m_frameTime{0.0f}; // 마지막 프레임 간격(초)
+    float m_time{0.0f};      // 시작 후 경과 시간(초)
 
 private:
     vec2 m_prevMousePos{vec2(0.0f)};
 
     // animation
     bool m_animation{true};
+    bool m_grassTrample{true};
 
     // clear color
     vec4 m_clearColor{vec4(0.1f, 0.2f, 0.3f, 0.0f)};
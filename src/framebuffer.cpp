@@ -1,9 +1,20 @@
 #include "framebuffer.h"
+#include "capture.h"
+#include "renderstats.h"
 
-FramebufferUPtr Framebuffer::Create(const std::vector<TexturePtr> &colorAttachments)
+FramebufferUPtr Framebuffer::Create(const std::vector<TexturePtr> &colorAttachments,
+                                    const TexturePtr &depthAttachment, int level)
 {
     auto framebuffer = FramebufferUPtr(new Framebuffer());
-    if (!framebuffer->InitWithColorAttachments(colorAttachments))
+    if (!framebuffer->InitWithColorAttachments(colorAttachments, depthAttachment, level))
+        return nullptr;
+    return std::move(framebuffer);
+}
+
+FramebufferUPtr Framebuffer::CreateColorOnly(const std::vector<TexturePtr> &colorAttachments, int level)
+{
+    auto framebuffer = FramebufferUPtr(new Framebuffer());
+    if (!framebuffer->InitWithColorAttachments(colorAttachments, nullptr, level, false))
         return nullptr;
     return std::move(framebuffer);
 }
@@ -13,26 +24,67 @@ Framebuffer::~Framebuffer()
     if (m_depthStencilBuffer)
     {
         glDeleteRenderbuffers(1, &m_depthStencilBuffer);
+        auto &texture = m_colorAttachments[0];
+        RenderStats::TrackFramebuffer(-1, -(int64_t)RenderStats::GetTextureSize(
+                                              GL_DEPTH24_STENCIL8, glm::max(texture->GetWidth() >> m_level, 1),
+                                              glm::max(texture->GetHeight() >> m_level, 1)));
     }
     if (m_framebuffer)
     {
         glDeleteFramebuffers(1, &m_framebuffer);
+        // 깊이 텍스처의 메모리는 Texture에서 계산하므로 개수만 뺌 (color only도 마찬가지)
+        if (!m_depthStencilBuffer)
+            RenderStats::TrackFramebuffer(-1, 0);
     }
 }
 
+static FramebufferPtr s_defaultFramebuffer;
+
 void Framebuffer::BindToDefault()
 {
-    glBindFramebuffer(GL_FRAMEBUFFER, 0);
+    glBindFramebuffer(GL_FRAMEBUFFER, GetDefault());
+    FrameCapture::RecordBindFramebuffer(0);
+    RenderStats::AddFramebufferBind();
+}
+
+void Framebuffer::SetDefault(const FramebufferPtr &framebuffer)
+{
+    s_defaultFramebuffer = framebuffer;
+}
+
+uint32_t Framebuffer::GetDefault()
+{
+    return s_defaultFramebuffer ? s_defaultFramebuffer->Get() : 0;
+}
+
+void Framebuffer::Clear(uint32_t mask)
+{
+    FrameCapture::RecordClear(mask);
+    RenderStats::AddClear();
+    glClear(mask);
 }
 
 void Framebuffer::Bind() const
 {
     glBindFramebuffer(GL_FRAMEBUFFER, m_framebuffer);
+    FrameCapture::RecordBindFramebuffer(m_framebuffer);
+    RenderStats::AddFramebufferBind();
 }
 
-bool Framebuffer::InitWithColorAttachments(const std::vector<TexturePtr> &colorAttachments)
+void Framebuffer::BlitToDefault(int width, int height, uint32_t mask, uint32_t filter) const
+{
+    glBindFramebuffer(GL_READ_FRAMEBUFFER, m_framebuffer);
+    glBindFramebuffer(GL_DRAW_FRAMEBUFFER, GetDefault());
+    FrameCapture::RecordBlit(m_framebuffer, 0, 0, 0, width, height, 0, 0, width, height, mask, filter);
+    glBlitFramebuffer(0, 0, width, height, 0, 0, width, height, mask, filter);
+}
+
+bool Framebuffer::InitWithColorAttachments(const std::vector<TexturePtr> &colorAttachments,
+                                           const TexturePtr &depthAttachment, int level, bool useDepth)
 {
     m_colorAttachments = colorAttachments;
+    m_depthAttachment = depthAttachment;
+    m_level = level;
     glGenFramebuffers(1, &m_framebuffer);
     glBindFramebuffer(GL_FRAMEBUFFER, m_framebuffer);
 
@@ -40,7 +92,7 @@ bool Framebuffer::InitWithColorAttachments(const std::vector<TexturePtr> &colorA
     {
         glFramebufferTexture2D(GL_FRAMEBUFFER,
                                GL_COLOR_ATTACHMENT0 + i, GL_TEXTURE_2D,
-                               m_colorAttachments[i]->Get(), 0);
+                               m_colorAttachments[i]->Get(), level);
     }
 
     if (m_colorAttachments.size() > 0)
@@ -52,17 +104,31 @@ bool Framebuffer::InitWithColorAttachments(const std::vector<TexturePtr> &colorA
         glDrawBuffers(m_colorAttachments.size(), attachments.data());
     }
 
-    int width = m_colorAttachments[0]->GetWidth();
-    int height = m_colorAttachments[0]->GetHeight();
+    if (m_depthAttachment)
+    {
+        glFramebufferTexture2D(GL_FRAMEBUFFER, GL_DEPTH_STENCIL_ATTACHMENT, GL_TEXTURE_2D,
+                               m_depthAttachment->Get(), 0);
+        RenderStats::TrackFramebuffer(1, 0);
+    }
+    else if (!useDepth)
+    {
+        RenderStats::TrackFramebuffer(1, 0);
+    }
+    else
+    {
+        int width = glm::max(m_colorAttachments[0]->GetWidth() >> level, 1);
+        int height = glm::max(m_colorAttachments[0]->GetHeight() >> level, 1);
 
-    glGenRenderbuffers(1, &m_depthStencilBuffer);
-    glBindRenderbuffer(GL_RENDERBUFFER, m_depthStencilBuffer);
-    glRenderbufferStorage(GL_RENDERBUFFER, GL_DEPTH24_STENCIL8,
-                          width, height);
-    glBindRenderbuffer(GL_RENDERBUFFER, 0); // default(0)
+        glGenRenderbuffers(1, &m_depthStencilBuffer);
+        glBindRenderbuffer(GL_RENDERBUFFER, m_depthStencilBuffer);
+        glRenderbufferStorage(GL_RENDERBUFFER, GL_DEPTH24_STENCIL8,
+                              width, height);
+        glBindRenderbuffer(GL_RENDERBUFFER, 0); // default(0)
+        RenderStats::TrackFramebuffer(1, RenderStats::GetTextureSize(GL_DEPTH24_STENCIL8, width, height));
 
-    glFramebufferRenderbuffer(GL_FRAMEBUFFER, GL_DEPTH_STENCIL_ATTACHMENT,
-                              GL_RENDERBUFFER, m_depthStencilBuffer);
+        glFramebufferRenderbuffer(GL_FRAMEBUFFER, GL_DEPTH_STENCIL_ATTACHMENT,
+                                  GL_RENDERBUFFER, m_depthStencilBuffer);
+    }
 
     auto result = glCheckFramebufferStatus(GL_FRAMEBUFFER);
     if (result != GL_FRAMEBUFFER_COMPLETE)
@@ -74,4 +140,29 @@ bool Framebuffer::InitWithColorAttachments(const std::vector<TexturePtr> &colorA
     BindToDefault();
 
     return true;
-}
\ No newline at end of file
+}
+
+HistoryBufferUPtr HistoryBuffer::Create(int width, int height, uint32_t format, uint32_t type)
+{
+    auto history = HistoryBufferUPtr(new HistoryBuffer());
+    if (!history->Init(width, height, format, type))
+        return nullptr;
+    return std::move(history);
+}
+
+bool HistoryBuffer::Init(int width, int height, uint32_t format, uint32_t type)
+{
+    for (auto &framebuffer : m_framebuffers)
+    {
+        framebuffer = Framebuffer::CreateColorOnly({Texture::Create(width, height, format, type)});
+        if (!framebuffer)
+            return false;
+    }
+    return true;
+}
+
+void HistoryBuffer::Swap()
+{
+    m_current = 1 - m_current;
+    m_valid = true;
+}
@@ -6,20 +6,63 @@ CLASS_PTR(Framebuffer);
 class Framebuffer
 {
 public:
-    static FramebufferUPtr Create(const std::vector<TexturePtr> &colorAttachments);
+    // depthAttachment(GL_DEPTH24_STENCIL8 텍스처)를 주면 renderbuffer 대신 사용해서 셰이더에서 깊이를 읽을 수 있음
+    // level은 color attachment의 mip level. mip chain을 직접 만들 때 사용
+    static FramebufferUPtr Create(const std::vector<TexturePtr> &colorAttachments,
+                                  const TexturePtr &depthAttachment = nullptr, int level = 0);
+    // depth/stencil 없이 color attachment만 가진 framebuffer. depth test 없이 그리는 full-screen pass용
+    static FramebufferUPtr CreateColorOnly(const std::vector<TexturePtr> &colorAttachments, int level = 0);
     static void BindToDefault();
+    // BindToDefault가 바인딩할 대상. nullptr이면 윈도우의 기본 framebuffer(0)
+    // 윈도우가 없는 headless 실행에서 offscreen framebuffer로 바꿔서 사용
+    static void SetDefault(const FramebufferPtr &framebuffer);
+    static uint32_t GetDefault();
+    // 현재 바인딩된 framebuffer를 지움. frame capture에 기록되도록 glClear 대신 사용
+    static void Clear(uint32_t mask);
     ~Framebuffer();
 
     const uint32_t Get() const { return m_framebuffer; }
     void Bind() const;
+    // 이 framebuffer의 내용(mask)을 기본 framebuffer로 복사
+    void BlitToDefault(int width, int height, uint32_t mask, uint32_t filter = GL_NEAREST) const;
     int GetColorAttachmentCount() const { return (int)m_colorAttachments.size(); }
     const TexturePtr GetColorAttachment(int index = 0) const { return m_colorAttachments[index]; }
+    const TexturePtr GetDepthAttachment() const { return m_depthAttachment; }
 
 private:
     Framebuffer() {}
 
-    bool InitWithColorAttachments(const std::vector<TexturePtr> &colorAttachments);
+    bool InitWithColorAttachments(const std::vector<TexturePtr> &colorAttachments,
+                                  const TexturePtr &depthAttachment, int level, bool useDepth = true);
     uint32_t m_framebuffer{0};
+    int m_level{0};
     uint32_t m_depthStencilBuffer{0};
     std::vector<TexturePtr> m_colorAttachments;
-};
\ No newline at end of file
+    TexturePtr m_depthAttachment;
+};
+
+// temporal 누적용 framebuffer 쌍. 이전 프레임 결과(history)를 읽으면서 다른 쪽에 이번 프레임 결과를 씀
+//   GetTarget()에 그리고 Swap()하면 방금 그린 결과가 GetHistory()가 됨
+CLASS_PTR(HistoryBuffer);
+class HistoryBuffer
+{
+public:
+    static HistoryBufferUPtr Create(int width, int height, uint32_t format, uint32_t type = GL_UNSIGNED_BYTE);
+    ~HistoryBuffer() = default;
+
+    const FramebufferPtr &GetTarget() const { return m_framebuffers[m_current]; }
+    // 가장 최근에 Swap한 결과. IsValid()가 false면 내용이 의미 없음
+    const TexturePtr GetHistory() const { return m_framebuffers[1 - m_current]->GetColorAttachment(); }
+    bool IsValid() const { return m_valid; }
+    // 설정이 바뀌거나 카메라가 순간 이동해서 history를 쓸 수 없을 때
+    void Invalidate() { m_valid = false; }
+    void Swap();
+
+private:
+    HistoryBuffer() {}
+    bool Init(int width, int height, uint32_t format, uint32_t type);
+
+    FramebufferPtr m_framebuffers[2];
+    int m_current{0};
+    bool m_valid{false};
+};
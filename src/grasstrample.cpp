@@ -0,0 +1,134 @@
+#include "grasstrample.h"
+#include <algorithm>
+#include <cfloat>
+
+GrassTrampleUPtr GrassTrample::Create(float radius, float recoverSpeed)
+{
+    auto trample = GrassTrampleUPtr(new GrassTrample());
+    trample->Init(radius, recoverSpeed);
+    return std::move(trample);
+}
+
+void GrassTrample::Init(float radius, float recoverSpeed)
+{
+    m_radius = radius;
+    m_recoverSpeed = recoverSpeed;
+}
+
+glm::ivec2 GrassTrample::GetCell(float x, float z) const
+{
+    return glm::ivec2((int)floorf((x - m_origin.x) / m_cellSize),
+                      (int)floorf((z - m_origin.y) / m_cellSize));
+}
+
+void GrassTrample::Rebuild(const InstanceSet *instances)
+{
+    m_dirty = false;
+    size_t count = instances->GetCount();
+    m_bent.clear();
+    m_isBent.assign(count, 0);
+    m_cellStart.assign(1, 0);
+    m_cellIndices.clear();
+    m_gridSize = glm::ivec2(0);
+    if (count == 0)
+        return;
+
+    glm::vec2 minPos(FLT_MAX), maxPos(-FLT_MAX);
+    for (size_t i = 0; i < count; i++)
+    {
+        auto &data = instances->Get(i);
+        minPos = glm::min(minPos, glm::vec2(data.x, data.z));
+        maxPos = glm::max(maxPos, glm::vec2(data.x, data.z));
+        if (data.w > 0.0f)
+        {
+            m_isBent[i] = 1;
+            m_bent.push_back((uint32_t)i);
+        }
+    }
+
+    // 칸 크기는 밟는 반경 정도로 하되, 넓게 퍼진 경우 칸 수가 너무 많아지지 않게 키움
+    glm::vec2 extent = maxPos - minPos;
+    m_cellSize = std::max(m_radius, std::max(extent.x, extent.y) / MAX_GRID_SIZE);
+    m_origin = minPos;
+    m_gridSize = GetCell(maxPos.x, maxPos.y) + 1;
+
+    // counting sort로 칸별 인스턴스 목록 구성
+    m_cellStart.assign((size_t)m_gridSize.x * m_gridSize.y + 1, 0);
+    std::vector<uint32_t> cellOf(count);
+    for (size_t i = 0; i < count; i++)
+    {
+        auto &data = instances->Get(i);
+        auto cell = glm::clamp(GetCell(data.x, data.z), glm::ivec2(0), m_gridSize - 1);
+        cellOf[i] = (uint32_t)(cell.y * m_gridSize.x + cell.x);
+        m_cellStart[cellOf[i] + 1]++;
+    }
+    for (size_t i = 1; i < m_cellStart.size(); i++)
+        m_cellStart[i] += m_cellStart[i - 1];
+    m_cellIndices.resize(count);
+    std::vector<uint32_t> cursor(m_cellStart.begin(), m_cellStart.end() - 1);
+    for (size_t i = 0; i < count; i++)
+        m_cellIndices[cursor[cellOf[i]]++] = (uint32_t)i;
+}
+
+void GrassTrample::Update(InstanceSet *instances, const glm::vec2 &center, bool active)
+{
+    if (m_dirty || m_isBent.size() != instances->GetCount())
+        Rebuild(instances);
+
+    auto isNear = [&](const glm::vec4 &data)
+    {
+        return active && glm::length(glm::vec2(data.x, data.z) - center) < m_radius;
+    };
+
+    // 카메라 주변 칸의 풀을 눕힘
+    if (active && m_gridSize.x > 0)
+    {
+        auto minCell = glm::max(GetCell(center.x - m_radius, center.y - m_radius), glm::ivec2(0));
+        auto maxCell = glm::min(GetCell(center.x + m_radius, center.y + m_radius), m_gridSize - 1);
+        for (int z = minCell.y; z <= maxCell.y; z++)
+        {
+            for (int x = minCell.x; x <= maxCell.x; x++)
+            {
+                int cell = z * m_gridSize.x + x;
+                for (uint32_t i = m_cellStart[cell]; i < m_cellStart[cell + 1]; i++)
+                {
+                    uint32_t index = m_cellIndices[i];
+                    auto data = instances->Get(index);
+                    if (!isNear(data))
+                        continue;
+                    if (data.w != 1.0f)
+                    {
+                        data.w = 1.0f;
+                        instances->Set(index, data);
+                    }
+                    if (!m_isBent[index])
+                    {
+                        m_isBent[index] = 1;
+                        m_bent.push_back(index);
+                    }
+                }
+            }
+        }
+    }
+
+    // 반경 밖의 휘어 있는 풀은 서서히 복구하고, 다 펴지면 목록에서 뺌
+    // 값이 바뀐 인스턴스만 Set 하므로 변경된 페이지만 업로드됨
+    for (size_t i = 0; i < m_bent.size();)
+    {
+        uint32_t index = m_bent[i];
+        auto data = instances->Get(index);
+        if (!isNear(data))
+        {
+            data.w = std::max(data.w - m_recoverSpeed, 0.0f);
+            instances->Set(index, data);
+        }
+        if (data.w > 0.0f)
+        {
+            i++;
+            continue;
+        }
+        m_isBent[index] = 0;
+        m_bent[i] = m_bent.back();
+        m_bent.pop_back();
+    }
+}
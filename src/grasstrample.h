@@ -0,0 +1,42 @@
+#pragma once
+
+#include "common.h"
+#include "instanceset.h"
+#include <vector>
+
+// 풀 밟기 : 인스턴스 데이터 (x, 회전, z, bend)의 bend를 카메라 근처에서는 1로, 그 외에는 서서히 0으로 되돌림
+// 인스턴스 위치를 균일 격자로 나눠두고 카메라 주변 칸과 아직 휘어 있는 인스턴스만 검사하므로
+// 프레임당 비용이 전체 인스턴스 수가 아니라 밟히거나 복구 중인 인스턴스 수에 비례
+CLASS_PTR(GrassTrample)
+class GrassTrample
+{
+public:
+    static GrassTrampleUPtr Create(float radius = 1.5f, float recoverSpeed = 0.01f);
+    ~GrassTrample() = default;
+
+    // center : 인스턴스 좌표계에서 카메라의 (x, z). active가 false면 복구만 진행
+    void Update(InstanceSet *instances, const glm::vec2 &center, bool active);
+    // 인스턴스가 추가/삭제되어 번호가 바뀌면 호출. 다음 Update에서 격자를 다시 만듦
+    void Invalidate() { m_dirty = true; }
+
+    size_t GetBentCount() const { return m_bent.size(); }
+
+private:
+    GrassTrample() {}
+    void Init(float radius, float recoverSpeed);
+    void Rebuild(const InstanceSet *instances);
+    glm::ivec2 GetCell(float x, float z) const;
+
+    static constexpr int MAX_GRID_SIZE = 1024; // 축당 최대 칸 수
+
+    float m_radius{1.5f};
+    float m_recoverSpeed{0.01f};
+    float m_cellSize{1.5f};
+    glm::vec2 m_origin{0.0f};
+    glm::ivec2 m_gridSize{0};
+    std::vector<uint32_t> m_cellStart;   // 칸별 m_cellIndices 시작 위치 (칸 수 + 1)
+    std::vector<uint32_t> m_cellIndices; // 칸 순서로 정렬된 인스턴스 번호
+    std::vector<uint32_t> m_bent;        // bend > 0 인 인스턴스
+    std::vector<uint8_t> m_isBent;
+    bool m_dirty{true};
+};
@@ -0,0 +1,415 @@
+#include "headless.h"
+#include "capture.h"
+#include "context.h"
+#include "timer.h"
+#include <glm/gtc/constants.hpp>
+#include <algorithm>
+#include <chrono>
+#include <cstdlib>
+#include <cstring>
+
+#ifdef USE_EGL
+#include <EGL/egl.h>
+#include <EGL/eglext.h>
+
+static EGLDisplay s_display = EGL_NO_DISPLAY;
+static EGLContext s_context = EGL_NO_CONTEXT;
+
+static bool CreateGLContext()
+{
+    // Mesa의 surfaceless platform을 우선 사용. 없으면 기본 display
+    auto getPlatformDisplay = (PFNEGLGETPLATFORMDISPLAYEXTPROC)eglGetProcAddress("eglGetPlatformDisplayEXT");
+    if (getPlatformDisplay)
+        s_display = getPlatformDisplay(EGL_PLATFORM_SURFACELESS_MESA, EGL_DEFAULT_DISPLAY, nullptr);
+    if (s_display == EGL_NO_DISPLAY)
+        s_display = eglGetDisplay(EGL_DEFAULT_DISPLAY);
+
+    EGLint major, minor;
+    if (s_display == EGL_NO_DISPLAY || !eglInitialize(s_display, &major, &minor))
+    {
+        SPDLOG_ERROR("failed to initialize EGL display");
+        return false;
+    }
+    SPDLOG_INFO("EGL version: {}.{}", major, minor);
+
+    const EGLint configAttribs[] = {
+        EGL_RENDERABLE_TYPE, EGL_OPENGL_BIT,
+        EGL_SURFACE_TYPE, EGL_PBUFFER_BIT,
+        EGL_NONE,
+    };
+    EGLConfig config;
+    EGLint configCount = 0;
+    if (!eglChooseConfig(s_display, configAttribs, &config, 1, &configCount) || configCount == 0)
+    {
+        SPDLOG_ERROR("failed to choose EGL config");
+        return false;
+    }
+
+    eglBindAPI(EGL_OPENGL_API);
+    const EGLint contextAttribs[] = {
+        EGL_CONTEXT_MAJOR_VERSION, 3,
+        EGL_CONTEXT_MINOR_VERSION, 3,
+        EGL_CONTEXT_OPENGL_PROFILE_MASK, EGL_CONTEXT_OPENGL_CORE_PROFILE_BIT,
+        EGL_NONE,
+    };
+    s_context = eglCreateContext(s_display, config, EGL_NO_CONTEXT, contextAttribs);
+    if (s_context == EGL_NO_CONTEXT)
+    {
+        SPDLOG_ERROR("failed to create EGL context");
+        return false;
+    }
+
+    // surface 없이 context만 바인딩 (EGL_KHR_surfaceless_context)
+    if (!eglMakeCurrent(s_display, EGL_NO_SURFACE, EGL_NO_SURFACE, s_context))
+    {
+        SPDLOG_ERROR("failed to make EGL context current");
+        return false;
+    }
+
+    return gladLoadGLLoader((GLADloadproc)eglGetProcAddress);
+}
+
+static void DestroyGLContext()
+{
+    if (s_display == EGL_NO_DISPLAY)
+        return;
+    eglMakeCurrent(s_display, EGL_NO_SURFACE, EGL_NO_SURFACE, EGL_NO_CONTEXT);
+    if (s_context != EGL_NO_CONTEXT)
+        eglDestroyContext(s_display, s_context);
+    eglTerminate(s_display);
+}
+#else
+static GLFWwindow *s_window = nullptr;
+
+// EGL 없이 빌드하면 숨긴 glfw 창의 context를 사용하므로 진짜 headless가 아님
+// 창을 띄울 수 있는 display(X11/Wayland, Windows/macOS 데스크탑 세션)가 있어야 함
+static bool CreateGLContext()
+{
+#if defined(__linux__)
+    if (!getenv("DISPLAY") && !getenv("WAYLAND_DISPLAY"))
+    {
+        SPDLOG_ERROR("no display available for the hidden glfw window; "
+                     "build with -DUSE_EGL=ON to render without a display");
+        return false;
+    }
+#endif
+    SPDLOG_WARN("not truly headless: rendering through a hidden glfw window (build with -DUSE_EGL=ON to avoid it)");
+    if (!glfwInit())
+    {
+        const char *description = nullptr;
+        glfwGetError(&description);
+        SPDLOG_ERROR("failed to initialize glfw: {}", description ? description : "unknown error");
+        return false;
+    }
+
+    glfwWindowHint(GLFW_CONTEXT_VERSION_MAJOR, 3);
+    glfwWindowHint(GLFW_CONTEXT_VERSION_MINOR, 3);
+    glfwWindowHint(GLFW_OPENGL_PROFILE, GLFW_OPENGL_CORE_PROFILE);
+    glfwWindowHint(GLFW_VISIBLE, GLFW_FALSE);
+    s_window = glfwCreateWindow(64, 64, WINDOW_NAME, nullptr, nullptr);
+    if (!s_window)
+    {
+        SPDLOG_ERROR("failed to create hidden glfw window");
+        glfwTerminate();
+        return false;
+    }
+    glfwMakeContextCurrent(s_window);
+    // 화면에 표시하지 않으므로 vsync에 묶이지 않도록 함
+    glfwSwapInterval(0);
+
+    return gladLoadGLLoader((GLADloadproc)glfwGetProcAddress);
+}
+
+static void DestroyGLContext()
+{
+    if (s_window)
+        glfwDestroyWindow(s_window);
+    glfwTerminate();
+}
+#endif
+
+bool CreateHeadlessGLContext()
+{
+    if (CreateGLContext())
+        return true;
+    DestroyGLContext();
+    return false;
+}
+
+void DestroyHeadlessGLContext()
+{
+    DestroyGLContext();
+}
+
+static Camera LookAtCamera(const vec3 &position, const vec3 &target)
+{
+    Camera camera;
+    camera.Pos = position;
+    vec3 direction = normalize(target - position);
+    camera.Yaw = degrees(atan2f(-direction.x, -direction.z));
+    camera.Pitch = degrees(asinf(direction.y));
+    return camera;
+}
+
+// t : [0, 1) 경로 진행 비율. 시간이 아니라 프레임 번호로 정해지므로 항상 같은 경로
+static Camera GetPathCamera(CameraPath path, float t)
+{
+    if (path == CameraPath::FlyThrough)
+    {
+        vec3 position = mix(vec3(8.0f, 2.5f, 10.0f), vec3(-24.0f, 2.0f, 10.0f), t);
+        return LookAtCamera(position, position + vec3(-1.0f, -0.2f, -2.0f));
+    }
+
+    float angle = t * glm::two_pi<float>();
+    vec3 position = vec3(12.0f * sinf(angle), 3.0f + 1.5f * sinf(angle * 2.0f), 12.0f * cosf(angle));
+    return LookAtCamera(position, vec3(0.0f, 0.5f, 0.0f));
+}
+
+static float GetPercentile(const std::vector<float> &sorted, float percent)
+{
+    size_t index = (size_t)ceilf(percent * sorted.size());
+    return sorted[glm::clamp(index, (size_t)1, sorted.size()) - 1];
+}
+
+// 프레임 시간 통계를 출력하고 result가 있으면 채움
+static void ReportFrameTimes(std::vector<float> frameTimes, HeadlessResult *result)
+{
+    if (frameTimes.empty())
+        return;
+
+    HeadlessResult stats;
+    std::vector<float> sorted = frameTimes;
+    std::sort(sorted.begin(), sorted.end());
+    double total = 0.0;
+    for (auto time : frameTimes)
+        total += time;
+    stats.mean = (float)(total / frameTimes.size());
+    stats.p50 = GetPercentile(sorted, 0.5f);
+    stats.p95 = GetPercentile(sorted, 0.95f);
+    stats.p99 = GetPercentile(sorted, 0.99f);
+    stats.min = sorted.front();
+    stats.max = sorted.back();
+    SPDLOG_INFO("frame time (ms): mean {:.3f}, p50 {:.3f}, p95 {:.3f}, p99 {:.3f}, min {:.3f}, max {:.3f}",
+                stats.mean, stats.p50, stats.p95, stats.p99, stats.min, stats.max);
+
+    if (result)
+    {
+        *result = stats;
+        result->frameTimes = std::move(frameTimes);
+    }
+}
+
+int RunHeadless(const HeadlessOption &option, HeadlessResult *result)
+{
+    SPDLOG_INFO("headless: {} frames ({} warmup), {} x {}",
+                option.frameCount, option.warmupFrames, option.width, option.height);
+
+    if (!CreateGLContext())
+    {
+        SPDLOG_ERROR("failed to create headless GL context");
+        DestroyGLContext();
+        return -1;
+    }
+    SPDLOG_INFO("OpenGL renderer: {}, version: {}",
+                (const char *)glGetString(GL_RENDERER), (const char *)glGetString(GL_VERSION));
+
+    std::vector<float> frameTimes;
+    RenderFrameStats renderStats;
+    RenderMemoryStats memoryStats;
+    float initTime = 0.0f, shaderInitTime = 0.0f;
+    std::map<std::string, std::vector<double>> gpuPassTimes;
+    std::vector<uint8_t> ambientOcclusion, firstAmbientOcclusion;
+    float totalFenceWaitMs = 0.0f, maxFenceWaitMs = 0.0f;
+    uint64_t maxBufferUploadBytes = 0;
+    {
+        auto initStart = std::chrono::steady_clock::now();
+        auto context = Context::Create(option.scene);
+        initTime = std::chrono::duration<float, std::milli>(std::chrono::steady_clock::now() - initStart).count();
+        if (!context)
+        {
+            SPDLOG_ERROR("failed to create context");
+            DestroyGLContext();
+            return -1;
+        }
+        shaderInitTime = context->GetShaderInitTime();
+        SPDLOG_INFO("context init: {:.1f} ms (shaders {:.1f} ms)", initTime, shaderInitTime);
+        // UI 없이, simulation은 고정 간격으로 같은 스레드에서 진행해서 매번 같은 장면이 나오도록 함
+        context->SetUIEnabled(false);
+        context->SetSimulationThread(false);
+        context->Reshape(option.width, option.height);
+
+        FramebufferPtr target = Framebuffer::Create({
+            Texture::Create(option.width, option.height, GL_RGBA),
+        });
+        if (!target)
+        {
+            SPDLOG_ERROR("failed to create offscreen framebuffer");
+            // GL 리소스를 가진 Context를 먼저 해제해야 context가 살아있는 상태에서 정리됨
+            context.reset();
+            DestroyGLContext();
+            return -1;
+        }
+        Framebuffer::SetDefault(target);
+
+        auto readAmbientOcclusion = [&](std::vector<uint8_t> &pixels)
+        {
+            auto texture = context->GetAmbientOcclusion();
+            pixels.resize((size_t)texture->GetWidth() * texture->GetHeight());
+            texture->Bind();
+            glPixelStorei(GL_PACK_ALIGNMENT, 1);
+            glGetTexImage(GL_TEXTURE_2D, 0, GL_RED, GL_UNSIGNED_BYTE, pixels.data());
+            glPixelStorei(GL_PACK_ALIGNMENT, 4);
+        };
+
+        auto timer = Timer::Create();
+        int totalFrames = option.warmupFrames + option.frameCount;
+        frameTimes.reserve(option.frameCount);
+        for (int i = 0; i < totalFrames; i++)
+        {
+            auto start = std::chrono::steady_clock::now();
+
+            if (i == totalFrames - 1 && !option.captureFile.empty())
+                FrameCapture::Request(option.captureFile);
+            timer->Advance(option.frameStep);
+            context->SetCamera(GetPathCamera(option.cameraPath, (float)i / (float)totalFrames));
+            Framebuffer::BindToDefault();
+            context->Render(*timer);
+            // GPU 작업까지 끝난 시간을 측정
+            glFinish();
+
+            auto end = std::chrono::steady_clock::now();
+            if (i >= option.warmupFrames)
+            {
+                frameTimes.push_back(std::chrono::duration<float, std::milli>(end - start).count());
+                auto &frameStats = RenderStats::GetFrame();
+                totalFenceWaitMs += frameStats.fenceWaitMs;
+                maxFenceWaitMs = std::max(maxFenceWaitMs, frameStats.fenceWaitMs);
+                maxBufferUploadBytes = std::max(maxBufferUploadBytes, frameStats.bufferUploadBytes);
+            }
+            // 시간을 잰 뒤에 읽어서 측정에 포함되지 않게 함
+            if (i == option.warmupFrames && option.readAmbientOcclusion)
+                readAmbientOcclusion(firstAmbientOcclusion);
+        }
+
+        // pass별 시간 (profiler history 평균)
+        auto &history = context->GetProfiler()->GetHistory();
+        if (!history.empty())
+        {
+            SPDLOG_INFO("pass times over last {} frames (cpu / gpu ms):", history.size());
+            for (auto &sample : history.back().samples)
+            {
+                double cpuSum = 0.0, gpuSum = 0.0;
+                int count = 0;
+                for (auto &frame : history)
+                {
+                    for (auto &pastSample : frame.samples)
+                    {
+                        if (strcmp(pastSample.name, sample.name) != 0)
+                            continue;
+                        cpuSum += pastSample.cpuEnd - pastSample.cpuStart;
+                        gpuSum += pastSample.gpuTime;
+                        count++;
+                        break;
+                    }
+                }
+                SPDLOG_INFO("  {:<20} {:8.3f} / {:8.3f}", sample.name, cpuSum / count, gpuSum / count);
+            }
+            for (auto &frame : history)
+            {
+                for (auto &sample : frame.samples)
+                {
+                    if (sample.gpuTime >= 0.0)
+                        gpuPassTimes[sample.name].push_back(sample.gpuTime);
+                }
+            }
+        }
+
+        if (option.readAmbientOcclusion)
+            readAmbientOcclusion(ambientOcclusion);
+
+        renderStats = RenderStats::GetFrame();
+        memoryStats = RenderStats::GetMemory();
+        SPDLOG_INFO("last frame: {} draw calls, {} triangles, {} texture binds, {} program binds",
+                    renderStats.drawCalls, renderStats.triangles, renderStats.textureBinds, renderStats.programBinds);
+        SPDLOG_INFO("GPU memory: buffers {:.2f} MB, textures {:.2f} MB, depth/stencil {:.2f} MB",
+                    memoryStats.bufferBytes / (1024.0 * 1024.0), memoryStats.textureBytes / (1024.0 * 1024.0),
+                    memoryStats.renderbufferBytes / (1024.0 * 1024.0));
+        SPDLOG_INFO("stream fence wait: {:.3f} ms total, {:.3f} ms max per frame", totalFenceWaitMs, maxFenceWaitMs);
+
+        Framebuffer::SetDefault(nullptr);
+    }
+    DestroyGLContext();
+
+    ReportFrameTimes(std::move(frameTimes), result);
+    if (result)
+    {
+        result->renderStats = renderStats;
+        result->memoryStats = memoryStats;
+        result->totalFenceWaitMs = totalFenceWaitMs;
+        result->maxFenceWaitMs = maxFenceWaitMs;
+        result->maxBufferUploadBytes = maxBufferUploadBytes;
+        result->initTime = initTime;
+        result->shaderInitTime = shaderInitTime;
+        result->gpuPassTimes = std::move(gpuPassTimes);
+        result->ambientOcclusion = std::move(ambientOcclusion);
+        result->firstAmbientOcclusion = std::move(firstAmbientOcclusion);
+    }
+    return 0;
+}
+
+int RunReplay(const HeadlessOption &option, const std::string &filename, HeadlessResult *result)
+{
+    SPDLOG_INFO("replay: {}, {} frames ({} warmup), {} x {}",
+                filename, option.frameCount, option.warmupFrames, option.width, option.height);
+
+    if (!CreateGLContext())
+    {
+        SPDLOG_ERROR("failed to create headless GL context");
+        DestroyGLContext();
+        return -1;
+    }
+
+    std::vector<float> frameTimes;
+    {
+        FramebufferPtr target = Framebuffer::Create({
+            Texture::Create(option.width, option.height, GL_RGBA),
+        });
+        if (!target)
+        {
+            SPDLOG_ERROR("failed to create offscreen framebuffer");
+            DestroyGLContext();
+            return -1;
+        }
+        Framebuffer::SetDefault(target);
+
+        auto replay = FrameReplay::Load(filename);
+        if (!replay)
+        {
+            Framebuffer::SetDefault(nullptr);
+            target.reset();
+            DestroyGLContext();
+            return -1;
+        }
+        CaptureStats::Compute(replay->GetData()).Print();
+
+        int totalFrames = option.warmupFrames + option.frameCount;
+        frameTimes.reserve(option.frameCount);
+        for (int i = 0; i < totalFrames; i++)
+        {
+            auto start = std::chrono::steady_clock::now();
+            replay->Replay();
+            glFinish();
+            auto end = std::chrono::steady_clock::now();
+            if (i >= option.warmupFrames)
+                frameTimes.push_back(std::chrono::duration<float, std::milli>(end - start).count());
+        }
+
+        replay.reset();
+        Framebuffer::SetDefault(nullptr);
+    }
+    DestroyGLContext();
+
+    ReportFrameTimes(std::move(frameTimes), result);
+    return 0;
+}
+
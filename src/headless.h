@@ -0,0 +1,62 @@
+#pragma once
+
+#include "common.h"
+#include "context.h"
+#include "renderstats.h"
+#include <map>
+
+enum class CameraPath
+{
+    Orbit,      // 원점을 바라보며 한 바퀴 회전
+    FlyThrough, // forward 장면에서 deferred 장면 쪽으로 직선 이동
+};
+
+struct HeadlessOption
+{
+    SceneOption scene;
+    CameraPath cameraPath{CameraPath::Orbit};
+    int frameCount{300};
+    int warmupFrames{30}; // 통계에서 제외할 처음 프레임 수
+    int width{WINDOW_WIDTH};
+    int height{WINDOW_HEIGHT};
+    float frameStep{1.0f / 60.0f}; // simulation에 넘기는 고정 프레임 간격(초)
+    std::string captureFile;       // 설정하면 마지막 프레임의 GL 명령을 저장
+    bool readAmbientOcclusion{false}; // 첫 측정 프레임과 마지막 프레임의 AO를 result에 복사 (해상도별 비교용)
+};
+
+struct HeadlessResult
+{
+    std::vector<float> frameTimes; // ms, warmup 제외
+    float mean{0.0f};
+    float p50{0.0f};
+    float p95{0.0f};
+    float p99{0.0f};
+    float min{0.0f};
+    float max{0.0f};
+    RenderFrameStats renderStats;   // 마지막 프레임
+    RenderMemoryStats memoryStats;  // 종료 직전
+    float totalFenceWaitMs{0.0f};   // 측정 프레임 동안 stream 버퍼 fence를 기다린 시간의 합
+    float maxFenceWaitMs{0.0f};     // 그 중 한 프레임의 최대값
+    uint64_t maxBufferUploadBytes{0}; // 측정 프레임 중 한 프레임에 업로드한 버퍼 데이터의 최대값
+    float initTime{0.0f};           // ms, Context 생성(쉐이더, 텍스처, 모델 로딩) 시간
+    float shaderInitTime{0.0f};     // ms, 그 중 쉐이더 컴파일/binary 로딩 시간
+    // pass 이름별 GPU 시간(ms). profiler history에 남아있는 프레임마다 하나씩
+    std::map<std::string, std::vector<double>> gpuPassTimes;
+    std::vector<uint8_t> ambientOcclusion; // width x height, readAmbientOcclusion일 때만. 마지막 프레임
+    std::vector<uint8_t> firstAmbientOcclusion; // warmup 직후 프레임. 프레임마다 AO가 갱신되는지 확인용
+};
+
+// 윈도우 없이 offscreen framebuffer에 카메라 경로를 따라 렌더링하고 프레임 시간 통계를 출력
+// USE_EGL로 빌드하면 EGL surfaceless context(Mesa llvmpipe 등)를 사용하고
+// 아니면 보이지 않는 GLFW 윈도우를 사용
+// result가 있으면 통계를 채움. 실패하면 0이 아닌 값 반환
+int RunHeadless(const HeadlessOption &option, HeadlessResult *result = nullptr);
+
+// RunHeadless와 같은 방식(EGL 또는 숨긴 GLFW 윈도우)으로 GL context만 만들어 current로 설정
+// Context 없이 GL 리소스를 직접 다루는 GPU benchmark용. 실패하면 false
+bool CreateHeadlessGLContext();
+void DestroyHeadlessGLContext();
+
+// FrameCapture로 저장한 한 프레임을 offscreen framebuffer에 frameCount번 반복 재생하고 통계를 출력
+// 캡처할 때와 같은 width, height를 사용해야 viewport가 맞음
+int RunReplay(const HeadlessOption &option, const std::string &filename, HeadlessResult *result = nullptr);
@@ -65,7 +65,8 @@ void Image::SetCheckImage(int gridX, int gridY)
 
 bool Image::LoadWithStb(const std::string &filepath, bool flipVertical)
 {
-    stbi_set_flip_vertically_on_load(flipVertical);
+    // 여러 스레드에서 동시에 로드할 수 있도록 스레드별 설정 사용
+    stbi_set_flip_vertically_on_load_thread(flipVertical);
 
     m_data = stbi_load(filepath.c_str(), &m_width, &m_height, &m_channelCount, 0);
     if (!m_data)
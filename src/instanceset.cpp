@@ -0,0 +1,163 @@
+#include "instanceset.h"
+#include <algorithm>
+
+InstanceSetUPtr InstanceSet::Create(size_t capacity, size_t uploadBudget)
+{
+    auto instanceSet = InstanceSetUPtr(new InstanceSet());
+    if (!instanceSet->Init(capacity, uploadBudget))
+        return nullptr;
+    return std::move(instanceSet);
+}
+
+bool InstanceSet::Init(size_t capacity, size_t uploadBudget)
+{
+    m_capacity = std::max(capacity, PAGE_SIZE);
+    m_uploadBudget = std::max(uploadBudget, PAGE_SIZE * sizeof(glm::vec4));
+    m_data.reserve(m_capacity);
+    m_buffer = Buffer::CreateWithData(GL_ARRAY_BUFFER, GL_DYNAMIC_DRAW,
+                                      nullptr, sizeof(glm::vec4), m_capacity);
+    return m_buffer != nullptr;
+}
+
+size_t InstanceSet::Add(const glm::vec4 &data)
+{
+    size_t index = m_data.size();
+    m_data.push_back(data);
+    if (m_data.size() > m_capacity)
+    {
+        // 용량 초과 : 다음 Upload에서 버퍼를 두배로 늘림
+        m_capacity *= 2;
+        m_reallocate = true;
+    }
+    MarkDirty(index);
+    return index;
+}
+
+void InstanceSet::Remove(size_t index)
+{
+    if (index >= m_data.size())
+        return;
+
+    size_t last = m_data.size() - 1;
+    if (index != last)
+    {
+        m_data[index] = m_data[last];
+        MarkDirty(index);
+    }
+    // 버퍼의 마지막 원소는 draw 인스턴스 수가 줄어들면서 자연히 무시됨
+    m_data.pop_back();
+    // 다시 Add 되면 버퍼의 해당 자리는 지워진 인스턴스 값이므로 전송 완료 범위에서 뺌
+    m_uploadedCount = std::min(m_uploadedCount, m_data.size());
+}
+
+void InstanceSet::Set(size_t index, const glm::vec4 &data)
+{
+    if (index >= m_data.size())
+        return;
+    m_data[index] = data;
+    MarkDirty(index);
+}
+
+void InstanceSet::Clear()
+{
+    m_data.clear();
+    m_uploadedCount = 0;
+    ClearDirty();
+}
+
+void InstanceSet::ClearDirty()
+{
+    m_dirtyPages.clear();
+    std::fill(m_pageDirty.begin(), m_pageDirty.end(), 0);
+}
+
+void InstanceSet::MarkDirty(size_t index)
+{
+    size_t page = index / PAGE_SIZE;
+    if (page >= m_pageDirty.size())
+        m_pageDirty.resize(page + 1, 0);
+    if (m_pageDirty[page])
+        return;
+    m_pageDirty[page] = 1;
+    m_dirtyPages.push_back((uint32_t)page);
+}
+
+bool InstanceSet::Upload(bool all)
+{
+    m_lastUploadSize = 0;
+
+    bool reallocated = false;
+    if (m_reallocate)
+    {
+        // 이미 전송된 범위는 GPU에서 새 버퍼로 복사하고, 새 페이지는 아래의 한도 내 전송에 맡김
+        auto buffer = Buffer::CreateWithData(GL_ARRAY_BUFFER, GL_DYNAMIC_DRAW,
+                                             nullptr, sizeof(glm::vec4), m_capacity);
+        if (!buffer)
+            return false;
+        size_t copyCount = std::min(m_uploadedCount, m_buffer->GetCount());
+        if (copyCount > 0)
+        {
+            glBindBuffer(GL_COPY_READ_BUFFER, m_buffer->Get());
+            glBindBuffer(GL_COPY_WRITE_BUFFER, buffer->Get());
+            glCopyBufferSubData(GL_COPY_READ_BUFFER, GL_COPY_WRITE_BUFFER, 0, 0,
+                                copyCount * sizeof(glm::vec4));
+            glBindBuffer(GL_COPY_READ_BUFFER, 0);
+            glBindBuffer(GL_COPY_WRITE_BUFFER, 0);
+        }
+        m_buffer = std::move(buffer);
+        m_reallocate = false;
+        reallocated = true;
+    }
+
+    if (m_dirtyPages.empty())
+    {
+        m_uploadedCount = m_data.size();
+        return reallocated;
+    }
+
+    // 한도 내에서 처리할 페이지를 고르고, 연속된 페이지는 한번의 glBufferSubData로 합침
+    // 아직 한번도 전송되지 않은 페이지(firstNewPage 이후)를 먼저 골라 그릴 수 있는 인스턴스를 늘림
+    size_t budgetPages = m_uploadBudget / (PAGE_SIZE * sizeof(glm::vec4));
+    size_t pageCount = all ? m_dirtyPages.size() : std::min(budgetPages, m_dirtyPages.size());
+    uint32_t firstNewPage = (uint32_t)(std::min(m_uploadedCount, m_data.size()) / PAGE_SIZE);
+    std::partial_sort(m_dirtyPages.begin(), m_dirtyPages.begin() + pageCount, m_dirtyPages.end(),
+                      [firstNewPage](uint32_t a, uint32_t b)
+                      {
+                          bool newA = a >= firstNewPage, newB = b >= firstNewPage;
+                          return newA != newB ? newA : a < b;
+                      });
+
+    size_t i = 0;
+    while (i < pageCount)
+    {
+        size_t first = m_dirtyPages[i];
+        size_t last = first;
+        m_pageDirty[first] = 0;
+        while (i + 1 < pageCount && m_dirtyPages[i + 1] == last + 1)
+        {
+            i++;
+            last = m_dirtyPages[i];
+            m_pageDirty[last] = 0;
+        }
+        i++;
+
+        size_t begin = first * PAGE_SIZE;
+        size_t end = std::min((last + 1) * PAGE_SIZE, m_data.size());
+        if (begin < end)
+        {
+            m_buffer->Update(m_data.data() + begin, end - begin, begin);
+            m_lastUploadSize += (end - begin) * sizeof(glm::vec4);
+        }
+    }
+    m_dirtyPages.erase(m_dirtyPages.begin(), m_dirtyPages.begin() + pageCount);
+
+    // 새 페이지는 앞에서부터 전송되므로, 남은 새 페이지 중 가장 앞의 것 직전까지가 전송 완료된 범위
+    size_t uploaded = m_data.size();
+    for (auto page : m_dirtyPages)
+    {
+        if (page >= firstNewPage)
+            uploaded = std::min(uploaded, (size_t)page * PAGE_SIZE);
+    }
+    m_uploadedCount = uploaded;
+    return reallocated;
+}
@@ -0,0 +1,54 @@
+#pragma once
+
+#include "common.h"
+#include "buffer.h"
+#include <algorithm>
+#include <vector>
+
+// 인스턴스 데이터(vec4) 집합
+// 변경된 페이지만 표시해두고 Upload 때 프레임당 업로드 한도 내에서 dirty 페이지만 전송
+// 새로 추가된 페이지를 먼저 전송하고, 그릴 때는 GPU에 올라간 앞쪽 인스턴스(GetDrawCount)만 사용
+CLASS_PTR(InstanceSet)
+class InstanceSet
+{
+public:
+    static InstanceSetUPtr Create(size_t capacity, size_t uploadBudget = 4 * 1024 * 1024);
+    ~InstanceSet() = default;
+
+    size_t Add(const glm::vec4 &data);
+    void Remove(size_t index); // 마지막 인스턴스를 index 위치로 옮김
+    void Set(size_t index, const glm::vec4 &data);
+    void Clear();
+    const glm::vec4 &Get(size_t index) const { return m_data[index]; }
+    size_t GetCount() const { return m_data.size(); }
+    // 버퍼에 한번이라도 전송된 인스턴스 수. 아직 전송되지 않은 추가분은 그리지 않음
+    size_t GetDrawCount() const { return std::min(m_uploadedCount, m_data.size()); }
+
+    // 반환값 : 버퍼가 다시 생성되었는지 (VAO attribute 재설정 필요)
+    // all : 업로드 한도를 무시하고 dirty 페이지를 모두 전송 (초기화 시)
+    bool Upload(bool all = false);
+
+    const Buffer *GetBuffer() const { return m_buffer.get(); }
+    void SetUploadBudget(size_t bytes) { m_uploadBudget = bytes; }
+    size_t GetUploadBudget() const { return m_uploadBudget; }
+    size_t GetLastUploadSize() const { return m_lastUploadSize; }
+    size_t GetPendingPageCount() const { return m_dirtyPages.size(); }
+
+private:
+    InstanceSet() {}
+    bool Init(size_t capacity, size_t uploadBudget);
+    void MarkDirty(size_t index);
+    void ClearDirty();
+
+    static constexpr size_t PAGE_SIZE = 1024; // 페이지당 인스턴스 수 (16KB)
+
+    std::vector<glm::vec4> m_data;
+    std::vector<uint8_t> m_pageDirty;
+    std::vector<uint32_t> m_dirtyPages;
+    BufferUPtr m_buffer;
+    size_t m_capacity{0};
+    size_t m_uploadBudget{0};
+    size_t m_lastUploadSize{0};
+    size_t m_uploadedCount{0};
+    bool m_reallocate{false};
+};
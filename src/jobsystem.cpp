@@ -0,0 +1,196 @@
+#include "jobsystem.h"
+#include <algorithm>
+
+namespace
+{
+    // 현재 스레드가 사용하는 queue 번호 (worker : 1 ~ N, 그 외 : 0)
+    thread_local const void *t_jobSystem = nullptr;
+    thread_local uint32_t t_queueIndex = 0;
+}
+
+JobSystemUPtr JobSystem::Create(uint32_t threadCount)
+{
+    auto jobSystem = JobSystemUPtr(new JobSystem());
+    jobSystem->Init(threadCount);
+    return std::move(jobSystem);
+}
+
+void JobSystem::Init(uint32_t threadCount)
+{
+    if (threadCount == 0)
+    {
+        uint32_t coreCount = std::thread::hardware_concurrency();
+        threadCount = coreCount > 1 ? coreCount - 1 : 1;
+    }
+
+    m_queues.resize(threadCount + 1);
+    for (auto &queue : m_queues)
+        queue = std::make_unique<WorkQueue>();
+
+    m_running = true;
+    for (uint32_t i = 0; i < threadCount; i++)
+        m_threads.emplace_back(&JobSystem::WorkerLoop, this, i + 1);
+
+    SPDLOG_INFO("job system: {} worker threads", threadCount);
+}
+
+JobSystem::~JobSystem()
+{
+    {
+        std::lock_guard<std::mutex> lock(m_sleepMutex);
+        m_running = false;
+    }
+    m_wake.notify_all();
+    for (auto &thread : m_threads)
+        thread.join();
+}
+
+uint32_t JobSystem::GetQueueIndex() const
+{
+    return t_jobSystem == this ? t_queueIndex : 0;
+}
+
+void JobSystem::Submit(Job job, JobCounter *counter, JobCounter *dependency)
+{
+    if (counter)
+        counter->m_count.fetch_add(1, std::memory_order_relaxed);
+
+    JobItem item{std::move(job), counter};
+    if (dependency)
+    {
+        // 선행 job이 남아있으면 dependency의 대기 목록에 넣고, Complete에서 제출
+        std::lock_guard<std::mutex> lock(dependency->m_mutex);
+        if (!dependency->IsDone())
+        {
+            dependency->m_waiting.push_back(std::move(item));
+            return;
+        }
+    }
+    Enqueue(std::move(item));
+}
+
+void JobSystem::Enqueue(JobItem item)
+{
+    auto &queue = *m_queues[GetQueueIndex()];
+    {
+        std::lock_guard<std::mutex> lock(queue.mutex);
+        queue.jobs.push_back(std::move(item));
+    }
+
+    // 잠든 worker가 증가된 개수를 놓치지 않도록 sleep mutex를 거쳐서 깨움
+    m_queuedCount.fetch_add(1, std::memory_order_release);
+    {
+        std::lock_guard<std::mutex> lock(m_sleepMutex);
+    }
+    m_wake.notify_one();
+}
+
+bool JobSystem::TryRunJob(uint32_t queueIndex)
+{
+    JobItem item;
+    bool found = false;
+
+    // 자기 queue는 뒤에서(최근 것), 다른 queue는 앞에서(오래된 것) 꺼냄
+    {
+        auto &queue = *m_queues[queueIndex];
+        std::lock_guard<std::mutex> lock(queue.mutex);
+        if (!queue.jobs.empty())
+        {
+            item = std::move(queue.jobs.back());
+            queue.jobs.pop_back();
+            found = true;
+        }
+    }
+
+    for (size_t i = 1; !found && i < m_queues.size(); i++)
+    {
+        auto &queue = *m_queues[(queueIndex + i) % m_queues.size()];
+        std::lock_guard<std::mutex> lock(queue.mutex);
+        if (!queue.jobs.empty())
+        {
+            item = std::move(queue.jobs.front());
+            queue.jobs.pop_front();
+            found = true;
+        }
+    }
+
+    if (!found)
+        return false;
+
+    m_queuedCount.fetch_sub(1, std::memory_order_relaxed);
+    item.job();
+    if (item.counter)
+        Complete(item.counter);
+    return true;
+}
+
+void JobSystem::Complete(JobCounter *counter)
+{
+    // 대기 목록은 lock 안에서 꺼내므로, Submit이 dependency 완료를 놓치지 않음
+    std::vector<JobItem> waiting;
+    {
+        std::lock_guard<std::mutex> lock(counter->m_mutex);
+        if (counter->m_count.fetch_sub(1, std::memory_order_acq_rel) != 1)
+            return;
+        waiting.swap(counter->m_waiting);
+    }
+    for (auto &item : waiting)
+        Enqueue(std::move(item));
+}
+
+void JobSystem::SubmitRange(size_t count, size_t batchSize, const RangeJob &job,
+                            JobCounter *counter, JobCounter *dependency)
+{
+    batchSize = std::max<size_t>(batchSize, 1);
+    for (size_t begin = 0; begin < count; begin += batchSize)
+    {
+        size_t end = std::min(begin + batchSize, count);
+        Submit([job, begin, end]
+               { job(begin, end); },
+               counter, dependency);
+    }
+}
+
+void JobSystem::ParallelFor(size_t count, const RangeJob &job, size_t batchSize)
+{
+    if (count == 0)
+        return;
+    if (batchSize == 0)
+    {
+        // 스레드당 4개 정도로 나누어 부하 불균형을 work stealing으로 흡수
+        size_t batchCount = (size_t)GetThreadCount() * 4;
+        batchSize = (count + batchCount - 1) / batchCount;
+    }
+
+    JobCounter counter;
+    SubmitRange(count, batchSize, job, &counter);
+    Wait(&counter);
+}
+
+void JobSystem::WorkerLoop(uint32_t queueIndex)
+{
+    t_jobSystem = this;
+    t_queueIndex = queueIndex;
+
+    while (m_running)
+    {
+        if (TryRunJob(queueIndex))
+            continue;
+
+        std::unique_lock<std::mutex> lock(m_sleepMutex);
+        m_wake.wait(lock, [this]
+                    { return !m_running || m_queuedCount.load(std::memory_order_acquire) > 0; });
+    }
+}
+
+void JobSystem::Wait(JobCounter *counter)
+{
+    uint32_t queueIndex = GetQueueIndex();
+    while (!counter->IsDone())
+    {
+        if (!TryRunJob(queueIndex))
+            std::this_thread::yield();
+    }
+    // 마지막 Complete가 counter의 lock을 놓을 때까지 기다려야 호출자가 counter를 안전하게 해제할 수 있음
+    std::lock_guard<std::mutex> lock(counter->m_mutex);
+}
@@ -0,0 +1,84 @@
+#pragma once
+
+#include "common.h"
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+using Job = std::function<void()>;
+// [begin, end) 범위를 처리하는 job
+using RangeJob = std::function<void(size_t begin, size_t end)>;
+
+class JobCounter;
+
+struct JobItem
+{
+    Job job;
+    JobCounter *counter{nullptr};
+};
+
+// 제출한 job 중 끝나지 않은 개수. JobSystem::Wait로 0이 될 때까지 대기하거나
+// 다른 job의 선행 조건(dependency)으로 사용
+class JobCounter
+{
+public:
+    bool IsDone() const { return m_count.load(std::memory_order_acquire) == 0; }
+
+private:
+    friend class JobSystem;
+    std::atomic<int> m_count{0};
+    // 이 counter가 0이 되면 실행할 job
+    std::mutex m_mutex;
+    std::vector<JobItem> m_waiting;
+};
+
+// 스레드마다 deque를 가지고, 자기 deque가 비면 다른 스레드의 deque에서 job을 훔쳐오는 스레드 풀
+CLASS_PTR(JobSystem)
+class JobSystem
+{
+public:
+    // threadCount : worker 스레드 수. 0이면 (코어 수 - 1)
+    static JobSystemUPtr Create(uint32_t threadCount = 0);
+    ~JobSystem();
+
+    // counter : job이 끝나면 감소. dependency : 0이 된 후에 job 실행
+    void Submit(Job job, JobCounter *counter = nullptr, JobCounter *dependency = nullptr);
+    // counter가 0이 될 때까지 대기. 기다리는 동안 호출한 스레드도 job을 실행
+    void Wait(JobCounter *counter);
+
+    // [0, count)를 batchSize 단위로 나누어 제출. 완료되면 counter가 0이 됨
+    void SubmitRange(size_t count, size_t batchSize, const RangeJob &job,
+                     JobCounter *counter, JobCounter *dependency = nullptr);
+    // SubmitRange 후 완료까지 대기. batchSize가 0이면 스레드 수에 맞춰 자동 결정
+    void ParallelFor(size_t count, const RangeJob &job, size_t batchSize = 0);
+
+    // 호출한 스레드를 포함한 전체 실행 스레드 수
+    uint32_t GetThreadCount() const { return (uint32_t)m_threads.size() + 1; }
+
+private:
+    JobSystem() {}
+    void Init(uint32_t threadCount);
+    void WorkerLoop(uint32_t queueIndex);
+    bool TryRunJob(uint32_t queueIndex);
+    uint32_t GetQueueIndex() const;
+    void Enqueue(JobItem item);
+    void Complete(JobCounter *counter);
+
+    struct WorkQueue
+    {
+        std::mutex mutex;
+        std::deque<JobItem> jobs;
+    };
+
+    // 0번 queue는 worker가 아닌 스레드(main 등)가 사용
+    std::vector<std::unique_ptr<WorkQueue>> m_queues;
+    std::vector<std::thread> m_threads;
+    std::atomic<bool> m_running{false};
+    std::atomic<int> m_queuedCount{0};
+    std::mutex m_sleepMutex;
+    std::condition_variable m_wake;
+};
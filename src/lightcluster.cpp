@@ -0,0 +1,187 @@
+#include "lightcluster.h"
+#include <algorithm>
+#include <cfloat>
+#include <chrono>
+#include <cmath>
+
+LightClusterUPtr LightCluster::Create(int tileCountX, int tileCountY, int sliceCount)
+{
+    auto cluster = LightClusterUPtr(new LightCluster());
+    cluster->Init(tileCountX, tileCountY, sliceCount);
+    return std::move(cluster);
+}
+
+void LightCluster::Init(int tileCountX, int tileCountY, int sliceCount)
+{
+    m_tileCountX = tileCountX;
+    m_tileCountY = tileCountY;
+    m_sliceCount = sliceCount;
+
+    int maxTexels = 0;
+    glGetIntegerv(GL_MAX_TEXTURE_BUFFER_SIZE, &maxTexels);
+    m_maxIndexCount = (size_t)maxTexels;
+
+    m_lightData = BufferTexture::Create(GL_RGBA32F, sizeof(glm::vec4));
+    m_clusterData = BufferTexture::Create(GL_RG32UI, sizeof(glm::uvec2));
+    m_lightIndices = BufferTexture::Create(GL_R32UI, sizeof(uint32_t));
+}
+
+int LightCluster::GetSlice(float depth) const
+{
+    if (depth <= m_near)
+        return 0;
+    int slice = (int)(logf(depth / m_near) * m_sliceScale);
+    return glm::clamp(slice, 0, m_sliceCount - 1);
+}
+
+void LightCluster::UpdateBounds(const glm::mat4 &projection, float nearPlane, float farPlane)
+{
+    if (projection == m_projection && nearPlane == m_near && farPlane == m_far && !m_bounds.empty())
+        return;
+    m_projection = projection;
+    m_near = nearPlane;
+    m_far = farPlane;
+    m_sliceScale = (float)m_sliceCount / logf(farPlane / nearPlane);
+
+    // NDC 사각형의 네 모서리를 slice의 앞/뒤 깊이로 되돌려서 AABB를 만듦
+    float p00 = projection[0][0], p11 = projection[1][1];
+    m_bounds.resize((size_t)m_tileCountX * m_tileCountY * m_sliceCount);
+    for (int s = 0; s < m_sliceCount; s++)
+    {
+        float depths[2] = {
+            nearPlane * powf(farPlane / nearPlane, (float)s / m_sliceCount),
+            nearPlane * powf(farPlane / nearPlane, (float)(s + 1) / m_sliceCount),
+        };
+        for (int y = 0; y < m_tileCountY; y++)
+        {
+            for (int x = 0; x < m_tileCountX; x++)
+            {
+                float ndcX[2] = {-1.0f + 2.0f * x / m_tileCountX, -1.0f + 2.0f * (x + 1) / m_tileCountX};
+                float ndcY[2] = {-1.0f + 2.0f * y / m_tileCountY, -1.0f + 2.0f * (y + 1) / m_tileCountY};
+                Bounds bounds{glm::vec3(FLT_MAX), glm::vec3(-FLT_MAX)};
+                for (float depth : depths)
+                {
+                    for (float nx : ndcX)
+                    {
+                        for (float ny : ndcY)
+                        {
+                            glm::vec3 corner(nx * depth / p00, ny * depth / p11, -depth);
+                            bounds.min = glm::min(bounds.min, corner);
+                            bounds.max = glm::max(bounds.max, corner);
+                        }
+                    }
+                }
+                m_bounds[((size_t)s * m_tileCountY + y) * m_tileCountX + x] = bounds;
+            }
+        }
+    }
+}
+
+void LightCluster::Update(const std::vector<DeferLight> &lights, const glm::mat4 &view, const glm::mat4 &projection,
+                          float nearPlane, float farPlane, bool clustered)
+{
+    auto start = std::chrono::steady_clock::now();
+    UpdateBounds(projection, nearPlane, farPlane);
+
+    float p00 = projection[0][0], p11 = projection[1][1];
+    m_lightTexels.resize(lights.size() * 3);
+    m_pairs.clear();
+    m_pairLights.clear();
+    for (size_t i = 0; i < lights.size(); i++)
+    {
+        auto &light = lights[i];
+        m_lightTexels[i * 3 + 0] = glm::vec4(light.position, light.radius);
+        m_lightTexels[i * 3 + 1] = glm::vec4(light.color, 0.0f);
+        m_lightTexels[i * 3 + 2] = glm::vec4(light.attenuation, 0.0f);
+
+        float r = light.radius;
+        if (!clustered || r <= 0.0f)
+            continue;
+        glm::vec3 center = glm::vec3(view * glm::vec4(light.position, 1.0f));
+        float minDepth = -center.z - r;
+        float maxDepth = -center.z + r;
+        if (maxDepth < m_near || minDepth > m_far)
+            continue;
+        minDepth = glm::max(minDepth, m_near);
+        maxDepth = glm::min(maxDepth, m_far);
+
+        // 구를 감싸는 AABB(깊이는 near~far로 자름)의 꼭짓점을 투영해서 화면 범위를 구함
+        glm::vec2 ndcMin(FLT_MAX), ndcMax(-FLT_MAX);
+        for (float depth : {minDepth, maxDepth})
+        {
+            for (float x : {center.x - r, center.x + r})
+            {
+                for (float y : {center.y - r, center.y + r})
+                {
+                    glm::vec2 ndc(x * p00 / depth, y * p11 / depth);
+                    ndcMin = glm::min(ndcMin, ndc);
+                    ndcMax = glm::max(ndcMax, ndc);
+                }
+            }
+        }
+        if (ndcMax.x < -1.0f || ndcMin.x > 1.0f || ndcMax.y < -1.0f || ndcMin.y > 1.0f)
+            continue;
+
+        int x0 = glm::clamp((int)floorf((ndcMin.x + 1.0f) * 0.5f * m_tileCountX), 0, m_tileCountX - 1);
+        int x1 = glm::clamp((int)floorf((ndcMax.x + 1.0f) * 0.5f * m_tileCountX), 0, m_tileCountX - 1);
+        int y0 = glm::clamp((int)floorf((ndcMin.y + 1.0f) * 0.5f * m_tileCountY), 0, m_tileCountY - 1);
+        int y1 = glm::clamp((int)floorf((ndcMax.y + 1.0f) * 0.5f * m_tileCountY), 0, m_tileCountY - 1);
+        int s0 = GetSlice(minDepth);
+        int s1 = GetSlice(maxDepth);
+        for (int s = s0; s <= s1; s++)
+        {
+            for (int y = y0; y <= y1; y++)
+            {
+                for (int x = x0; x <= x1; x++)
+                {
+                    uint32_t index = ((uint32_t)s * m_tileCountY + y) * m_tileCountX + x;
+                    auto &bounds = m_bounds[index];
+                    // 구와 AABB의 최단 거리
+                    glm::vec3 closest = glm::clamp(center, bounds.min, bounds.max);
+                    glm::vec3 delta = closest - center;
+                    if (glm::dot(delta, delta) > r * r)
+                        continue;
+                    m_pairs.push_back(index);
+                    m_pairLights.push_back((uint32_t)i);
+                }
+            }
+        }
+    }
+
+    if (m_maxIndexCount > 0 && m_pairs.size() > m_maxIndexCount)
+    {
+        SPDLOG_WARN("light cluster index list truncated: {} > {}", m_pairs.size(), m_maxIndexCount);
+        m_pairs.resize(m_maxIndexCount);
+        m_pairLights.resize(m_maxIndexCount);
+    }
+
+    // cluster 번호로 counting sort. 같은 cluster 안에서는 광원 번호 순서가 유지됨
+    m_clusters.assign(m_bounds.size(), glm::uvec2(0));
+    for (auto index : m_pairs)
+        m_clusters[index].y++;
+    uint32_t offset = 0;
+    m_maxLightsPerCluster = 0;
+    for (auto &cluster : m_clusters)
+    {
+        cluster.x = offset;
+        offset += cluster.y;
+        m_maxLightsPerCluster = std::max(m_maxLightsPerCluster, (int)cluster.y);
+        cluster.y = 0;
+    }
+    m_indices.resize(m_pairs.size());
+    for (size_t i = 0; i < m_pairs.size(); i++)
+    {
+        auto &cluster = m_clusters[m_pairs[i]];
+        m_indices[cluster.x + cluster.y++] = m_pairLights[i];
+    }
+
+    m_lightData->Update(m_lightTexels.data(), m_lightTexels.size());
+    if (clustered)
+    {
+        m_clusterData->Update(m_clusters.data(), m_clusters.size());
+        m_lightIndices->Update(m_indices.data(), m_indices.size());
+    }
+
+    auto end = std::chrono::steady_clock::now();
+    m_buildTime = std::chrono::duration<float, std::milli>(end - start).count();
+}
@@ -0,0 +1,78 @@
+#pragma once
+
+#include "common.h"
+#include "texture.h"
+#include <vector>
+
+struct DeferLight
+{
+    glm::vec3 position;
+    glm::vec3 color;
+    glm::vec3 attenuation{1.0f, 0.0f, 0.0f}; // kc, kl, kq (GetAttenuationCoeff)
+    float radius{0.0f};                      // 영향 반경 (GetAttenuationRadius)
+};
+
+// clustered shading : view frustum을 화면 tile x 깊이 slice(froxel)로 나누고
+// 각 cluster에 닿는 광원 목록을 CPU에서 만들어 texture buffer로 넘김
+// 조명 pass는 픽셀이 속한 cluster의 광원만 계산하므로 비용이 픽셀당 광원 수에 비례
+//   lightData    (RGBA32F) : 광원마다 3 texel. (position, radius), (color, 0), (attenuation, 0)
+//   clusterData  (RG32UI)  : cluster마다 (lightIndices의 시작 위치, 광원 수)
+//   lightIndices (R32UI)   : cluster별 광원 번호를 이어 붙인 목록
+CLASS_PTR(LightCluster)
+class LightCluster
+{
+public:
+    static LightClusterUPtr Create(int tileCountX = 16, int tileCountY = 9, int sliceCount = 24);
+    ~LightCluster() = default;
+
+    // projection은 대칭 원근 투영이어야 함. near ~ far 사이를 지수 간격 slice로 나눔
+    // clustered가 false면 광원 데이터만 올리고 cluster는 만들지 않음 (전체 광원 loop 비교용)
+    void Update(const std::vector<DeferLight> &lights, const glm::mat4 &view, const glm::mat4 &projection,
+                float nearPlane, float farPlane, bool clustered = true);
+
+    const BufferTexture *GetLightData() const { return m_lightData.get(); }
+    const BufferTexture *GetClusterData() const { return m_clusterData.get(); }
+    const BufferTexture *GetLightIndices() const { return m_lightIndices.get(); }
+
+    glm::ivec3 GetGridSize() const { return glm::ivec3(m_tileCountX, m_tileCountY, m_sliceCount); }
+    // 셰이더에서 slice = log(depth / near) * scale
+    glm::vec2 GetDepthParams() const { return glm::vec2(m_near, m_sliceScale); }
+
+    size_t GetIndexCount() const { return m_indices.size(); }
+    int GetMaxLightsPerCluster() const { return m_maxLightsPerCluster; }
+    float GetBuildTime() const { return m_buildTime; } // ms
+
+private:
+    LightCluster() {}
+    void Init(int tileCountX, int tileCountY, int sliceCount);
+    void UpdateBounds(const glm::mat4 &projection, float nearPlane, float farPlane);
+    int GetSlice(float depth) const;
+
+    struct Bounds
+    {
+        glm::vec3 min;
+        glm::vec3 max;
+    };
+
+    int m_tileCountX{16};
+    int m_tileCountY{9};
+    int m_sliceCount{24};
+    float m_near{0.0f};
+    float m_far{0.0f};
+    float m_sliceScale{0.0f};
+    glm::mat4 m_projection{0.0f};
+    std::vector<Bounds> m_bounds; // cluster별 view space AABB. 투영이 바뀔 때만 다시 계산
+
+    std::vector<glm::vec4> m_lightTexels;
+    std::vector<uint32_t> m_pairs; // 광원마다 닿는 cluster 번호 (광원 순서대로)
+    std::vector<uint32_t> m_pairLights;
+    std::vector<glm::uvec2> m_clusters;
+    std::vector<uint32_t> m_indices;
+    size_t m_maxIndexCount{0};
+    int m_maxLightsPerCluster{0};
+    float m_buildTime{0.0f};
+
+    BufferTextureUPtr m_lightData;
+    BufferTextureUPtr m_clusterData;
+    BufferTextureUPtr m_lightIndices;
+};
@@ -1,5 +1,9 @@
 #include "common.h"
 #include "context.h"
+#include "timer.h"
+#include "headless.h"
+#include "capture.h"
+#include <cstdlib>
 #include <imgui_impl_glfw.h>
 #include <imgui_impl_opengl3.h>
 
@@ -54,10 +58,131 @@ void OnScroll(GLFWwindow *window, double xoffset, double yoffset)
     ImGui_ImplGlfw_ScrollCallback(window, xoffset, yoffset);
 }
 
+// 사용법 : ComputerGraphics [--headless] [--frames N] [--warmup N] [--width W] [--height H]
+//                          [--seed S] [--boxes N] [--grass N] [--lights N] [--light-range R] [--models N] [--flythrough]
+//                          [--lighting fullscreen|clustered|volume] [--depth-prepass]
+//                          [--ssao full|half|quarter] [--ssao-blur box|gaussian|bilateral]
+//                          [--ssao-mode hemisphere|gtao] [--ssao-temporal]
+//                          [--directional-light] [--shadow-cascades 0-4]
+//                          [--capture FILE] [--replay FILE] [--capture-diff FILE_A FILE_B]
+// --capture : headless 실행의 마지막 프레임을 저장 (윈도우 실행은 profiler 창의 capture frame 버튼)
+// --replay : 저장한 프레임을 headless로 반복 재생
+// --capture-diff : 두 캡처 파일의 명령 호출 횟수 비교
 int main(int argc, const char **argv)
 {
     SPDLOG_INFO("Hello, OpenGL!");
 
+    bool headless = false;
+    HeadlessOption option;
+    std::string replayFile;
+    std::vector<std::string> diffFiles;
+    for (int i = 1; i < argc; i++)
+    {
+        std::string arg = argv[i];
+        bool hasValue = i + 1 < argc;
+        if (arg == "--headless")
+            headless = true;
+        else if (arg == "--frames" && hasValue)
+            option.frameCount = atoi(argv[++i]);
+        else if (arg == "--warmup" && hasValue)
+            option.warmupFrames = atoi(argv[++i]);
+        else if (arg == "--width" && hasValue)
+            option.width = atoi(argv[++i]);
+        else if (arg == "--height" && hasValue)
+            option.height = atoi(argv[++i]);
+        else if (arg == "--seed" && hasValue)
+            option.scene.seed = (uint32_t)atoi(argv[++i]);
+        else if (arg == "--boxes" && hasValue)
+            option.scene.boxCount = atoi(argv[++i]);
+        else if (arg == "--grass" && hasValue)
+            option.scene.grassCount = atoi(argv[++i]);
+        else if (arg == "--lights" && hasValue)
+            option.scene.lightCount = atoi(argv[++i]);
+        else if (arg == "--light-range" && hasValue)
+            option.scene.lightRange = (float)atof(argv[++i]);
+        else if (arg == "--lighting" && hasValue)
+        {
+            std::string mode = argv[++i];
+            if (mode == "fullscreen")
+                option.scene.lightingMode = DeferredLightingMode::FullScreen;
+            else if (mode == "clustered")
+                option.scene.lightingMode = DeferredLightingMode::Clustered;
+            else if (mode == "volume")
+                option.scene.lightingMode = DeferredLightingMode::LightVolume;
+            else
+                SPDLOG_WARN("unknown lighting mode: {}", mode);
+        }
+        else if (arg == "--ssao" && hasValue)
+        {
+            std::string resolution = argv[++i];
+            if (resolution == "full")
+                option.scene.ssaoResolution = SsaoResolution::Full;
+            else if (resolution == "half")
+                option.scene.ssaoResolution = SsaoResolution::Half;
+            else if (resolution == "quarter")
+                option.scene.ssaoResolution = SsaoResolution::Quarter;
+            else
+                SPDLOG_WARN("unknown ssao resolution: {}", resolution);
+        }
+        else if (arg == "--ssao-blur" && hasValue)
+        {
+            std::string blur = argv[++i];
+            if (blur == "box")
+                option.scene.ssaoBlur = SsaoBlur::Box;
+            else if (blur == "gaussian")
+                option.scene.ssaoBlur = SsaoBlur::Gaussian;
+            else if (blur == "bilateral")
+                option.scene.ssaoBlur = SsaoBlur::Bilateral;
+            else
+                SPDLOG_WARN("unknown ssao blur: {}", blur);
+        }
+        else if (arg == "--ssao-mode" && hasValue)
+        {
+            std::string mode = argv[++i];
+            if (mode == "hemisphere")
+                option.scene.ssaoMode = SsaoMode::Hemisphere;
+            else if (mode == "gtao")
+                option.scene.ssaoMode = SsaoMode::Horizon;
+            else
+                SPDLOG_WARN("unknown ssao mode: {}", mode);
+        }
+        else if (arg == "--ssao-temporal")
+            option.scene.ssaoTemporal = true;
+        else if (arg == "--directional-light")
+            option.scene.directionalLight = true;
+        else if (arg == "--shadow-cascades" && hasValue)
+            option.scene.shadowCascades = atoi(argv[++i]);
+        else if (arg == "--depth-prepass")
+            option.scene.depthPrepass = true;
+        else if (arg == "--models" && hasValue)
+            option.scene.modelCount = atoi(argv[++i]);
+        else if (arg == "--flythrough")
+            option.cameraPath = CameraPath::FlyThrough;
+        else if (arg == "--capture" && hasValue)
+            option.captureFile = argv[++i];
+        else if (arg == "--replay" && hasValue)
+            replayFile = argv[++i];
+        else if (arg == "--capture-diff" && i + 2 < argc)
+        {
+            diffFiles.push_back(argv[++i]);
+            diffFiles.push_back(argv[++i]);
+        }
+        else
+            SPDLOG_WARN("unknown argument: {}", arg);
+    }
+    if (!diffFiles.empty())
+    {
+        CaptureData a, b;
+        if (!a.Load(diffFiles[0]) || !b.Load(diffFiles[1]))
+            return -1;
+        CaptureStats::PrintDiff(CaptureStats::Compute(a), CaptureStats::Compute(b));
+        return 0;
+    }
+    if (!replayFile.empty())
+        return RunReplay(option, replayFile);
+    if (headless)
+        return RunHeadless(option);
+
     // glfw 라이브러리 초기화, 실패하면 에러 출력후 종료
     SPDLOG_INFO("Initialize glfw");
     if (!glfwInit())
@@ -104,7 +229,7 @@ int main(int argc, const char **argv)
     ImGui_ImplOpenGL3_CreateFontsTexture();
     ImGui_ImplOpenGL3_CreateDeviceObjects();
 
-    auto context = Context::Create();
+    auto context = Context::Create(option.scene);
     if (!context)
     {
         SPDLOG_ERROR("failed to create context");
@@ -123,16 +248,18 @@ int main(int argc, const char **argv)
 
     // glfw 루프 실행, 윈도우 close 버튼을 누르면 정상 종료
     SPDLOG_INFO("Start main loop");
+    auto timer = Timer::Create();
     while (!glfwWindowShouldClose(window))
     {
         glfwPollEvents();
+        timer->Tick();
 
         // GLFWwindow로부터 화면 크기 및 마우스 상태 등을 업데이트
         ImGui_ImplGlfw_NewFrame();
         ImGui::NewFrame();
 
         context->ProcessInput(window);
-        context->Render();
+        context->Render(*timer);
 
         ImGui::Render();
         ImGui_ImplOpenGL3_RenderDrawData(ImGui::GetDrawData());
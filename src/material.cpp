@@ -28,12 +28,25 @@ void Material::Apply()
 {
     program->Use();
 
+    // 다른 material이 이 program의 uniform을 바꿨을 수 있으면 static 값도 다시 올림
+    if (staticDirty || program->GetLastMaterial() != id)
+    {
+        for (auto &property : staticTable)
+        {
+            visit([&](const auto &value)
+                  { program->SetUniform(property.first, value); },
+                  property.second);
+        }
+        staticDirty = false;
+    }
+    program->SetLastMaterial(id);
+
     int textureNum = 0;
 
-    for (auto property : propertyTable)
+    for (auto &property : propertyTable)
     {
-        auto value = property.second;
-        string key = property.first;
+        auto &value = property.second;
+        auto &key = property.first;
         visit(overloaded{
                   [&](auto p)
                   { program->SetUniform(key, p); },
@@ -58,6 +71,12 @@ void Material::SetProperty(string key, FieldType value)
     propertyTable[key] = value;
 }
 
+void Material::SetStaticProperty(string key, StaticFieldType value)
+{
+    staticTable[key] = std::move(value);
+    staticDirty = true;
+}
+
 void TextureMaterial::ApplyTexture(string key, TexturePtr tex, int textureNum)
 {
     // alpha blend
@@ -74,7 +93,7 @@ void TextureMaterial::ApplyTexture(string key, TexturePtr tex, int textureNum)
 TextureMaterial::TextureMaterial(const ProgramPtr &_program)
 {
     program = _program;
-    InitProperty({"transform", "modelTransform", "tex"});
+    InitProperty({"transform", "modelTransform", "tex", "time"});
 }
 
 NormalMapMaterial::NormalMapMaterial(const ProgramPtr &_program)
@@ -91,27 +110,56 @@ CubemapMaterial::CubemapMaterial(const ProgramPtr &_program)
                   "cameraPos", "skybox"});
 }
 
-DeferredMaterial::DeferredMaterial(const ProgramPtr &_program, const int &lightSize)
+DeferredMaterial::DeferredMaterial(const ProgramPtr &_program)
 {
     program = _program;
-    vector<string> p = {"transform", "modelTransform", "gPosition", "gNormal", "gAlbedoSpec", "ssao", "useSsao"};
-    for (size_t i = 0; i < lightSize; i++)
-    {
-        p.push_back(fmt::format("lights[{}].position", i));
-        p.push_back(fmt::format("lights[{}].color", i));
-    }
+    InitProperty({"transform", "modelTransform", "gDepth", "gNormal", "gAlbedoSpec", "ssao", "useSsao",
+                  "viewPos", "view", "inverseViewProjection", "lightData", "lightCount", "useClusters", "clusterData", "lightIndices",
+                  "clusterGrid", "clusterTileSize", "clusterDepthParams"});
+}
 
-    InitProperty(p);
+LightVolumeMaterial::LightVolumeMaterial(const ProgramPtr &_program)
+{
+    program = _program;
+    InitProperty({"viewProjection", "inverseViewProjection", "volumeScale", "gDepth", "gNormal", "gAlbedoSpec",
+                  "lightData", "screenSize"});
+}
+
+BlurMaterial::BlurMaterial(const ProgramPtr &_program)
+{
+    program = _program;
+    InitProperty({"transform", "modelTransform", "tex", "direction"});
 }
 
 SSAOMaterial::SSAOMaterial(const ProgramPtr &_program)
 {
     program = _program;
-    vector<string> keys = {"transform", "modelTransform", "gPosition",
-                           "gNormal", "view", "texNoise", "noiseScale", "radius"};
+    // samples, noiseScale, radius는 SetStaticProperty로 설정
+    InitProperty({"transform", "modelTransform", "linearDepth", "gNormal", "view", "projection",
+                  "downsample", "texNoise", "sampleOffset", "sampleCount", "temporalJitter"});
+}
+
+SSAODepthMaterial::SSAODepthMaterial(const ProgramPtr &_program)
+{
+    program = _program;
+    InitProperty({"transform", "gDepth", "projection", "downsample"});
+}
+
+SSAODepthMipMaterial::SSAODepthMipMaterial(const ProgramPtr &_program)
+{
+    program = _program;
+    InitProperty({"transform", "linearDepth"});
+}
 
-    for (size_t i = 0; i < 100; i++)
-        keys.push_back(fmt::format("samples[{}]", i));
+SSAOTemporalMaterial::SSAOTemporalMaterial(const ProgramPtr &_program)
+{
+    program = _program;
+    InitProperty({"transform", "current", "history", "historyValid", "reprojection", "projection",
+                  "screenSize", "downsample"});
+}
 
-    InitProperty(keys);
+SSAOUpsampleMaterial::SSAOUpsampleMaterial(const ProgramPtr &_program)
+{
+    program = _program;
+    InitProperty({"transform", "ssaoInput", "linearDepth", "gDepth", "projection", "downsample"});
 }
\ No newline at end of file
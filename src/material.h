@@ -11,6 +11,8 @@ using namespace std;
 using namespace glm;
 
 using FieldType = variant<monostate, int, float, vec2, vec3, vec4, mat4, TexturePtr>;
+// 값이 바뀔 때만 program에 올리는 uniform. uniform은 program에 남으므로 텍스처(unit 바인딩)는 제외
+using StaticFieldType = variant<int, float, vec2, vec3, vec4, mat4, vector<vec3>>;
 
 CLASS_PTR(Material)
 class Material
@@ -19,6 +21,10 @@ protected:
 protected:
     ProgramPtr program;
     unordered_map<string, FieldType> propertyTable; // value : (type - value)
+    unordered_map<string, StaticFieldType> staticTable;
+    bool staticDirty{false};
+    uint32_t id{++s_materialCount}; // program의 마지막 material 비교용 (0은 없음)
+    static inline uint32_t s_materialCount{0};
 
     void InitProperty(vector<string> propertyNames);
     virtual void ApplyTexture(string key, TexturePtr tex, int textureNum);
@@ -29,7 +35,11 @@ public:
     ~Material() = default;
     void Apply();
 
+    // 매 프레임 Apply할 때마다 올림
     void SetProperty(string key, FieldType value);
+    // kernel 배열, 해상도에 따른 scale처럼 가끔 바뀌는 값. 바뀌었거나 다른 material이
+    // 같은 program을 사용한 뒤에만 다시 올림
+    void SetStaticProperty(string key, StaticFieldType value);
 };
 
 CLASS_PTR(TextureMaterial)
@@ -63,10 +73,27 @@ CLASS_PTR(DeferredMaterial)
 class DeferredMaterial : public Material
 {
 public:
-    DeferredMaterial(const ProgramPtr &_program, const int &lightSize);
+    DeferredMaterial(const ProgramPtr &_program);
     ~DeferredMaterial() = default;
 };
 
+CLASS_PTR(LightVolumeMaterial)
+class LightVolumeMaterial : public Material
+{
+public:
+    LightVolumeMaterial(const ProgramPtr &_program);
+    ~LightVolumeMaterial() = default;
+};
+
+// 방향을 가진 separable blur (blur_separable.fs, blur_bilateral.fs). 가로, 세로 두 번 그림
+CLASS_PTR(BlurMaterial)
+class BlurMaterial : public Material
+{
+public:
+    BlurMaterial(const ProgramPtr &_program);
+    ~BlurMaterial() = default;
+};
+
 CLASS_PTR(SSAOMaterial)
 class SSAOMaterial : public Material
 {
@@ -74,3 +101,35 @@ public:
     SSAOMaterial(const ProgramPtr &_program);
     ~SSAOMaterial() = default;
 };
+
+CLASS_PTR(SSAODepthMaterial)
+class SSAODepthMaterial : public Material
+{
+public:
+    SSAODepthMaterial(const ProgramPtr &_program);
+    ~SSAODepthMaterial() = default;
+};
+
+CLASS_PTR(SSAODepthMipMaterial)
+class SSAODepthMipMaterial : public Material
+{
+public:
+    SSAODepthMipMaterial(const ProgramPtr &_program);
+    ~SSAODepthMipMaterial() = default;
+};
+
+CLASS_PTR(SSAOTemporalMaterial)
+class SSAOTemporalMaterial : public Material
+{
+public:
+    SSAOTemporalMaterial(const ProgramPtr &_program);
+    ~SSAOTemporalMaterial() = default;
+};
+
+CLASS_PTR(SSAOUpsampleMaterial)
+class SSAOUpsampleMaterial : public Material
+{
+public:
+    SSAOUpsampleMaterial(const ProgramPtr &_program);
+    ~SSAOUpsampleMaterial() = default;
+};
@@ -1,4 +1,7 @@
 #include "mesh.h"
+#include "capture.h"
+#include "renderstats.h"
+#include <glm/gtc/constants.hpp>
 
 MeshUPtr Mesh::Create(const std::vector<Vertex> &vertices,
                       const std::vector<uint32_t> &indices, uint32_t primitiveType)
@@ -86,12 +89,32 @@ void Mesh::Init(const std::vector<Vertex> &vertices,
     m_vertexLayout->SetAttrib(1, 3, GL_FLOAT, false, sizeof(Vertex), offsetof(Vertex, normal));
     m_vertexLayout->SetAttrib(2, 2, GL_FLOAT, false, sizeof(Vertex), offsetof(Vertex, texCoord));
     m_vertexLayout->SetAttrib(3, 3, GL_FLOAT, false, sizeof(Vertex), offsetof(Vertex, tangent));
+
+    // depth만 그리는 pass는 vertex fetch 양을 줄이도록 position만 따로 모은 stream 사용
+    std::vector<glm::vec3> positions(vertices.size());
+    for (size_t i = 0; i < vertices.size(); i++)
+        positions[i] = vertices[i].position;
+    m_positionLayout = VertexLayout::Create();
+    m_positionBuffer = Buffer::CreateWithData(GL_ARRAY_BUFFER, GL_STATIC_DRAW,
+                                              positions.data(), sizeof(glm::vec3), positions.size());
+    m_positionLayout->SetAttrib(0, 3, GL_FLOAT, false, sizeof(glm::vec3), 0);
+    m_indexBuffer->Bind(); // 새 VAO에 index buffer 연결
 }
 
 void Mesh::Draw() const
 {
     m_vertexLayout->Bind();
     glDrawElements(m_primitiveType, m_indexBuffer->GetCount(), GL_UNSIGNED_INT, 0);
+    FrameCapture::RecordDraw(m_primitiveType, m_indexBuffer->GetCount(), GL_UNSIGNED_INT, 0);
+    RenderStats::AddDraw(m_primitiveType, m_indexBuffer->GetCount());
+}
+
+void Mesh::DrawPositionOnly() const
+{
+    m_positionLayout->Bind();
+    glDrawElements(m_primitiveType, m_indexBuffer->GetCount(), GL_UNSIGNED_INT, 0);
+    FrameCapture::RecordDraw(m_primitiveType, m_indexBuffer->GetCount(), GL_UNSIGNED_INT, 0);
+    RenderStats::AddDraw(m_primitiveType, m_indexBuffer->GetCount());
 }
 
 void Mesh::Draw(const VertexLayout *VAO, size_t instanceCnt) const
@@ -99,6 +122,8 @@ void Mesh::Draw(const VertexLayout *VAO, size_t instanceCnt) const
     VAO->Bind();
     glDrawElementsInstanced(GL_TRIANGLES, m_indexBuffer->GetCount(),
                             GL_UNSIGNED_INT, 0, instanceCnt);
+    FrameCapture::RecordDraw(GL_TRIANGLES, m_indexBuffer->GetCount(), GL_UNSIGNED_INT, 0, instanceCnt);
+    RenderStats::AddDraw(GL_TRIANGLES, m_indexBuffer->GetCount(), instanceCnt);
 }
 
 MeshUPtr Mesh::CreateBox()
@@ -148,6 +173,45 @@ MeshUPtr Mesh::CreateBox()
     return Create(vertices, indices, GL_TRIANGLES);
 }
 
+MeshUPtr Mesh::CreateSphere(uint32_t latiSegmentCount, uint32_t longiSegmentCount)
+{
+    uint32_t circleVertCount = longiSegmentCount + 1;
+    std::vector<Vertex> vertices((latiSegmentCount + 1) * circleVertCount);
+    for (uint32_t i = 0; i <= latiSegmentCount; i++)
+    {
+        float v = (float)i / (float)latiSegmentCount;
+        float phi = (v - 0.5f) * glm::pi<float>();
+        float cosPhi = cosf(phi);
+        float sinPhi = sinf(phi);
+        for (uint32_t j = 0; j <= longiSegmentCount; j++)
+        {
+            float u = (float)j / (float)longiSegmentCount;
+            float theta = u * glm::pi<float>() * 2.0f;
+            glm::vec3 point(cosPhi * cosf(theta), sinPhi, -cosPhi * sinf(theta));
+            vertices[i * circleVertCount + j] = Vertex{point, point, glm::vec2(u, v), glm::vec3(0.0f)};
+        }
+    }
+
+    // 바깥에서 봤을 때 반시계 방향
+    std::vector<uint32_t> indices;
+    indices.reserve(latiSegmentCount * longiSegmentCount * 6);
+    for (uint32_t i = 0; i < latiSegmentCount; i++)
+    {
+        for (uint32_t j = 0; j < longiSegmentCount; j++)
+        {
+            uint32_t vertexOffset = i * circleVertCount + j;
+            indices.push_back(vertexOffset);
+            indices.push_back(vertexOffset + 1);
+            indices.push_back(vertexOffset + 1 + circleVertCount);
+            indices.push_back(vertexOffset + 1 + circleVertCount);
+            indices.push_back(vertexOffset + circleVertCount);
+            indices.push_back(vertexOffset);
+        }
+    }
+
+    return Create(vertices, indices, GL_TRIANGLES);
+}
+
 MeshUPtr Mesh::CreatePlane()
 {
     std::vector<Vertex> vertices = {
@@ -28,6 +28,8 @@ public:
     static void ComputeTangents(std::vector<Vertex> &vertices, const std::vector<uint32_t> &indices);
     static MeshUPtr Mesh::CreateBox();
     static MeshUPtr CreatePlane();
+    // 반지름 1인 구. 꼭짓점이 구 위에 있으므로 면은 구보다 약간 안쪽에 있음
+    static MeshUPtr CreateSphere(uint32_t latiSegmentCount = 16, uint32_t longiSegmentCount = 32);
     static MeshUPtr MakeBox();
 
     const VertexLayout *GetVertexLayout()
@@ -38,6 +40,8 @@ public:
 
     void Draw() const;
     void Draw(const VertexLayout *VAO, size_t instanceCnt) const;
+    // position만 읽는 VAO로 그림 (depth pre-pass 등 depth만 필요한 pass)
+    void DrawPositionOnly() const;
 
 private:
     Mesh() {}
@@ -49,5 +53,7 @@ private:
     VertexLayoutUPtr m_vertexLayout; // VAO
     BufferUPtr m_vertexBuffer;       // VBO
     BufferUPtr m_indexBuffer;        // IBO
+    VertexLayoutUPtr m_positionLayout; // position만 연결한 VAO (index buffer는 공유)
+    BufferUPtr m_positionBuffer;       // position만 모아 둔 VBO
     MaterialPtr m_material;
 };
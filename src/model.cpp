@@ -113,3 +113,11 @@ void Model::Render(const mat4 &view, const mat4 &projection, const MaterialPtr &
         mesh->Draw();
     }
 }
+
+void Model::RenderPositionOnly(const mat4 &view, const mat4 &projection, const MaterialPtr &mat)
+{
+    mat->SetProperty("transform", projection * view * this->transform.GetTransform());
+    mat->Apply();
+    for (auto &data : meshDatas)
+        data.first->DrawPositionOnly();
+}
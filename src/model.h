@@ -18,6 +18,12 @@ public:
 
     void Render(const mat4 &view, const mat4 &projection,
                 const MaterialPtr &optionMat = nullptr);
+    // 텍스처 없이 position만 그림. material은 transform만 사용
+    void RenderPositionOnly(const mat4 &view, const mat4 &projection, const MaterialPtr &mat);
+
+    // 같은 메쉬를 여러 위치에 그릴 때 사용
+    const Transform &GetTransform() const { return transform; }
+    void SetTransform(const Transform &_trf) { transform = _trf; }
 
 private:
     Transform transform;
@@ -4,14 +4,21 @@
 void Object::ActiveInstancing(size_t size, int atbIndex, int atbCount, int atbDivisor)
 {
     isInstance = true;
+    instanceAtbIndex = atbIndex;
+    instanceAtbCount = atbCount;
+    instanceAtbDivisor = atbDivisor;
 
-    positions.resize(size);
-    for (size_t i = 0; i < positions.size(); i++)
+    instances = InstanceSet::Create(size);
+    for (size_t i = 0; i < size; i++)
     {
-        positions[i].x = ((float)rand() / (float)RAND_MAX * 2.0f - 1.0f) * 5.0f;
-        positions[i].z = ((float)rand() / (float)RAND_MAX * 2.0f - 1.0f) * 5.0f;
-        positions[i].y = glm::radians((float)rand() / (float)RAND_MAX * 360.0f);
+        vec4 data(0.0f);
+        data.x = RandomRange(-5.0f, 5.0f);
+        data.z = RandomRange(-5.0f, 5.0f);
+        data.y = glm::radians(RandomRange(0.0f, 360.0f));
+        instances->Add(data);
     }
+    instances->Upload(true);
+
     instanceVAO = VertexLayout::Create(); // VAO
     instanceVAO->Bind();
 
@@ -21,15 +28,19 @@ void Object::ActiveInstancing(size_t size, int atbIndex, int atbCount, int atbDi
     instanceVAO->SetAttrib(2, 2, GL_FLOAT, GL_FALSE, sizeof(Vertex), offsetof(Vertex, texCoord));
     instanceVAO->SetAttrib(3, 3, GL_FLOAT, false, sizeof(Vertex), offsetof(Vertex, tangent));
 
-    posBuffer = Buffer::CreateWithData(GL_ARRAY_BUFFER, GL_STATIC_DRAW,
-                                       positions.data(), sizeof(glm::vec3), positions.size());
-    posBuffer->Bind();
-    instanceVAO->SetAttrib(atbIndex, atbCount, GL_FLOAT, GL_FALSE, sizeof(glm::vec3), 0);
-    // index번 Attribute는 인스턴스가 divisor번 바뀔때마다 변경
-    glVertexAttribDivisor(atbIndex, atbDivisor);
+    BindInstanceBuffer();
     mesh->BindIndexBuffer();
 }
 
+void Object::BindInstanceBuffer()
+{
+    instanceVAO->Bind();
+    instances->GetBuffer()->Bind();
+    instanceVAO->SetAttrib(instanceAtbIndex, instanceAtbCount, GL_FLOAT, GL_FALSE, sizeof(glm::vec4), 0);
+    // index번 Attribute는 인스턴스가 divisor번 바뀔때마다 변경
+    glVertexAttribDivisor(instanceAtbIndex, instanceAtbDivisor);
+}
+
 void Object::Update(const Camera &cam)
 {
     Update(cam.view, cam.projection);
@@ -50,7 +61,12 @@ void Object::Draw()
         currentMaterial->Apply();
 
     if (isInstance)
-        mesh->Draw(instanceVAO.get(), posBuffer->GetCount());
+    {
+        // 버퍼가 재할당된 경우 attribute가 새 버퍼를 가리키도록 다시 설정
+        if (instances->Upload())
+            BindInstanceBuffer();
+        mesh->Draw(instanceVAO.get(), instances->GetDrawCount());
+    }
     else
         mesh->Draw();
 }
@@ -97,46 +113,149 @@ void Wall::Render(const Camera &cam, const vec3 &lightPos, const MaterialPtr &op
     Draw();
 }
 
-void DeferredPlane::Render(const Camera &cam, const FramebufferPtr &gepBuf,const FramebufferPtr &blurBuf, const vector<DeferLight> &_lights, bool useSsao)
+void DeferredPlane::Render(const Camera &cam, const FramebufferPtr &gepBuf, const FramebufferPtr &blurBuf,
+                           const LightCluster &cluster, int lightCount, bool useClusters, bool useSsao)
 {
-    currentMaterial->SetProperty("gPosition", gepBuf->GetColorAttachment(0));
-    currentMaterial->SetProperty("gNormal", gepBuf->GetColorAttachment(1));
-    currentMaterial->SetProperty("gAlbedoSpec", gepBuf->GetColorAttachment(2));
-
-    for (size_t i = 0; i < _lights.size(); i++)
-    {
-        auto posName = fmt::format("lights[{}].position", i);
-        auto colorName = fmt::format("lights[{}].color", i);
-        currentMaterial->SetProperty(posName, _lights[i].position);
-        currentMaterial->SetProperty(colorName, _lights[i].color);
-    }
+    currentMaterial->SetProperty("gDepth", gepBuf->GetDepthAttachment());
+    currentMaterial->SetProperty("gNormal", gepBuf->GetColorAttachment(0));
+    currentMaterial->SetProperty("gAlbedoSpec", gepBuf->GetColorAttachment(1));
+
+    // 광원 정보는 texture buffer로 전달. material 텍스처와 겹치지 않는 slot 사용
+    const int lightDataTexNum = 10;
+    const int clusterDataTexNum = 11;
+    const int lightIndicesTexNum = 12;
+    currentMaterial->SetProperty("lightData", lightDataTexNum);
+    currentMaterial->SetProperty("clusterData", clusterDataTexNum);
+    currentMaterial->SetProperty("lightIndices", lightIndicesTexNum);
+    currentMaterial->SetProperty("lightCount", lightCount);
+    currentMaterial->SetProperty("useClusters", useClusters ? 1 : 0);
+
+    auto gridSize = cluster.GetGridSize();
+    auto target = gepBuf->GetColorAttachment(0);
+    currentMaterial->SetProperty("clusterGrid", vec3(gridSize));
+    currentMaterial->SetProperty("clusterTileSize", vec2((float)target->GetWidth() / gridSize.x,
+                                                         (float)target->GetHeight() / gridSize.y));
+    currentMaterial->SetProperty("clusterDepthParams", cluster.GetDepthParams());
+    currentMaterial->SetProperty("view", cam.view);
+    currentMaterial->SetProperty("inverseViewProjection", glm::inverse(cam.projection * cam.view));
+    currentMaterial->SetProperty("viewPos", cam.Pos);
 
     currentMaterial->SetProperty("ssao", blurBuf->GetColorAttachment());
     currentMaterial->SetProperty("useSsao", useSsao ? 1 : 0);
 
     currentMaterial->SetProperty("transform", trf.GetTransform());
 
+    glActiveTexture(GL_TEXTURE0 + lightDataTexNum);
+    cluster.GetLightData()->Bind();
+    glActiveTexture(GL_TEXTURE0 + clusterDataTexNum);
+    cluster.GetClusterData()->Bind();
+    glActiveTexture(GL_TEXTURE0 + lightIndicesTexNum);
+    cluster.GetLightIndices()->Bind();
+    glActiveTexture(GL_TEXTURE0);
+
     Draw();
 }
 
-void SSAOPlane::Render(const Camera &cam, const FramebufferPtr &buf, const TexturePtr &noiseTex, const vec2 &windowSize,
-                       const float &radius, const vector<vec3> &samples)
+void LightVolumes::Render(const Camera &cam, const FramebufferPtr &gepBuf, const LightCluster &cluster, int lightCount)
+{
+    if (lightCount <= 0)
+        return;
+
+    auto target = gepBuf->GetColorAttachment(0);
+    const int lightDataTexNum = 10;
+    auto viewProjection = cam.projection * cam.view;
+    currentMaterial->SetProperty("viewProjection", viewProjection);
+    currentMaterial->SetProperty("inverseViewProjection", glm::inverse(viewProjection));
+    currentMaterial->SetProperty("volumeScale", volumeScale);
+    currentMaterial->SetProperty("gDepth", gepBuf->GetDepthAttachment());
+    currentMaterial->SetProperty("gNormal", target);
+    currentMaterial->SetProperty("gAlbedoSpec", gepBuf->GetColorAttachment(1));
+    currentMaterial->SetProperty("lightData", lightDataTexNum);
+    currentMaterial->SetProperty("screenSize", vec2((float)target->GetWidth(), (float)target->GetHeight()));
+    currentMaterial->Apply();
+
+    glActiveTexture(GL_TEXTURE0 + lightDataTexNum);
+    cluster.GetLightData()->Bind();
+    glActiveTexture(GL_TEXTURE0);
+
+    // 광원끼리는 더하고, depth는 읽기만 함
+    glEnable(GL_BLEND);
+    glBlendFunc(GL_ONE, GL_ONE);
+    glDepthMask(GL_FALSE);
+    glDepthFunc(GL_GEQUAL);
+    glEnable(GL_CULL_FACE);
+    glCullFace(GL_FRONT); // 카메라가 구 안에 있어도 그려지도록 뒷면만 그림
+
+    mesh->Draw(mesh->GetVertexLayout(), lightCount);
+
+    glCullFace(GL_BACK);
+    glDisable(GL_CULL_FACE);
+    glDepthFunc(GL_LESS);
+    glDepthMask(GL_TRUE);
+    glDisable(GL_BLEND);
+}
+
+void SSAOPlane::Render(const Camera &cam, const FramebufferPtr &gepBuf, const FramebufferPtr &depthBuf,
+                       const TexturePtr &noiseTex, int downsample, int sampleOffset, int sampleCount,
+                       const vec2 &jitter)
 {
-    currentMaterial->SetProperty("gPosition", buf->GetColorAttachment(0));
-    currentMaterial->SetProperty("gNormal", buf->GetColorAttachment(1));
+    currentMaterial->SetProperty("linearDepth", depthBuf->GetColorAttachment());
+    currentMaterial->SetProperty("gNormal", gepBuf->GetColorAttachment(0));
     currentMaterial->SetProperty("texNoise", noiseTex);
-    currentMaterial->SetProperty("noiseScale", vec2((float)windowSize.x / (float)noiseTex->GetWidth(),
-                                                    (float)windowSize.y / (float)noiseTex->GetHeight()));
+    currentMaterial->SetProperty("downsample", downsample);
+    currentMaterial->SetProperty("sampleOffset", sampleOffset);
+    currentMaterial->SetProperty("sampleCount", sampleCount);
+    currentMaterial->SetProperty("temporalJitter", jitter);
 
     currentMaterial->SetProperty("view", cam.view);
+    currentMaterial->SetProperty("projection", cam.projection);
     currentMaterial->SetProperty("transform", trf.GetTransform());
 
-    currentMaterial->SetProperty("radius", radius);
-    for (size_t i = 0; i < samples.size(); i++)
-    {
-        auto sampleName = fmt::format("samples[{}]", i);
-        currentMaterial->SetProperty(sampleName, samples[i]);
-    }
+    Draw();
+}
+
+void SSAODepthPlane::Render(const Camera &cam, const FramebufferPtr &gepBuf, int downsample)
+{
+    currentMaterial->SetProperty("gDepth", gepBuf->GetDepthAttachment());
+    currentMaterial->SetProperty("projection", cam.projection);
+    currentMaterial->SetProperty("downsample", downsample);
+    currentMaterial->SetProperty("transform", trf.GetTransform());
+
+    Draw();
+}
+
+void SSAODepthMipPlane::Render(const TexturePtr &linearDepth)
+{
+    currentMaterial->SetProperty("linearDepth", linearDepth);
+    currentMaterial->SetProperty("transform", trf.GetTransform());
+
+    Draw();
+}
+
+void SSAOTemporalPlane::Render(const Camera &cam, const TexturePtr &current, const HistoryBuffer &history,
+                               const mat4 &reprojection, const vec2 &screenSize, int downsample)
+{
+    currentMaterial->SetProperty("current", current);
+    currentMaterial->SetProperty("history", history.GetHistory());
+    currentMaterial->SetProperty("historyValid", history.IsValid() ? 1 : 0);
+    currentMaterial->SetProperty("reprojection", reprojection);
+    currentMaterial->SetProperty("projection", cam.projection);
+    currentMaterial->SetProperty("screenSize", screenSize);
+    currentMaterial->SetProperty("downsample", downsample);
+    currentMaterial->SetProperty("transform", trf.GetTransform());
+
+    Draw();
+}
+
+void SSAOUpsamplePlane::Render(const Camera &cam, const FramebufferPtr &gepBuf, const FramebufferPtr &depthBuf,
+                               const TexturePtr &ssao, int downsample)
+{
+    currentMaterial->SetProperty("ssaoInput", ssao);
+    currentMaterial->SetProperty("linearDepth", depthBuf->GetColorAttachment());
+    currentMaterial->SetProperty("gDepth", gepBuf->GetDepthAttachment());
+    currentMaterial->SetProperty("projection", cam.projection);
+    currentMaterial->SetProperty("downsample", downsample);
+    currentMaterial->SetProperty("transform", trf.GetTransform());
 
     Draw();
 }
@@ -149,6 +268,15 @@ void BlurPlane::Render(const TexturePtr &tex)
     Draw();
 }
 
+void BlurPlane::Render(const TexturePtr &tex, const vec2 &direction)
+{
+    currentMaterial->SetProperty("transform", trf.GetTransform());
+    currentMaterial->SetProperty("tex", tex);
+    currentMaterial->SetProperty("direction", direction);
+
+    Draw();
+}
+
 void StencilBox::Update(const mat4 &view, const mat4 &projection)
 {
     obj.Update(view, projection);
@@ -4,12 +4,13 @@
 #include "common.h"
 #include "mesh.h"
 #include "framebuffer.h"
+#include "instanceset.h"
 
 using namespace glm;
 using namespace std;
 
 struct Camera;
-struct DeferLight;
+class LightCluster;
 
 CLASS_PTR(Object)
 class Object
@@ -24,10 +25,13 @@ protected:
     MaterialPtr currentMaterial;
 
     bool isInstance = false;
-    vector<vec3> positions;
-    BufferUPtr posBuffer;
+    InstanceSetUPtr instances;
     VertexLayoutUPtr instanceVAO;
+    int instanceAtbIndex{0};
+    int instanceAtbCount{0};
+    int instanceAtbDivisor{0};
     void SetCurrentMaterial(const MaterialPtr &mat) { currentMaterial = mat; };
+    void BindInstanceBuffer();
 
 public:
     Object(){};
@@ -43,6 +47,11 @@ public:
 
 public:
     virtual void ActiveInstancing(size_t size, int atbIndex, int atbCount, int atbDivisor);
+    // 인스턴스 추가/삭제/수정. 변경된 영역만 다음 Draw에서 업로드됨
+    size_t AddInstance(const vec4 &data) { return instances->Add(data); }
+    void RemoveInstance(size_t index) { instances->Remove(index); }
+    void SetInstance(size_t index, const vec4 &data) { instances->Set(index, data); }
+    InstanceSet *GetInstances() { return instances.get(); }
     virtual void Update(const Camera &cam);
     virtual void Update(const mat4 &view, const mat4 &projection);
     virtual void Draw();
@@ -86,8 +95,26 @@ public:
         : Object(_mesh, _trf, _mat){};
     ~DeferredPlane(){};
 
+    // useClusters가 false면 모든 광원을 픽셀마다 계산 (비교용)
     void Render(const Camera &cam, const FramebufferPtr &gepBuf, const FramebufferPtr &blurBuf,
-                const vector<DeferLight> &_lights, bool useSsao);
+                const LightCluster &cluster, int lightCount, bool useClusters, bool useSsao);
+};
+
+// 광원마다 반경 크기의 구를 instancing으로 그려서 구가 덮은 픽셀만 조명을 계산하고 더함
+// 구의 뒷면을 GL_GEQUAL로 그려서 구 뒤쪽이 장면 표면보다 앞에 있는(표면에 닿지 않는) 픽셀은 제외
+// 기본 framebuffer에 ambient 결과와 G-buffer의 depth가 있어야 함
+CLASS_PTR(LightVolumes)
+class LightVolumes : public Object
+{
+public:
+    LightVolumes(MeshPtr &_mesh, MaterialPtr _mat, float _volumeScale)
+        : Object(_mesh, Transform(vec3(0), vec3(0), vec3(1)), _mat), volumeScale(_volumeScale){};
+    ~LightVolumes(){};
+
+    void Render(const Camera &cam, const FramebufferPtr &gepBuf, const LightCluster &cluster, int lightCount);
+
+private:
+    float volumeScale{1.0f};
 };
 
 CLASS_PTR(SSAOPlane)
@@ -98,8 +125,63 @@ public:
         : Object(_mesh, _trf, _mat){};
     ~SSAOPlane(){};
 
-    void Render(const Camera &cam, const FramebufferPtr &buf, const TexturePtr &noiseTex, const vec2 &windowSize,
-                const float &radius, const vector<vec3> &samples);
+    // depthBuf : SSAO 해상도의 linear depth (SSAODepthPlane). 결과도 같은 해상도
+    // kernel(samples), noiseScale, radius는 material의 static property
+    // sampleOffset, sampleCount : 이번 프레임에 사용할 kernel 부분. jitter : 프레임마다 바꾸는 노이즈 회전/offset
+    void Render(const Camera &cam, const FramebufferPtr &gepBuf, const FramebufferPtr &depthBuf,
+                const TexturePtr &noiseTex, int downsample, int sampleOffset = 0, int sampleCount = 64,
+                const vec2 &jitter = vec2(0.0f));
+};
+
+// G-buffer depth를 SSAO 해상도(1 / downsample)의 linear depth로 줄임
+CLASS_PTR(SSAODepthPlane)
+class SSAODepthPlane : public Object
+{
+public:
+    SSAODepthPlane(MeshPtr &_mesh, Transform _trf, MaterialPtr _mat)
+        : Object(_mesh, _trf, _mat){};
+    ~SSAODepthPlane(){};
+
+    void Render(const Camera &cam, const FramebufferPtr &gepBuf, int downsample);
+};
+
+// linear depth의 다음 mip level을 만듦. 그리기 전에 texture의 base level을 이전 level로 맞춰야 함
+CLASS_PTR(SSAODepthMipPlane)
+class SSAODepthMipPlane : public Object
+{
+public:
+    SSAODepthMipPlane(MeshPtr &_mesh, Transform _trf, MaterialPtr _mat)
+        : Object(_mesh, _trf, _mat){};
+    ~SSAODepthMipPlane(){};
+
+    void Render(const TexturePtr &linearDepth);
+};
+
+// 이번 프레임 AO를 카메라 이동으로 재투영한 이전 결과와 섞어서 history의 target에 씀
+CLASS_PTR(SSAOTemporalPlane)
+class SSAOTemporalPlane : public Object
+{
+public:
+    SSAOTemporalPlane(MeshPtr &_mesh, Transform _trf, MaterialPtr _mat)
+        : Object(_mesh, _trf, _mat){};
+    ~SSAOTemporalPlane(){};
+
+    // reprojection : 이번 프레임 view space -> 이전 프레임 clip space
+    void Render(const Camera &cam, const TexturePtr &current, const HistoryBuffer &history,
+                const mat4 &reprojection, const vec2 &screenSize, int downsample);
+};
+
+// 저해상도 AO를 전체 해상도로 키움. 깊이가 비슷한 texel끼리만 섞어서 경계가 번지지 않게 함
+CLASS_PTR(SSAOUpsamplePlane)
+class SSAOUpsamplePlane : public Object
+{
+public:
+    SSAOUpsamplePlane(MeshPtr &_mesh, Transform _trf, MaterialPtr _mat)
+        : Object(_mesh, _trf, _mat){};
+    ~SSAOUpsamplePlane(){};
+
+    void Render(const Camera &cam, const FramebufferPtr &gepBuf, const FramebufferPtr &depthBuf,
+                const TexturePtr &ssao, int downsample);
 };
 
 CLASS_PTR(BlurPlane)
@@ -111,6 +193,8 @@ public:
     ~BlurPlane(){};
 
     void Render(const TexturePtr &tex);
+    // separable blur의 한 pass. direction은 (1, 0) 또는 (0, 1)
+    void Render(const TexturePtr &tex, const vec2 &direction);
 };
 
 CLASS_PTR(StencilBox)
@@ -0,0 +1,166 @@
+#include "profiler.h"
+#include <fstream>
+
+ProfilerUPtr Profiler::Create(uint32_t frameLatency, size_t historySize)
+{
+    auto profiler = ProfilerUPtr(new Profiler());
+    profiler->Init(frameLatency, historySize);
+    return std::move(profiler);
+}
+
+Profiler::~Profiler()
+{
+    for (auto &slot : m_slots)
+    {
+        if (!slot.queries.empty())
+            glDeleteQueries((GLsizei)slot.queries.size(), slot.queries.data());
+    }
+}
+
+void Profiler::Init(uint32_t frameLatency, size_t historySize)
+{
+    m_slots.resize(glm::max(frameLatency, 1u));
+    m_historySize = historySize;
+    m_startTime = std::chrono::steady_clock::now();
+}
+
+double Profiler::GetTime() const
+{
+    return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - m_startTime).count();
+}
+
+void Profiler::BeginFrame()
+{
+    // 같은 slot을 쓰던 프레임의 GPU 결과를 읽어서 history로 옮김
+    uint32_t slotIndex = (uint32_t)(m_frameIndex % m_slots.size());
+    auto &slot = m_slots[slotIndex];
+    if (slot.pending)
+        Resolve(slotIndex);
+
+    // 설정 변경은 프레임 단위로 반영해서 Begin/End 짝이 어긋나지 않도록 함
+    m_inFrame = m_enabled;
+    if (!m_inFrame)
+        return;
+
+    slot.frame.index = m_frameIndex;
+    slot.frame.start = GetTime();
+    slot.frame.cpuTime = 0.0;
+    slot.frame.samples.clear();
+    slot.queryIndices.clear();
+    slot.queryCount = 0;
+    m_stack.clear();
+}
+
+void Profiler::EndFrame()
+{
+    if (m_inFrame)
+    {
+        auto &slot = m_slots[m_frameIndex % m_slots.size()];
+        while (!m_stack.empty())
+            End();
+        slot.frame.cpuTime = GetTime() - slot.frame.start;
+        slot.pending = true;
+        m_inFrame = false;
+    }
+    m_frameIndex++;
+}
+
+void Profiler::Begin(const char *name)
+{
+    if (!m_inFrame)
+        return;
+
+    auto &slot = m_slots[m_frameIndex % m_slots.size()];
+    ProfileSample sample;
+    sample.name = name;
+    sample.depth = (uint32_t)m_stack.size();
+    sample.cpuStart = GetTime() - slot.frame.start;
+
+    int queryIndex = -1;
+    if (sample.depth == 0)
+    {
+        if (slot.queryCount == slot.queries.size())
+        {
+            GLuint query;
+            glGenQueries(1, &query);
+            slot.queries.push_back(query);
+        }
+        queryIndex = (int)slot.queryCount++;
+        glBeginQuery(GL_TIME_ELAPSED, slot.queries[queryIndex]);
+    }
+
+    m_stack.push_back(slot.frame.samples.size());
+    slot.frame.samples.push_back(sample);
+    slot.queryIndices.push_back(queryIndex);
+}
+
+void Profiler::End()
+{
+    if (!m_inFrame || m_stack.empty())
+        return;
+
+    auto &slot = m_slots[m_frameIndex % m_slots.size()];
+    size_t index = m_stack.back();
+    m_stack.pop_back();
+    slot.frame.samples[index].cpuEnd = GetTime() - slot.frame.start;
+    if (slot.queryIndices[index] >= 0)
+        glEndQuery(GL_TIME_ELAPSED);
+}
+
+void Profiler::Resolve(uint32_t slotIndex)
+{
+    auto &slot = m_slots[slotIndex];
+    for (size_t i = 0; i < slot.frame.samples.size(); i++)
+    {
+        int queryIndex = slot.queryIndices[i];
+        if (queryIndex < 0)
+            continue;
+        // frameLatency 프레임이 지났으므로 보통은 기다리지 않고 바로 읽힘
+        GLuint64 elapsed = 0;
+        glGetQueryObjectui64v(slot.queries[queryIndex], GL_QUERY_RESULT, &elapsed);
+        slot.frame.samples[i].gpuTime = (double)elapsed / 1000000.0;
+    }
+    slot.pending = false;
+
+    m_history.push_back(slot.frame);
+    while (m_history.size() > m_historySize)
+        m_history.pop_front();
+}
+
+bool Profiler::ExportChromeTrace(const std::string &filename) const
+{
+    std::ofstream file(filename);
+    if (!file.is_open())
+    {
+        SPDLOG_ERROR("failed to open trace file: {}", filename);
+        return false;
+    }
+
+    // 시간 단위는 us. CPU 구간은 tid 1, GPU 구간은 tid 2
+    // GPU는 시작 시각을 알 수 없으므로 CPU 시작 시각 이후에 순서대로 이어 붙여 표시
+    file << "{\"traceEvents\":[\n";
+    file << R"({"name":"thread_name","ph":"M","pid":1,"tid":1,"args":{"name":"CPU"}},)" << "\n";
+    file << R"({"name":"thread_name","ph":"M","pid":1,"tid":2,"args":{"name":"GPU"}})";
+    for (auto &frame : m_history)
+    {
+        file << fmt::format(",\n{{\"name\":\"frame {}\",\"cat\":\"frame\",\"ph\":\"X\",\"pid\":1,\"tid\":1,\"ts\":{:.3f},\"dur\":{:.3f}}}",
+                            frame.index, frame.start * 1000.0, frame.cpuTime * 1000.0);
+        double gpuCursor = 0.0;
+        for (auto &sample : frame.samples)
+        {
+            double start = (frame.start + sample.cpuStart) * 1000.0;
+            file << fmt::format(",\n{{\"name\":\"{}\",\"cat\":\"cpu\",\"ph\":\"X\",\"pid\":1,\"tid\":1,\"ts\":{:.3f},\"dur\":{:.3f}}}",
+                                sample.name, start, (sample.cpuEnd - sample.cpuStart) * 1000.0);
+            if (sample.gpuTime < 0.0)
+                continue;
+            gpuCursor = glm::max(gpuCursor, start);
+            file << fmt::format(",\n{{\"name\":\"{}\",\"cat\":\"gpu\",\"ph\":\"X\",\"pid\":1,\"tid\":2,\"ts\":{:.3f},\"dur\":{:.3f}}}",
+                                sample.name, gpuCursor, sample.gpuTime * 1000.0);
+            gpuCursor += sample.gpuTime * 1000.0;
+        }
+    }
+    file << "\n]}\n";
+
+    SPDLOG_INFO("trace exported: {} ({} frames)", filename, m_history.size());
+    return true;
+}
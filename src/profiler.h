@@ -0,0 +1,87 @@
+#pragma once
+
+#include "common.h"
+#include <chrono>
+#include <deque>
+#include <vector>
+
+struct ProfileSample
+{
+    const char *name;
+    uint32_t depth{0};
+    double cpuStart{0.0}; // 프레임 시작 기준(ms)
+    double cpuEnd{0.0};
+    double gpuTime{-1.0}; // ms, GPU 측정을 하지 않은 구간은 음수
+};
+
+struct ProfileFrame
+{
+    uint64_t index{0};
+    double start{0.0}; // Profiler 생성 기준(ms)
+    double cpuTime{0.0};
+    std::vector<ProfileSample> samples;
+};
+
+// 구간별 CPU(chrono) / GPU(GL_TIME_ELAPSED) 시간 측정
+// GPU 결과는 기다리지 않도록 frameLatency 프레임 뒤에 읽어옴
+// GL_TIME_ELAPSED 쿼리는 중첩할 수 없으므로 GPU 시간은 최상위 구간(depth 0)만 측정
+CLASS_PTR(Profiler)
+class Profiler
+{
+public:
+    static ProfilerUPtr Create(uint32_t frameLatency = 4, size_t historySize = 300);
+    ~Profiler();
+
+    void BeginFrame();
+    void EndFrame();
+    // name은 문자열 리터럴처럼 프레임이 끝난 후에도 유효해야 함
+    void Begin(const char *name);
+    void End();
+
+    void SetEnabled(bool enabled) { m_enabled = enabled; }
+    bool IsEnabled() const { return m_enabled; }
+
+    // GPU 결과까지 모두 읽어온 프레임들. 오래된 것부터
+    const std::deque<ProfileFrame> &GetHistory() const { return m_history; }
+    // history 전체를 chrome://tracing(또는 Perfetto) 형식 JSON으로 저장
+    bool ExportChromeTrace(const std::string &filename) const;
+
+private:
+    Profiler() {}
+    void Init(uint32_t frameLatency, size_t historySize);
+    double GetTime() const;
+    void Resolve(uint32_t slot);
+
+    struct FrameSlot
+    {
+        ProfileFrame frame;
+        std::vector<GLuint> queries; // 재사용하는 query pool
+        std::vector<int> queryIndices; // sample별 query 번호, 없으면 -1
+        uint32_t queryCount{0};
+        bool pending{false};
+    };
+
+    bool m_enabled{true};
+    bool m_inFrame{false};
+    uint64_t m_frameIndex{0};
+    std::chrono::steady_clock::time_point m_startTime;
+    std::vector<FrameSlot> m_slots;
+    std::vector<size_t> m_stack; // 열려있는 sample 번호
+    std::deque<ProfileFrame> m_history;
+    size_t m_historySize{300};
+};
+
+// 생성 시 Begin, 소멸 시 End
+class ProfileScope
+{
+public:
+    ProfileScope(Profiler *profiler, const char *name) : m_profiler(profiler) { m_profiler->Begin(name); }
+    ~ProfileScope() { m_profiler->End(); }
+
+private:
+    Profiler *m_profiler;
+};
+
+#define PROFILE_CONCAT_INNER(a, b) a##b
+#define PROFILE_CONCAT(a, b) PROFILE_CONCAT_INNER(a, b)
+#define PROFILE_SCOPE(profiler, name) ProfileScope PROFILE_CONCAT(profileScope, __LINE__)(profiler, name)
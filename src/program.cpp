@@ -1,4 +1,69 @@
 #include "program.h"
+#include "capture.h"
+#include "renderstats.h"
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <random>
+
+static const uint32_t PROGRAM_BINARY_MAGIC = 0x4E494250; // "PBIN"
+static std::string s_binaryCacheDirectory = "./shader_cache";
+static ProgramCacheStats s_cacheStats;
+
+void Program::SetBinaryCacheDirectory(const std::string &directory)
+{
+    s_binaryCacheDirectory = directory;
+}
+
+const std::string &Program::GetBinaryCacheDirectory()
+{
+    return s_binaryCacheDirectory;
+}
+
+const ProgramCacheStats &Program::GetCacheStats()
+{
+    return s_cacheStats;
+}
+
+static bool IsBinaryCacheEnabled()
+{
+    if (s_binaryCacheDirectory.empty())
+        return false;
+    if (!GLAD_GL_VERSION_4_1 && !GLAD_GL_ARB_get_program_binary)
+        return false;
+    int formatCount = 0;
+    glGetIntegerv(GL_NUM_PROGRAM_BINARY_FORMATS, &formatCount);
+    return formatCount > 0;
+}
+
+// 드라이버 정보와 쉐이더 소스의 hash(FNV-1a)로 cache 파일 이름을 만듦
+// 드라이버가 바뀌면 다른 파일을 사용하게 되어 호환되지 않는 binary를 읽지 않음
+static std::string GetBinaryCachePath(const std::vector<std::pair<GLenum, const std::string *>> &sources)
+{
+    uint64_t hash = 14695981039346656037ull;
+    auto add = [&hash](const void *data, size_t size)
+    {
+        auto bytes = (const uint8_t *)data;
+        for (size_t i = 0; i < size; i++)
+        {
+            hash ^= bytes[i];
+            hash *= 1099511628211ull;
+        }
+    };
+
+    for (auto name : {GL_VENDOR, GL_RENDERER, GL_VERSION})
+    {
+        auto value = (const char *)glGetString(name);
+        if (value)
+            add(value, strlen(value));
+    }
+    for (auto &source : sources)
+    {
+        add(&source.first, sizeof(source.first));
+        add(source.second->data(), source.second->size());
+    }
+    return fmt::format("{}/{:016x}.bin", s_binaryCacheDirectory, hash);
+}
 
 ProgramUPtr Program::Create(const std::vector<ShaderPtr> &shaders)
 {
@@ -11,13 +76,60 @@ ProgramUPtr Program::Create(const std::vector<ShaderPtr> &shaders)
 ProgramUPtr Program::Create(const std::string &vertShaderFilename,
                             const std::string &fragShaderFilename)
 {
-    ShaderPtr vs = Shader::CreateFromFile(vertShaderFilename, GL_VERTEX_SHADER);
-    ShaderPtr fs = Shader::CreateFromFile(fragShaderFilename, GL_FRAGMENT_SHADER);
+    return CreateFromFiles({{GL_VERTEX_SHADER, vertShaderFilename},
+                            {GL_FRAGMENT_SHADER, fragShaderFilename}});
+}
+
+ProgramUPtr Program::Create(const std::string &vertShaderFilename,
+                            const std::string &geomShaderFilename,
+                            const std::string &fragShaderFilename)
+{
+    return CreateFromFiles({{GL_VERTEX_SHADER, vertShaderFilename},
+                            {GL_GEOMETRY_SHADER, geomShaderFilename},
+                            {GL_FRAGMENT_SHADER, fragShaderFilename}});
+}
 
-    SPDLOG_INFO("vertex shader id: {}", vs->Get());
-    SPDLOG_INFO("fragment shader id: {}", fs->Get());
+ProgramUPtr Program::CreateFromFiles(const std::vector<std::pair<GLenum, std::string>> &files)
+{
+    std::vector<std::string> codes;
+    for (auto &file : files)
+    {
+        auto code = Shader::LoadSource(file.second);
+        if (!code)
+            throw std::string("shader load fail - " + file.second);
+        codes.push_back(std::move(code.value()));
+    }
+
+    std::string cachePath;
+    if (IsBinaryCacheEnabled())
+    {
+        std::vector<std::pair<GLenum, const std::string *>> sources;
+        for (size_t i = 0; i < files.size(); i++)
+            sources.push_back({files[i].first, &codes[i]});
+        cachePath = GetBinaryCachePath(sources);
+        auto program = ProgramUPtr(new Program());
+        if (program->LoadBinary(cachePath))
+        {
+            s_cacheStats.hits++;
+            return std::move(program);
+        }
+    }
+
+    std::vector<ShaderPtr> shaders;
+    for (size_t i = 0; i < files.size(); i++)
+    {
+        ShaderPtr shader = Shader::CreateFromSource(codes[i], files[i].first, files[i].second);
+        SPDLOG_INFO("shader id: {} ({})", shader->Get(), files[i].second);
+        shaders.push_back(shader);
+    }
 
-    return std::move(Create({vs, fs}));
+    auto program = Create(shaders);
+    if (program && !cachePath.empty())
+    {
+        s_cacheStats.misses++;
+        program->SaveBinary(cachePath);
+    }
+    return std::move(program);
 }
 
 bool Program::Link(const std::vector<ShaderPtr> &shaders)
@@ -25,6 +137,8 @@ bool Program::Link(const std::vector<ShaderPtr> &shaders)
     m_program = glCreateProgram();
     for (auto &shader : shaders)
         glAttachShader(m_program, shader->Get());
+    if (IsBinaryCacheEnabled())
+        glProgramParameteri(m_program, GL_PROGRAM_BINARY_RETRIEVABLE_HINT, GL_TRUE);
     glLinkProgram(m_program);
     int success = 0;
     glGetProgramiv(m_program, GL_LINK_STATUS, &success);
@@ -38,6 +152,93 @@ bool Program::Link(const std::vector<ShaderPtr> &shaders)
     return true;
 }
 
+bool Program::LoadBinary(const std::string &filename)
+{
+    std::ifstream file(filename, std::ios::binary | std::ios::ate);
+    if (!file.is_open())
+        return false;
+    uint64_t fileSize = (uint64_t)file.tellg();
+    file.seekg(0);
+
+    uint32_t magic = 0, format = 0, length = 0;
+    file.read((char *)&magic, sizeof(magic));
+    file.read((char *)&format, sizeof(format));
+    file.read((char *)&length, sizeof(length));
+    if (!file || magic != PROGRAM_BINARY_MAGIC || length == 0)
+        return false;
+    // 쓰다가 중단되었거나 손상된 파일은 길이 값이 실제 크기와 맞지 않음
+    const uint64_t headerSize = sizeof(magic) + sizeof(format) + sizeof(length);
+    if (fileSize != headerSize + length)
+    {
+        SPDLOG_WARN("program binary size mismatch, recompiling: {}", filename);
+        return false;
+    }
+    std::vector<char> binary(length);
+    file.read(binary.data(), length);
+    if (!file)
+        return false;
+
+    m_program = glCreateProgram();
+    // 캡처 등에서 다시 binary를 읽을 수 있도록 함
+    glProgramParameteri(m_program, GL_PROGRAM_BINARY_RETRIEVABLE_HINT, GL_TRUE);
+    glProgramBinary(m_program, format, binary.data(), length);
+    int success = 0;
+    glGetProgramiv(m_program, GL_LINK_STATUS, &success);
+    if (!success)
+    {
+        // 드라이버 갱신 등으로 거부되면 소스에서 다시 컴파일
+        SPDLOG_WARN("program binary rejected, recompiling: {}", filename);
+        return false;
+    }
+    return true;
+}
+
+void Program::SaveBinary(const std::string &filename) const
+{
+    int length = 0;
+    glGetProgramiv(m_program, GL_PROGRAM_BINARY_LENGTH, &length);
+    if (length <= 0)
+        return;
+
+    std::vector<char> binary(length);
+    uint32_t format = 0;
+    glGetProgramBinary(m_program, length, &length, &format, binary.data());
+
+    std::error_code error;
+    std::filesystem::create_directories(std::filesystem::path(filename).parent_path(), error);
+
+    // 임시 파일에 다 쓴 뒤 rename으로 교체해서, 중간에 종료되거나 여러 프로세스가 동시에 써도
+    // 다른 프로세스가 반쯤 쓰인 cache 파일을 읽지 않도록 함
+    auto tempFilename = fmt::format("{}.{:08x}.tmp", filename, std::random_device()());
+    {
+        std::ofstream file(tempFilename, std::ios::binary);
+        if (!file.is_open())
+        {
+            SPDLOG_WARN("failed to write program binary: {}", filename);
+            return;
+        }
+        uint32_t magic = PROGRAM_BINARY_MAGIC;
+        uint32_t size = (uint32_t)length;
+        file.write((const char *)&magic, sizeof(magic));
+        file.write((const char *)&format, sizeof(format));
+        file.write((const char *)&size, sizeof(size));
+        file.write(binary.data(), length);
+        if (!file.good())
+        {
+            SPDLOG_WARN("failed to write program binary: {}", filename);
+            file.close();
+            std::filesystem::remove(tempFilename, error);
+            return;
+        }
+    }
+    std::filesystem::rename(tempFilename, filename, error);
+    if (error)
+    {
+        SPDLOG_WARN("failed to replace program binary: {} ({})", filename, error.message());
+        std::filesystem::remove(tempFilename, error);
+    }
+}
+
 Program::~Program()
 {
     if (m_program)
@@ -49,12 +250,15 @@ Program::~Program()
 void Program::Use() const
 {
     glUseProgram(m_program);
+    FrameCapture::RecordUseProgram(m_program);
+    RenderStats::AddProgramBind();
 }
 
 void Program::SetUniform(const std::string &name, int value) const
 {
     auto loc = glGetUniformLocation(m_program, name.c_str());
     glUniform1i(loc, value);
+    FrameCapture::RecordUniform(m_program, name, GL_INT, &value, sizeof(value));
 }
 
 void Program::SetUniform(const std::string &name,
@@ -62,28 +266,48 @@ void Program::SetUniform(const std::string &name,
 {
     auto loc = glGetUniformLocation(m_program, name.c_str());
     glUniformMatrix4fv(loc, 1, GL_FALSE, glm::value_ptr(value));
+    FrameCapture::RecordUniform(m_program, name, GL_FLOAT_MAT4, glm::value_ptr(value), sizeof(value));
 }
 
 void Program::SetUniform(const std::string &name, float value) const
 {
     auto loc = glGetUniformLocation(m_program, name.c_str());
     glUniform1f(loc, value);
+    FrameCapture::RecordUniform(m_program, name, GL_FLOAT, &value, sizeof(value));
 }
 
 void Program::SetUniform(const std::string &name, const glm::vec2 &value) const
 {
     auto loc = glGetUniformLocation(m_program, name.c_str());
     glUniform2fv(loc, 1, glm::value_ptr(value));
+    FrameCapture::RecordUniform(m_program, name, GL_FLOAT_VEC2, glm::value_ptr(value), sizeof(value));
 }
 
 void Program::SetUniform(const std::string &name, const glm::vec3 &value) const
 {
     auto loc = glGetUniformLocation(m_program, name.c_str());
     glUniform3fv(loc, 1, glm::value_ptr(value));
+    FrameCapture::RecordUniform(m_program, name, GL_FLOAT_VEC3, glm::value_ptr(value), sizeof(value));
 }
 
 void Program::SetUniform(const std::string &name, const glm::vec4 &value) const
 {
     auto loc = glGetUniformLocation(m_program, name.c_str());
     glUniform4fv(loc, 1, glm::value_ptr(value));
+    FrameCapture::RecordUniform(m_program, name, GL_FLOAT_VEC4, glm::value_ptr(value), sizeof(value));
+}
+
+void Program::SetUniform(const std::string &name, const std::vector<glm::vec3> &values) const
+{
+    if (values.empty())
+        return;
+    auto loc = glGetUniformLocation(m_program, name.c_str());
+    glUniform3fv(loc, (GLsizei)values.size(), glm::value_ptr(values[0]));
+    // 캡처는 원소 단위로 재생하므로 나눠서 기록
+    if (FrameCapture::IsRecording())
+    {
+        for (size_t i = 0; i < values.size(); i++)
+            FrameCapture::RecordUniform(m_program, fmt::format("{}[{}]", name, i), GL_FLOAT_VEC3,
+                                        glm::value_ptr(values[i]), sizeof(glm::vec3));
+    }
 }
\ No newline at end of file
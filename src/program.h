@@ -2,6 +2,12 @@
 #include "common.h"
 #include "shader.h"
 
+struct ProgramCacheStats
+{
+    int hits{0};   // 캐시된 binary로 생성
+    int misses{0}; // 소스를 컴파일하고 binary를 저장
+};
+
 // Program : 쉐이더 객체 단위
 CLASS_PTR(Program)
 class Program
@@ -10,11 +16,22 @@ public:
     static ProgramUPtr Create(
         const std::vector<ShaderPtr> &shaders);
 
+    // 링크된 binary를 cache 디렉토리에 저장해두고, 소스와 드라이버가 같으면 컴파일 없이 불러옴
     static ProgramUPtr Create(
         const std::string &vertShaderFilename,
         const std::string &fragShaderFilename);
+    // geometry shader를 포함한 program (layered rendering 등)
+    static ProgramUPtr Create(
+        const std::string &vertShaderFilename,
+        const std::string &geomShaderFilename,
+        const std::string &fragShaderFilename);
     ~Program();
 
+    // 빈 문자열이면 binary cache를 사용하지 않음
+    static void SetBinaryCacheDirectory(const std::string &directory);
+    static const std::string &GetBinaryCacheDirectory();
+    static const ProgramCacheStats &GetCacheStats();
+
 public:
     uint32_t Get() const { return m_program; }
     void Use() const;
@@ -24,9 +41,18 @@ public:
     void SetUniform(const std::string &name, const glm::vec2 &value) const;
     void SetUniform(const std::string &name, const glm::vec3 &value) const;
     void SetUniform(const std::string &name, const glm::vec4 &value) const;
+    void SetUniform(const std::string &name, const std::vector<glm::vec3> &values) const;
+
+    // 마지막으로 이 program을 Apply한 Material (Material::Apply에서 static uniform을 다시 올릴지 판단)
+    uint32_t GetLastMaterial() const { return m_lastMaterial; }
+    void SetLastMaterial(uint32_t materialId) const { m_lastMaterial = materialId; }
 
 private:
     Program() {}
+    static ProgramUPtr CreateFromFiles(const std::vector<std::pair<GLenum, std::string>> &files);
     bool Link(const std::vector<ShaderPtr> &shaders);
+    bool LoadBinary(const std::string &filename);
+    void SaveBinary(const std::string &filename) const;
     uint32_t m_program{0};
+    mutable uint32_t m_lastMaterial{0};
 };
\ No newline at end of file
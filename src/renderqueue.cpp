@@ -0,0 +1,111 @@
+#include "renderqueue.h"
+#include <algorithm>
+#include <cstring>
+
+RenderQueueUPtr RenderQueue::Create()
+{
+    return RenderQueueUPtr(new RenderQueue());
+}
+
+void RenderQueue::Begin(uint32_t flags, const mat4 &view, const mat4 &projection,
+                        RenderSortMode sortMode, size_t slotCount)
+{
+    m_flags = flags;
+    m_view = view;
+    m_viewProjection = projection * view;
+    m_sortMode = sortMode;
+
+    // view-projection 행렬의 행으로부터 frustum 평면 추출 (left, right, bottom, top, near, far)
+    auto row = [&](int r)
+    { return vec4(m_viewProjection[0][r], m_viewProjection[1][r], m_viewProjection[2][r], m_viewProjection[3][r]); };
+    m_frustum[0] = row(3) + row(0);
+    m_frustum[1] = row(3) - row(0);
+    m_frustum[2] = row(3) + row(1);
+    m_frustum[3] = row(3) - row(1);
+    m_frustum[4] = row(3) + row(2);
+    m_frustum[5] = row(3) - row(2);
+    for (auto &plane : m_frustum)
+        plane /= length(vec3(plane));
+
+    // 이전 프레임의 slot 메모리는 재사용
+    m_slots.resize(slotCount);
+    for (auto &slot : m_slots)
+        slot.clear();
+    m_packets.clear();
+}
+
+bool RenderQueue::IsVisible(const mat4 &world) const
+{
+    // 메쉬는 원점 중심의 단위 크기라고 가정한 bounding sphere로 검사
+    vec3 center = vec3(world[3]);
+    float scale = glm::max(length(vec3(world[0])), glm::max(length(vec3(world[1])), length(vec3(world[2]))));
+    float radius = 0.8660254f * scale;
+    for (auto &plane : m_frustum)
+    {
+        if (dot(vec3(plane), center) + plane.w < -radius)
+            return false;
+    }
+    return true;
+}
+
+void RenderQueue::Record(const SceneChunk &chunk, size_t slot)
+{
+    auto &packets = m_slots[slot];
+    for (uint32_t i = 0; i < chunk.count; i++)
+    {
+        if ((chunk.flags[i] & m_flags) != m_flags)
+            continue;
+
+        const auto &world = chunk.worlds[i];
+        if (!IsVisible(world))
+            continue;
+
+        // 카메라와의 거리를 24bit로 양자화. 양수 float는 비트 순서가 크기 순서와 같음
+        float depth = glm::max(-(m_view * world[3]).z, 0.0f);
+        uint32_t depthBits;
+        memcpy(&depthBits, &depth, sizeof(float));
+        depthBits >>= 8;
+
+        DrawPacket packet;
+        if (m_sortMode == RenderSortMode::BackToFront)
+            packet.sortKey = (uint64_t)(0xFFFFFF - depthBits);
+        else
+            packet.sortKey = ((uint64_t)(chunk.materials[i] & 0xFFFF) << 48) |
+                             ((uint64_t)(chunk.meshes[i] & 0xFFFFFF) << 24) |
+                             (uint64_t)depthBits;
+        packet.mesh = chunk.meshes[i];
+        packet.material = chunk.materials[i];
+        packet.transform = m_viewProjection * world;
+        packet.modelTransform = world;
+        packets.push_back(packet);
+    }
+}
+
+void RenderQueue::Finish()
+{
+    size_t total = 0;
+    for (auto &slot : m_slots)
+        total += slot.size();
+    m_packets.reserve(total);
+    for (auto &slot : m_slots)
+        m_packets.insert(m_packets.end(), slot.begin(), slot.end());
+
+    std::stable_sort(m_packets.begin(), m_packets.end(),
+                     [](const DrawPacket &a, const DrawPacket &b)
+                     { return a.sortKey < b.sortKey; });
+}
+
+void RenderQueue::Execute(const Scene &scene, const MaterialPtr &optionMat, bool positionOnly) const
+{
+    for (auto &packet : m_packets)
+    {
+        const auto &material = optionMat ? optionMat : scene.GetMaterial(packet.material);
+        material->SetProperty("transform", packet.transform);
+        material->SetProperty("modelTransform", packet.modelTransform);
+        material->Apply();
+        if (positionOnly)
+            scene.GetMesh(packet.mesh)->DrawPositionOnly();
+        else
+            scene.GetMesh(packet.mesh)->Draw();
+    }
+}
@@ -0,0 +1,56 @@
+#pragma once
+
+#include "common.h"
+#include "scene.h"
+#include <vector>
+
+// GL 스레드가 그대로 재생하는 draw 명령 하나
+struct DrawPacket
+{
+    uint64_t sortKey;
+    uint32_t mesh;     // Scene::GetMesh 인덱스
+    uint32_t material; // Scene::GetMaterial 인덱스
+    mat4 transform;      // clip space
+    mat4 modelTransform; // world
+};
+
+enum class RenderSortMode
+{
+    State,       // 매터리얼, 메쉬 순으로 묶어서 상태 변경 최소화 (불투명)
+    BackToFront, // 먼 것부터 (반투명)
+};
+
+// pass 하나의 draw packet 목록
+// Record는 여러 스레드에서 slot별로 동시에 호출 가능하고, Execute는 GL 스레드에서 호출
+CLASS_PTR(RenderQueue)
+class RenderQueue
+{
+public:
+    static RenderQueueUPtr Create();
+    ~RenderQueue() = default;
+
+    // slotCount : 동시에 Record할 단위(chunk) 수
+    void Begin(uint32_t flags, const mat4 &view, const mat4 &projection,
+               RenderSortMode sortMode, size_t slotCount);
+    // chunk 하나의 가시성 검사 후 packet 기록
+    void Record(const SceneChunk &chunk, size_t slot);
+    // slot별 packet을 합치고 정렬
+    void Finish();
+    // positionOnly : 메쉬의 position 전용 VAO로 그림 (depth pre-pass 등). optionMat 필요
+    void Execute(const Scene &scene, const MaterialPtr &optionMat = nullptr, bool positionOnly = false) const;
+
+    size_t GetPacketCount() const { return m_packets.size(); }
+
+private:
+    RenderQueue() {}
+    bool IsVisible(const mat4 &world) const;
+
+    uint32_t m_flags{0};
+    mat4 m_view{mat4(1.0f)};
+    mat4 m_viewProjection{mat4(1.0f)};
+    vec4 m_frustum[6];
+    RenderSortMode m_sortMode{RenderSortMode::State};
+
+    std::vector<std::vector<DrawPacket>> m_slots;
+    std::vector<DrawPacket> m_packets;
+};
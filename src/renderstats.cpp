@@ -0,0 +1,89 @@
+#include "renderstats.h"
+
+static const size_t HISTORY_SIZE = 120;
+
+RenderFrameStats RenderStats::s_frame;
+RenderFrameStats RenderStats::s_lastFrame;
+RenderMemoryStats RenderStats::s_memory;
+std::vector<float> RenderStats::s_drawCallHistory;
+
+void RenderStats::BeginFrame()
+{
+    s_lastFrame = s_frame;
+    s_frame = RenderFrameStats();
+
+    if (s_drawCallHistory.size() >= HISTORY_SIZE)
+        s_drawCallHistory.erase(s_drawCallHistory.begin());
+    s_drawCallHistory.push_back((float)s_lastFrame.drawCalls);
+}
+
+void RenderStats::AddDraw(uint32_t primitiveType, uint32_t indexCount, uint32_t instanceCount)
+{
+    s_frame.drawCalls++;
+    uint64_t instances = 1;
+    if (instanceCount > 0)
+    {
+        s_frame.instancedDrawCalls++;
+        instances = instanceCount;
+    }
+    s_frame.instances += instances;
+    if (primitiveType == GL_TRIANGLES)
+        s_frame.triangles += indexCount / 3 * instances;
+}
+
+void RenderStats::AddBufferUpload(size_t bytes)
+{
+    s_frame.bufferUploads++;
+    s_frame.bufferUploadBytes += bytes;
+}
+
+void RenderStats::TrackBuffer(int count, int64_t size)
+{
+    s_memory.bufferCount += count;
+    s_memory.bufferBytes += size;
+}
+
+void RenderStats::TrackTexture(int count, int64_t size)
+{
+    s_memory.textureCount += count;
+    s_memory.textureBytes += size;
+}
+
+void RenderStats::TrackFramebuffer(int count, int64_t renderbufferSize)
+{
+    s_memory.framebufferCount += count;
+    s_memory.renderbufferBytes += renderbufferSize;
+}
+
+size_t RenderStats::GetTextureSize(uint32_t internalFormat, int width, int height, bool mipmap)
+{
+    // 3채널 형식은 대부분의 드라이버가 4채널로 저장하므로 4채널 크기로 계산
+    size_t texelSize = 4;
+    switch (internalFormat)
+    {
+    case GL_RED:
+    case GL_R8:
+        texelSize = 1;
+        break;
+    case GL_RG:
+    case GL_RG8:
+    case GL_R16F:
+        texelSize = 2;
+        break;
+    case GL_RGB16F:
+    case GL_RGBA16F:
+    case GL_RG32F:
+        texelSize = 8;
+        break;
+    case GL_RGB32F:
+    case GL_RGBA32F:
+        texelSize = 16;
+        break;
+    default: // GL_RGB, GL_RGBA, GL_RG16, GL_RG16F, GL_R32F, depth 등
+        break;
+    }
+
+    size_t size = texelSize * width * height;
+    // mipmap 전체는 level 0의 약 4/3
+    return mipmap ? size * 4 / 3 : size;
+}
@@ -0,0 +1,71 @@
+#pragma once
+
+#include "common.h"
+#include <vector>
+
+// 프레임마다 0으로 초기화되는 호출 횟수
+struct RenderFrameStats
+{
+    int drawCalls{0};
+    int instancedDrawCalls{0};
+    uint64_t triangles{0};
+    uint64_t instances{0};
+    int programBinds{0};
+    int textureBinds{0};
+    int vertexArrayBinds{0};
+    int framebufferBinds{0};
+    int clears{0};
+    int bufferUploads{0};
+    uint64_t bufferUploadBytes{0};
+    float fenceWaitMs{0.0f}; // stream 버퍼가 GPU 사용이 끝나기를 기다린 시간
+};
+
+// 현재 할당되어 있는 GL 리소스. 생성/삭제 시점에 갱신
+struct RenderMemoryStats
+{
+    int bufferCount{0};
+    uint64_t bufferBytes{0};
+    int textureCount{0};
+    uint64_t textureBytes{0};
+    int framebufferCount{0};
+    uint64_t renderbufferBytes{0};
+
+    uint64_t GetTotalBytes() const { return bufferBytes + textureBytes + renderbufferBytes; }
+};
+
+// Buffer, Texture, Framebuffer, Mesh 등이 GL을 호출할 때 같이 기록하는 전역 통계
+// GL 호출과 같이 렌더링(메인) 스레드에서만 사용
+class RenderStats
+{
+public:
+    // 지난 프레임의 값을 보관하고 새 프레임 카운터를 시작
+    static void BeginFrame();
+    static const RenderFrameStats &GetFrame() { return s_frame; }         // 진행 중인 프레임
+    static const RenderFrameStats &GetLastFrame() { return s_lastFrame; } // 마지막으로 끝난 프레임
+    static const RenderMemoryStats &GetMemory() { return s_memory; }
+    // 최근 프레임들의 draw call 수 (UI 그래프용)
+    static const std::vector<float> &GetDrawCallHistory() { return s_drawCallHistory; }
+
+    static void AddDraw(uint32_t primitiveType, uint32_t indexCount, uint32_t instanceCount = 0);
+    static void AddProgramBind() { s_frame.programBinds++; }
+    static void AddTextureBind() { s_frame.textureBinds++; }
+    static void AddVertexArrayBind() { s_frame.vertexArrayBinds++; }
+    static void AddFramebufferBind() { s_frame.framebufferBinds++; }
+    static void AddClear() { s_frame.clears++; }
+    static void AddBufferUpload(size_t bytes);
+    static void AddFenceWait(float ms) { s_frame.fenceWaitMs += ms; }
+
+    // 생성할 때 (1, byte), 삭제할 때 (-1, -byte)
+    static void TrackBuffer(int count, int64_t size);
+    static void TrackTexture(int count, int64_t size);
+    static void TrackFramebuffer(int count, int64_t renderbufferSize);
+
+    // internalFormat 텍스처 한 장의 대략적인 byte 크기
+    static size_t GetTextureSize(uint32_t internalFormat, int width, int height, bool mipmap = false);
+
+private:
+    static RenderFrameStats s_frame;
+    static RenderFrameStats s_lastFrame;
+    static RenderMemoryStats s_memory;
+    static std::vector<float> s_drawCallHistory;
+};
@@ -0,0 +1,269 @@
+#include "scene.h"
+
+SceneUPtr Scene::Create()
+{
+    return SceneUPtr(new Scene());
+}
+
+uint32_t Scene::AddMesh(const MeshPtr &mesh)
+{
+    m_meshes.push_back(mesh);
+    return (uint32_t)m_meshes.size() - 1;
+}
+
+uint32_t Scene::AddMaterial(const MaterialPtr &material)
+{
+    m_materials.push_back(material);
+    return (uint32_t)m_materials.size() - 1;
+}
+
+SceneArchetype *Scene::GetArchetype(uint32_t mask)
+{
+    for (auto &archetype : m_archetypes)
+    {
+        if (archetype->mask == mask)
+            return archetype.get();
+    }
+    auto archetype = std::make_unique<SceneArchetype>();
+    archetype->mask = mask;
+    m_archetypes.push_back(std::move(archetype));
+    return m_archetypes.back().get();
+}
+
+Entity Scene::CreateEntity(uint32_t componentMask)
+{
+    auto archetype = GetArchetype(componentMask);
+
+    // 빈 자리가 있는 chunk를 사용하고, 없으면 새로 만듦
+    uint32_t chunkIndex = 0;
+    while (chunkIndex < archetype->chunks.size() &&
+           archetype->chunks[chunkIndex]->count == SceneChunk::CAPACITY)
+        chunkIndex++;
+
+    if (chunkIndex == archetype->chunks.size())
+    {
+        auto chunk = std::make_unique<SceneChunk>();
+        chunk->entities.reserve(SceneChunk::CAPACITY);
+        if (componentMask & COMPONENT_TRANSFORM)
+        {
+            chunk->transforms.reserve(SceneChunk::CAPACITY);
+            chunk->worlds.reserve(SceneChunk::CAPACITY);
+        }
+        if (componentMask & COMPONENT_MESH)
+            chunk->meshes.reserve(SceneChunk::CAPACITY);
+        if (componentMask & COMPONENT_MATERIAL)
+            chunk->materials.reserve(SceneChunk::CAPACITY);
+        if (componentMask & COMPONENT_RENDER)
+            chunk->flags.reserve(SceneChunk::CAPACITY);
+        archetype->chunks.push_back(std::move(chunk));
+    }
+
+    Entity entity;
+    if (!m_freeEntities.empty())
+    {
+        entity = m_freeEntities.back();
+        m_freeEntities.pop_back();
+    }
+    else
+    {
+        entity = (Entity)m_records.size();
+        m_records.push_back({});
+    }
+
+    auto &chunk = *archetype->chunks[chunkIndex];
+    uint32_t row = chunk.count++;
+    chunk.entities.push_back(entity);
+    if (componentMask & COMPONENT_TRANSFORM)
+    {
+        chunk.transforms.emplace_back();
+        chunk.worlds.push_back(mat4(1.0f));
+    }
+    if (componentMask & COMPONENT_MESH)
+        chunk.meshes.push_back(0);
+    if (componentMask & COMPONENT_MATERIAL)
+        chunk.materials.push_back(0);
+    if (componentMask & COMPONENT_RENDER)
+        chunk.flags.push_back(0);
+
+    m_records[entity] = {archetype, chunkIndex, row};
+    m_entityCount++;
+    return entity;
+}
+
+Entity Scene::CreateRenderable(const Transform &trf, uint32_t mesh, uint32_t material, uint32_t flags)
+{
+    auto entity = CreateEntity(COMPONENT_RENDERABLE);
+    SetTransform(entity, trf);
+    SetMesh(entity, mesh);
+    SetMaterial(entity, material);
+    SetFlags(entity, flags);
+    return entity;
+}
+
+void Scene::DestroyEntity(Entity entity)
+{
+    if (!IsAlive(entity))
+        return;
+
+    auto &record = m_records[entity];
+    auto &chunk = *record.archetype->chunks[record.chunk];
+    uint32_t row = record.row;
+    uint32_t last = chunk.count - 1;
+
+    // 배열이 연속되도록 마지막 원소를 지운 자리로 옮김
+    if (row != last)
+    {
+        Entity moved = chunk.entities[last];
+        chunk.entities[row] = moved;
+        if (!chunk.transforms.empty())
+        {
+            chunk.transforms[row] = chunk.transforms[last];
+            chunk.worlds[row] = chunk.worlds[last];
+        }
+        if (!chunk.meshes.empty())
+            chunk.meshes[row] = chunk.meshes[last];
+        if (!chunk.materials.empty())
+            chunk.materials[row] = chunk.materials[last];
+        if (!chunk.flags.empty())
+            chunk.flags[row] = chunk.flags[last];
+        m_records[moved].row = row;
+    }
+
+    chunk.entities.pop_back();
+    if (!chunk.transforms.empty())
+    {
+        chunk.transforms.pop_back();
+        chunk.worlds.pop_back();
+    }
+    if (!chunk.meshes.empty())
+        chunk.meshes.pop_back();
+    if (!chunk.materials.empty())
+        chunk.materials.pop_back();
+    if (!chunk.flags.empty())
+        chunk.flags.pop_back();
+    chunk.count--;
+
+    record = {};
+    m_freeEntities.push_back(entity);
+    m_entityCount--;
+}
+
+bool Scene::IsAlive(Entity entity) const
+{
+    return entity < m_records.size() && m_records[entity].archetype != nullptr;
+}
+
+SceneChunk *Scene::GetChunk(Entity entity, uint32_t &row)
+{
+    if (!IsAlive(entity))
+        return nullptr;
+    auto &record = m_records[entity];
+    row = record.row;
+    return record.archetype->chunks[record.chunk].get();
+}
+
+const SceneChunk *Scene::GetChunk(Entity entity, uint32_t &row) const
+{
+    if (!IsAlive(entity))
+        return nullptr;
+    auto &record = m_records[entity];
+    row = record.row;
+    return record.archetype->chunks[record.chunk].get();
+}
+
+void Scene::SetTransform(Entity entity, const Transform &trf)
+{
+    uint32_t row;
+    auto chunk = GetChunk(entity, row);
+    if (chunk && !chunk->transforms.empty())
+        chunk->transforms[row] = trf;
+}
+
+const Transform *Scene::GetTransform(Entity entity) const
+{
+    uint32_t row;
+    auto chunk = GetChunk(entity, row);
+    if (!chunk || chunk->transforms.empty())
+        return nullptr;
+    return &chunk->transforms[row];
+}
+
+const mat4 *Scene::GetWorldTransform(Entity entity) const
+{
+    uint32_t row;
+    auto chunk = GetChunk(entity, row);
+    if (!chunk || chunk->worlds.empty())
+        return nullptr;
+    return &chunk->worlds[row];
+}
+
+void Scene::SetMesh(Entity entity, uint32_t mesh)
+{
+    uint32_t row;
+    auto chunk = GetChunk(entity, row);
+    if (chunk && !chunk->meshes.empty())
+        chunk->meshes[row] = mesh;
+}
+
+void Scene::SetMaterial(Entity entity, uint32_t material)
+{
+    uint32_t row;
+    auto chunk = GetChunk(entity, row);
+    if (chunk && !chunk->materials.empty())
+        chunk->materials[row] = material;
+}
+
+void Scene::SetFlags(Entity entity, uint32_t flags)
+{
+    uint32_t row;
+    auto chunk = GetChunk(entity, row);
+    if (chunk && !chunk->flags.empty())
+        chunk->flags[row] = flags;
+}
+
+uint32_t Scene::GetFlags(Entity entity) const
+{
+    uint32_t row;
+    auto chunk = GetChunk(entity, row);
+    if (!chunk || chunk->flags.empty())
+        return 0;
+    return chunk->flags[row];
+}
+
+void Scene::GetChunks(uint32_t componentMask, std::vector<SceneChunk *> &chunks)
+{
+    chunks.clear();
+    ForEachChunk(componentMask, [&](SceneChunk &chunk)
+                 { chunks.push_back(&chunk); });
+}
+
+void Scene::UpdateTransforms()
+{
+    ForEachChunk(COMPONENT_TRANSFORM, UpdateChunkTransforms);
+}
+
+void Scene::UpdateChunkTransforms(SceneChunk &chunk)
+{
+    // Transform은 값이 바뀐 경우에만 행렬을 다시 계산
+    for (uint32_t i = 0; i < chunk.count; i++)
+        chunk.worlds[i] = chunk.transforms[i].GetTransform();
+}
+
+void Scene::Render(uint32_t flags, const mat4 &view, const mat4 &projection,
+                   const MaterialPtr &optionMat)
+{
+    auto viewProjection = projection * view;
+    ForEachChunk(COMPONENT_RENDERABLE, [&](SceneChunk &chunk)
+                 {
+        for (uint32_t i = 0; i < chunk.count; i++)
+        {
+            if ((chunk.flags[i] & flags) != flags)
+                continue;
+
+            const auto &material = optionMat ? optionMat : m_materials[chunk.materials[i]];
+            material->SetProperty("transform", viewProjection * chunk.worlds[i]);
+            material->SetProperty("modelTransform", chunk.worlds[i]);
+            material->Apply();
+            m_meshes[chunk.meshes[i]]->Draw();
+        } });
+}
@@ -0,0 +1,127 @@
+#pragma once
+
+#include "common.h"
+#include "transform.h"
+#include "mesh.h"
+#include "material.h"
+#include <vector>
+
+// 렌더링 분류 플래그. Scene::Render에서 모든 비트가 일치하는 엔티티만 그림
+enum RenderFlag : uint32_t
+{
+    RENDER_FORWARD = 1 << 0,
+    RENDER_DEFERRED = 1 << 1,
+    RENDER_SHADOW_CASTER = 1 << 2,
+    RENDER_TRANSPARENT = 1 << 3,
+};
+
+enum ComponentType : uint32_t
+{
+    COMPONENT_TRANSFORM = 1 << 0, // Transform + 계산된 world 행렬
+    COMPONENT_MESH = 1 << 1,
+    COMPONENT_MATERIAL = 1 << 2,
+    COMPONENT_RENDER = 1 << 3, // RenderFlag
+};
+const uint32_t COMPONENT_RENDERABLE = COMPONENT_TRANSFORM | COMPONENT_MESH |
+                                      COMPONENT_MATERIAL | COMPONENT_RENDER;
+
+using Entity = uint32_t;
+const Entity INVALID_ENTITY = 0xFFFFFFFF;
+
+// 같은 컴포넌트 조합(archetype)을 가진 엔티티들을 성분별 배열로 저장하는 단위
+struct SceneChunk
+{
+    static constexpr uint32_t CAPACITY = 1024;
+
+    uint32_t count{0};
+    std::vector<Entity> entities;
+    std::vector<Transform> transforms;
+    std::vector<mat4> worlds;
+    std::vector<uint32_t> meshes;    // Scene::AddMesh 인덱스
+    std::vector<uint32_t> materials; // Scene::AddMaterial 인덱스
+    std::vector<uint32_t> flags;
+};
+
+struct SceneArchetype
+{
+    uint32_t mask{0};
+    std::vector<std::unique_ptr<SceneChunk>> chunks;
+};
+
+// 엔티티-컴포넌트 저장소
+// 메쉬/매터리얼은 테이블에 등록하고 엔티티는 인덱스만 가짐
+CLASS_PTR(Scene)
+class Scene
+{
+public:
+    static SceneUPtr Create();
+    ~Scene() = default;
+
+    uint32_t AddMesh(const MeshPtr &mesh);
+    uint32_t AddMaterial(const MaterialPtr &material);
+    const MeshPtr &GetMesh(uint32_t index) const { return m_meshes[index]; }
+    const MaterialPtr &GetMaterial(uint32_t index) const { return m_materials[index]; }
+
+    Entity CreateEntity(uint32_t componentMask);
+    Entity CreateRenderable(const Transform &trf, uint32_t mesh, uint32_t material, uint32_t flags);
+    void DestroyEntity(Entity entity);
+    bool IsAlive(Entity entity) const;
+    size_t GetEntityCount() const { return m_entityCount; }
+
+    // 컴포넌트가 없는 엔티티에 대해서는 무시
+    void SetTransform(Entity entity, const Transform &trf);
+    const Transform *GetTransform(Entity entity) const;
+    const mat4 *GetWorldTransform(Entity entity) const;
+    void SetMesh(Entity entity, uint32_t mesh);
+    void SetMaterial(Entity entity, uint32_t material);
+    void SetFlags(Entity entity, uint32_t flags);
+    uint32_t GetFlags(Entity entity) const;
+
+    // componentMask를 모두 가진 archetype의 chunk마다 func(SceneChunk &) 호출
+    template <typename Func>
+    void ForEachChunk(uint32_t componentMask, Func &&func)
+    {
+        for (auto &archetype : m_archetypes)
+        {
+            if ((archetype->mask & componentMask) != componentMask)
+                continue;
+            for (auto &chunk : archetype->chunks)
+            {
+                if (chunk->count > 0)
+                    func(*chunk);
+            }
+        }
+    }
+
+    // componentMask를 모두 가진 chunk 목록 (job 분배용)
+    void GetChunks(uint32_t componentMask, std::vector<SceneChunk *> &chunks);
+
+    // system : world 행렬 갱신
+    void UpdateTransforms();
+    static void UpdateChunkTransforms(SceneChunk &chunk);
+    // system : flags를 모두 가진 엔티티 렌더링. optionMat이 있으면 모든 엔티티에 대신 사용
+    void Render(uint32_t flags, const mat4 &view, const mat4 &projection,
+                const MaterialPtr &optionMat = nullptr);
+
+private:
+    Scene() {}
+
+    struct EntityRecord
+    {
+        SceneArchetype *archetype{nullptr};
+        uint32_t chunk{0};
+        uint32_t row{0};
+    };
+
+    SceneArchetype *GetArchetype(uint32_t mask);
+    SceneChunk *GetChunk(Entity entity, uint32_t &row);
+    const SceneChunk *GetChunk(Entity entity, uint32_t &row) const;
+
+    std::vector<std::unique_ptr<SceneArchetype>> m_archetypes;
+    std::vector<EntityRecord> m_records;
+    std::vector<Entity> m_freeEntities;
+    size_t m_entityCount{0};
+
+    std::vector<MeshPtr> m_meshes;
+    std::vector<MaterialPtr> m_materials;
+};
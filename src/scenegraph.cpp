@@ -0,0 +1,143 @@
+#include "scenegraph.h"
+#include <algorithm>
+
+bool SceneNode::SetParent(SceneNode *parent)
+{
+    if (m_parent == parent)
+        return true;
+    for (auto ancestor = parent; ancestor; ancestor = ancestor->m_parent)
+    {
+        if (ancestor == this)
+        {
+            SPDLOG_ERROR("scene node cannot be parented under itself or its descendant");
+            return false;
+        }
+    }
+
+    if (m_parent)
+    {
+        auto &siblings = m_parent->m_children;
+        siblings.erase(std::remove(siblings.begin(), siblings.end(), this), siblings.end());
+    }
+    m_parent = parent;
+    if (m_parent)
+        m_parent->m_children.push_back(this);
+
+    UpdateDepth();
+    MarkDirty();
+    return true;
+}
+
+void SceneNode::SetLocal(const Transform &trf)
+{
+    m_local = trf;
+    MarkDirty();
+}
+
+void SceneNode::SetPosition(const vec3 &pos)
+{
+    m_local.SetPosition(pos);
+    MarkDirty();
+}
+
+void SceneNode::SetRotation(const quat &rot)
+{
+    m_local.SetRotation(rot);
+    MarkDirty();
+}
+
+void SceneNode::SetScale(const vec3 &scale)
+{
+    m_local.SetScale(scale);
+    MarkDirty();
+}
+
+void SceneNode::MarkDirty()
+{
+    if (m_dirty)
+        return;
+    m_dirty = true;
+    m_graph->m_dirtyNodes.push_back(this);
+}
+
+void SceneNode::UpdateDepth()
+{
+    // 부모가 바뀌면 서브트리 전체의 깊이가 바뀜
+    // 깊은 계층에서도 스택 오버플로우가 나지 않도록 UpdateSubtree와 같은 명시적 스택 사용
+    auto &stack = m_graph->m_stack;
+    stack.clear();
+    stack.push_back(this);
+    while (!stack.empty())
+    {
+        auto node = stack.back();
+        stack.pop_back();
+        node->m_depth = node->m_parent ? node->m_parent->m_depth + 1 : 0;
+        for (auto child : node->m_children)
+            stack.push_back(child);
+    }
+}
+
+SceneGraphUPtr SceneGraph::Create()
+{
+    return SceneGraphUPtr(new SceneGraph());
+}
+
+SceneNode *SceneGraph::CreateNode(const Transform &trf, SceneNode *parent)
+{
+    auto node = SceneNodeUPtr(new SceneNode(this, trf));
+    auto nodePtr = node.get();
+    m_nodes.push_back(std::move(node));
+    if (parent)
+        nodePtr->SetParent(parent);
+    nodePtr->MarkDirty();
+    return nodePtr;
+}
+
+void SceneGraph::Update(bool force)
+{
+    m_lastUpdateCount = 0;
+
+    if (force)
+    {
+        for (auto &node : m_nodes)
+        {
+            if (!node->m_parent)
+                UpdateSubtree(node.get());
+        }
+        m_dirtyNodes.clear();
+        return;
+    }
+
+    // 얕은 노드부터 처리하면 조상의 서브트리 갱신에서 자손의 dirty가 함께 해제되므로
+    // 같은 노드를 두번 계산하지 않음
+    std::sort(m_dirtyNodes.begin(), m_dirtyNodes.end(),
+              [](const SceneNode *a, const SceneNode *b)
+              { return a->m_depth < b->m_depth; });
+
+    for (auto node : m_dirtyNodes)
+    {
+        if (node->m_dirty)
+            UpdateSubtree(node);
+    }
+    m_dirtyNodes.clear();
+}
+
+void SceneGraph::UpdateSubtree(SceneNode *root)
+{
+    // 깊은 계층에서도 스택 오버플로우가 나지 않도록 재귀 대신 명시적 스택 사용
+    m_stack.clear();
+    m_stack.push_back(root);
+    while (!m_stack.empty())
+    {
+        auto node = m_stack.back();
+        m_stack.pop_back();
+
+        const auto &local = node->m_local.GetTransform();
+        node->m_world = node->m_parent ? node->m_parent->m_world * local : local;
+        node->m_dirty = false;
+        m_lastUpdateCount++;
+
+        for (auto child : node->m_children)
+            m_stack.push_back(child);
+    }
+}
@@ -0,0 +1,74 @@
+#pragma once
+
+#include "common.h"
+#include "transform.h"
+#include <vector>
+
+class SceneGraph;
+
+// 계층 구조의 노드. local transform과 world 행렬을 캐시하고
+// local이 바뀌면 dirty로 표시해서 SceneGraph::Update 때 해당 서브트리만 다시 계산
+CLASS_PTR(SceneNode)
+class SceneNode
+{
+    friend class SceneGraph;
+
+public:
+    ~SceneNode() = default;
+
+    SceneNode *GetParent() const { return m_parent; }
+    const std::vector<SceneNode *> &GetChildren() const { return m_children; }
+    // parent가 자기 자신이거나 자손이면 순환이 생기므로 false를 반환하고 바꾸지 않음
+    bool SetParent(SceneNode *parent);
+
+    const Transform &GetLocal() const { return m_local; }
+    void SetLocal(const Transform &trf);
+    void SetPosition(const vec3 &pos);
+    void SetRotation(const quat &rot);
+    void SetScale(const vec3 &scale);
+
+    // SceneGraph::Update 이후의 값
+    const mat4 &GetWorldTransform() const { return m_world; }
+    bool IsDirty() const { return m_dirty; }
+
+private:
+    SceneNode(SceneGraph *graph, const Transform &trf) : m_graph(graph), m_local(trf) {}
+    void MarkDirty();
+    void UpdateDepth();
+
+    SceneGraph *m_graph{nullptr};
+    SceneNode *m_parent{nullptr};
+    std::vector<SceneNode *> m_children;
+    uint32_t m_depth{0};
+
+    Transform m_local;
+    mat4 m_world{mat4(1.0f)};
+    bool m_dirty{false};
+};
+
+CLASS_PTR(SceneGraph)
+class SceneGraph
+{
+    friend class SceneNode;
+
+public:
+    static SceneGraphUPtr Create();
+    ~SceneGraph() = default;
+
+    SceneNode *CreateNode(const Transform &trf = Transform(), SceneNode *parent = nullptr);
+    size_t GetNodeCount() const { return m_nodes.size(); }
+
+    // dirty 노드의 서브트리만 world 행렬 갱신. force : 전체 노드 갱신
+    void Update(bool force = false);
+    // 마지막 Update에서 world 행렬을 다시 계산한 노드 수
+    size_t GetLastUpdateCount() const { return m_lastUpdateCount; }
+
+private:
+    SceneGraph() {}
+    void UpdateSubtree(SceneNode *node);
+
+    std::vector<SceneNodeUPtr> m_nodes;
+    std::vector<SceneNode *> m_dirtyNodes;
+    std::vector<SceneNode *> m_stack;
+    size_t m_lastUpdateCount{0};
+};
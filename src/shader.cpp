@@ -1,4 +1,53 @@
 #include "shader.h"
+#include <sstream>
+
+// include가 include를 부르다가 순환해도 멈추도록 깊이 제한
+static const int MAX_INCLUDE_DEPTH = 8;
+
+static std::optional<std::string> LoadSourceRecursive(const std::string &filename, int depth)
+{
+    auto text = LoadTextFile(filename);
+    if (!text)
+        return {};
+    if (text->find("#include") == std::string::npos)
+        return text;
+    if (depth >= MAX_INCLUDE_DEPTH)
+    {
+        SPDLOG_ERROR("shader include too deep: {}", filename);
+        return {};
+    }
+
+    auto slash = filename.find_last_of("/\\");
+    std::string directory = slash == std::string::npos ? "" : filename.substr(0, slash + 1);
+    std::istringstream lines(text.value());
+    std::string result, line;
+    int lineNumber = 0;
+    while (std::getline(lines, line))
+    {
+        lineNumber++;
+        auto begin = line.find("#include \"");
+        auto end = begin == std::string::npos ? std::string::npos : line.find('"', begin + 10);
+        if (begin != 0 || end == std::string::npos)
+        {
+            result += line + "\n";
+            continue;
+        }
+        auto included = LoadSourceRecursive(directory + line.substr(begin + 10, end - begin - 10), depth + 1);
+        if (!included)
+            return {};
+        result += included.value();
+        if (!result.empty() && result.back() != '\n')
+            result += "\n";
+        // 컴파일 에러의 줄 번호가 원래 파일 기준이 되도록 되돌림
+        result += fmt::format("#line {}\n", lineNumber + 1);
+    }
+    return result;
+}
+
+std::optional<std::string> Shader::LoadSource(const std::string &filename)
+{
+    return LoadSourceRecursive(filename, 0);
+}
 
 ShaderUPtr Shader::CreateFromFile(const std::string &filename,
                                   GLenum shaderType)
@@ -11,13 +60,27 @@ ShaderUPtr Shader::CreateFromFile(const std::string &filename,
     return std::move(shader);
 }
 
+ShaderUPtr Shader::CreateFromSource(const std::string &code, GLenum shaderType,
+                                    const std::string &name)
+{
+    auto shader = ShaderUPtr(new Shader());
+    if (!shader->Compile(code, shaderType, name))
+    {
+        throw std::string("shader compile fail - " + name);
+    }
+    return std::move(shader);
+}
+
 bool Shader::LoadFile(const std::string &filename, GLenum shaderType)
 {
-    auto result = LoadTextFile(filename);
+    auto result = LoadSource(filename);
     if (!result.has_value())
         return false;
+    return Compile(result.value(), shaderType, filename);
+}
 
-    auto &code = result.value();
+bool Shader::Compile(const std::string &code, GLenum shaderType, const std::string &name)
+{
     const char *codePtr = code.c_str();
     int32_t codeLength = (int32_t)code.length();
 
@@ -33,7 +96,7 @@ bool Shader::LoadFile(const std::string &filename, GLenum shaderType)
     {
         char infoLog[1024];
         glGetShaderInfoLog(m_shader, 1024, nullptr, infoLog);
-        SPDLOG_ERROR("failed to compile shader: \"{}\"", filename);
+        SPDLOG_ERROR("failed to compile shader: \"{}\"", name);
         SPDLOG_ERROR("reason: {}", infoLog);
         return false;
     }
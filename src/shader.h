@@ -7,6 +7,12 @@ class Shader
 public:
     static ShaderUPtr CreateFromFile(const std::string &filename,
                                      GLenum shaderType);
+    // 이미 읽어둔 소스로 생성. name은 에러 출력용
+    static ShaderUPtr CreateFromSource(const std::string &code, GLenum shaderType,
+                                       const std::string &name = "");
+    // 파일을 읽고 #include "파일" 줄을 같은 디렉토리의 파일 내용으로 바꿈
+    // 여러 셰이더가 같이 쓰는 함수(normal_encoding.glsl 등)를 한 곳에 둘 수 있음
+    static std::optional<std::string> LoadSource(const std::string &filename);
 
     ~Shader();
     uint32_t Get() const { return m_shader; }
@@ -14,5 +20,6 @@ public:
 private:
     Shader() {}
     bool LoadFile(const std::string &filename, GLenum shaderType);
+    bool Compile(const std::string &code, GLenum shaderType, const std::string &name);
     uint32_t m_shader{0};
 };
\ No newline at end of file
@@ -1,4 +1,7 @@
 #include "shadowmap.h"
+#include "capture.h"
+#include "renderstats.h"
+#include <cfloat>
 
 ShadowMapUPtr ShadowMap::Create(int width, int height)
 {
@@ -13,17 +16,21 @@ ShadowMap::~ShadowMap()
     if (m_framebuffer)
     {
         glDeleteFramebuffers(1, &m_framebuffer);
+        RenderStats::TrackFramebuffer(-1, 0);
     }
 }
 
 void ShadowMap::Bind() const
 {
     glBindFramebuffer(GL_FRAMEBUFFER, m_framebuffer);
+    FrameCapture::RecordBindFramebuffer(m_framebuffer);
+    RenderStats::AddFramebufferBind();
 }
 
 bool ShadowMap::Init(int width, int height)
 {
     glGenFramebuffers(1, &m_framebuffer);
+    RenderStats::TrackFramebuffer(1, 0);
     Bind();
 
     m_shadowMap = Texture::Create(width, height, GL_DEPTH_COMPONENT, GL_FLOAT);
@@ -44,4 +51,122 @@ bool ShadowMap::Init(int width, int height)
     }
     glBindFramebuffer(GL_FRAMEBUFFER, 0);
     return true;
-}
\ No newline at end of file
+}
+
+// cascade 구간보다 광원 쪽으로 이만큼 더 떨어진 물체까지 그림자를 드리움
+static const float SHADOW_CASTER_DISTANCE = 20.0f;
+
+CascadedShadowMapUPtr CascadedShadowMap::Create(int resolution, int cascadeCount)
+{
+    auto shadowMap = CascadedShadowMapUPtr(new CascadedShadowMap());
+    if (!shadowMap->Init(resolution, cascadeCount))
+        return nullptr;
+    return std::move(shadowMap);
+}
+
+CascadedShadowMap::~CascadedShadowMap()
+{
+    if (m_framebuffer)
+    {
+        glDeleteFramebuffers(1, &m_framebuffer);
+        RenderStats::TrackFramebuffer(-1, 0);
+    }
+}
+
+void CascadedShadowMap::Bind() const
+{
+    glBindFramebuffer(GL_FRAMEBUFFER, m_framebuffer);
+    FrameCapture::RecordBindFramebuffer(m_framebuffer);
+    RenderStats::AddFramebufferBind();
+}
+
+bool CascadedShadowMap::Init(int resolution, int cascadeCount)
+{
+    m_resolution = resolution;
+    m_cascadeCount = glm::clamp(cascadeCount, 1, MAX_CASCADES);
+
+    glGenFramebuffers(1, &m_framebuffer);
+    RenderStats::TrackFramebuffer(1, 0);
+    Bind();
+
+    m_shadowMap = TextureArray::Create(resolution, resolution, m_cascadeCount, GL_DEPTH_COMPONENT, GL_FLOAT);
+    m_shadowMap->SetFilter(GL_NEAREST, GL_NEAREST);
+    m_shadowMap->SetWrap(GL_CLAMP_TO_BORDER, GL_CLAMP_TO_BORDER);
+    m_shadowMap->SetBorderColor(glm::vec4(1.0f));
+
+    // layer 전체를 붙이면 geometry shader의 gl_Layer로 그릴 layer를 고름
+    glFramebufferTexture(GL_FRAMEBUFFER, GL_DEPTH_ATTACHMENT, m_shadowMap->Get(), 0);
+    glDrawBuffer(GL_NONE);
+    glReadBuffer(GL_NONE);
+    auto status = glCheckFramebufferStatus(GL_FRAMEBUFFER);
+    if (status != GL_FRAMEBUFFER_COMPLETE)
+    {
+        SPDLOG_ERROR("failed to complete cascaded shadow map framebuffer: {:x}", status);
+        glBindFramebuffer(GL_FRAMEBUFFER, 0);
+        return false;
+    }
+    glBindFramebuffer(GL_FRAMEBUFFER, 0);
+    return true;
+}
+
+void CascadedShadowMap::Update(const glm::mat4 &cameraView, float fovy, float aspect, float nearPlane,
+                               float shadowDistance, const glm::vec3 &lightDir, float lambda)
+{
+    // 원점을 지나는 light view. 카메라 위치와 무관하므로 texel 단위로 맞춘 투영이 프레임 사이에 유지됨
+    glm::vec3 dir = glm::normalize(lightDir);
+    glm::vec3 up = fabsf(dir.y) > 0.99f ? glm::vec3(0.0f, 0.0f, 1.0f) : glm::vec3(0.0f, 1.0f, 0.0f);
+    m_lightView = glm::lookAt(glm::vec3(0.0f), dir, up);
+
+    glm::mat4 inverseView = glm::inverse(cameraView);
+    float tanHalfFovy = tanf(fovy * 0.5f);
+    float ratio = shadowDistance / nearPlane;
+    float splitNear = nearPlane;
+    glm::vec3 boundsMin(FLT_MAX), boundsMax(-FLT_MAX);
+    m_splitDepths = glm::vec4(shadowDistance);
+    for (int i = 0; i < m_cascadeCount; i++)
+    {
+        // practical split : 로그 분할과 균등 분할을 lambda로 섞음
+        float t = (float)(i + 1) / m_cascadeCount;
+        float logSplit = nearPlane * powf(ratio, t);
+        float uniformSplit = nearPlane + (shadowDistance - nearPlane) * t;
+        float splitFar = glm::mix(uniformSplit, logSplit, lambda);
+        m_splitDepths[i] = splitFar;
+
+        // 구간(잘린 frustum)을 감싸는 구. 반지름은 카메라 방향과 무관하므로 회전해도 투영 크기가 변하지 않음
+        glm::vec3 corners[8];
+        glm::vec3 center(0.0f);
+        for (int c = 0; c < 8; c++)
+        {
+            float depth = c < 4 ? splitNear : splitFar;
+            float y = depth * tanHalfFovy * ((c & 1) ? 1.0f : -1.0f);
+            float x = depth * tanHalfFovy * aspect * ((c & 2) ? 1.0f : -1.0f);
+            corners[c] = glm::vec3(inverseView * glm::vec4(x, y, -depth, 1.0f));
+            center += corners[c] / 8.0f;
+        }
+        float radius = 0.0f;
+        for (auto &corner : corners)
+            radius = glm::max(radius, glm::length(corner - center));
+        radius = ceilf(radius * 16.0f) / 16.0f;
+
+        // 중심을 shadow map texel 크기 단위로 맞춰서 카메라가 움직여도 그림자 경계가 흔들리지 않게 함
+        // 맞추면서 최대 1 texel 밀리므로 양쪽에 1 texel씩 여유를 둠 (전체 폭 = texelSize * resolution)
+        glm::vec3 lightCenter = glm::vec3(m_lightView * glm::vec4(center, 1.0f));
+        float texelSize = 2.0f * radius / (m_resolution - 2);
+        lightCenter.x = floorf(lightCenter.x / texelSize) * texelSize;
+        lightCenter.y = floorf(lightCenter.y / texelSize) * texelSize;
+        float extent = radius + texelSize;
+
+        glm::vec3 minExtent = lightCenter - glm::vec3(extent, extent, radius);
+        glm::vec3 maxExtent = lightCenter + glm::vec3(extent, extent, radius + SHADOW_CASTER_DISTANCE);
+        // light view는 -z 방향을 보므로 near / far는 -z 기준 거리
+        glm::mat4 projection = glm::ortho(minExtent.x, maxExtent.x, minExtent.y, maxExtent.y,
+                                          -maxExtent.z, -minExtent.z);
+        m_viewProjections[i] = projection * m_lightView;
+
+        boundsMin = glm::min(boundsMin, minExtent);
+        boundsMax = glm::max(boundsMax, maxExtent);
+        splitNear = splitFar;
+    }
+    m_boundsProjection = glm::ortho(boundsMin.x, boundsMax.x, boundsMin.y, boundsMax.y,
+                                    -boundsMax.z, -boundsMin.z);
+}
@@ -25,4 +25,51 @@ private:
 
     uint32_t m_framebuffer{0}; // depth map에 렌더링을 하기 위한 프레임버퍼
     TexturePtr m_shadowMap;    // depth map 저장을 위한 텍스처
-};
\ No newline at end of file
+};
+
+// directional light용 cascaded shadow map
+// camera frustum을 near ~ shadowDistance 사이에서 cascade 개수만큼 깊이로 나누고
+// 구간마다 그 구간을 감싸는 orthographic 투영을 만들어 depth texture array의 layer 하나에 그림
+// 가까운 구간일수록 좁은 영역을 같은 해상도로 덮으므로 넓은 장면에서도 카메라 근처 그림자가 선명함
+// 모든 cascade는 geometry shader(gl_Layer)로 한 번의 pass에서 그림 (shadow_csm.gs)
+CLASS_PTR(CascadedShadowMap);
+class CascadedShadowMap
+{
+public:
+    static const int MAX_CASCADES = 4; // shadow_csm.gs, lighting_shadow.fs의 배열 크기와 같아야 함
+
+    static CascadedShadowMapUPtr Create(int resolution, int cascadeCount);
+    ~CascadedShadowMap();
+
+    const uint32_t Get() const { return m_framebuffer; }
+    void Bind() const;
+    const TextureArrayPtr GetShadowMap() const { return m_shadowMap; }
+    int GetResolution() const { return m_resolution; }
+    int GetCascadeCount() const { return m_cascadeCount; }
+
+    // cascade 구간과 투영을 다시 계산. fovy는 radian, lightDir은 빛이 나아가는 방향
+    // lambda : 0이면 균등 분할, 1이면 로그 분할 (practical split scheme)
+    void Update(const glm::mat4 &cameraView, float fovy, float aspect, float nearPlane,
+                float shadowDistance, const glm::vec3 &lightDir, float lambda);
+
+    const glm::mat4 &GetViewProjection(int cascade) const { return m_viewProjections[cascade]; }
+    // cascade i가 끝나는 view space 깊이. 쓰지 않는 칸은 shadowDistance
+    const glm::vec4 &GetSplitDepths() const { return m_splitDepths; }
+    // 모든 cascade를 감싸는 light view / projection. shadow caster culling에 사용
+    const glm::mat4 &GetLightView() const { return m_lightView; }
+    const glm::mat4 &GetBoundsProjection() const { return m_boundsProjection; }
+
+private:
+    CascadedShadowMap() {}
+    bool Init(int resolution, int cascadeCount);
+
+    uint32_t m_framebuffer{0};
+    TextureArrayPtr m_shadowMap;
+    int m_resolution{0};
+    int m_cascadeCount{0};
+
+    glm::mat4 m_viewProjections[MAX_CASCADES];
+    glm::vec4 m_splitDepths{0.0f};
+    glm::mat4 m_lightView{1.0f};
+    glm::mat4 m_boundsProjection{1.0f};
+};
@@ -0,0 +1,248 @@
+#include "simulation.h"
+
+SimulationUPtr Simulation::Create(const Camera &camera, const Light &light, float tickRate)
+{
+    auto simulation = SimulationUPtr(new Simulation());
+    simulation->Init(camera, light, tickRate);
+    return std::move(simulation);
+}
+
+Simulation::~Simulation()
+{
+    Stop();
+}
+
+void Simulation::Init(const Camera &camera, const Light &light, float tickRate)
+{
+    m_prevCamera = camera;
+    m_camera = camera;
+    m_light = light;
+    m_tickRate = tickRate;
+    m_timer = Timer::Create(1.0 / tickRate);
+    // 첫 Acquire 전에도 유효한 값을 읽을 수 있도록 초기 상태를 publish
+    PublishSnapshot();
+}
+
+void Simulation::Start()
+{
+    if (m_thread.joinable())
+        return;
+    m_running = true;
+    m_thread = std::thread([this]
+                           { ThreadLoop(); });
+}
+
+void Simulation::Stop()
+{
+    if (!m_thread.joinable())
+        return;
+    m_running = false;
+    m_thread.join();
+}
+
+void Simulation::ThreadLoop()
+{
+    while (m_running)
+    {
+        RunPendingTicks();
+        // 다음 tick 경계까지 대기
+        double remain = m_timer->GetFixedStep() * (1.0 - m_timer->GetAlpha());
+        std::this_thread::sleep_for(std::chrono::duration<double>(remain));
+    }
+}
+
+void Simulation::RunPendingTicks()
+{
+    m_timer->SetFixedStep(1.0 / m_tickRate.load());
+    m_timer->Tick();
+    // 한 번에 처리하는 step 수는 Timer의 최대 프레임 간격으로 제한됨
+    while (m_timer->Step())
+        Tick((float)m_timer->GetFixedStep());
+}
+
+void Simulation::Advance(double deltaTime)
+{
+    m_timer->SetFixedStep(1.0 / m_tickRate.load());
+    m_timer->Advance(deltaTime);
+    while (m_timer->Step())
+        Tick((float)m_timer->GetFixedStep());
+}
+
+void Simulation::Tick(float deltaTime)
+{
+    auto start = std::chrono::steady_clock::now();
+
+    InputState input;
+    bool animation;
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        input = m_input;
+        m_input.mouseDelta = vec2(0.0f);
+        animation = m_animation;
+        m_prevCamera = m_camera;
+        if (m_cameraOverride)
+        {
+            // 순간 이동은 보간하지 않음
+            m_camera = *m_cameraOverride;
+            m_prevCamera = m_camera;
+            m_cameraVersion = m_cameraOverrideVersion;
+            m_cameraOverride.reset();
+        }
+        if (m_lightOverride)
+        {
+            m_light = *m_lightOverride;
+            m_lightVersion = m_lightOverrideVersion;
+            m_lightOverride.reset();
+        }
+        for (auto &entity : m_addedEntities)
+            m_entities.push_back(entity);
+        m_addedEntities.clear();
+    }
+
+    UpdateCamera(input, deltaTime);
+
+    for (auto &entity : m_entities)
+        entity.previous = entity.transform;
+    if (animation)
+    {
+        for (auto &entity : m_entities)
+        {
+            auto rotation = Transform::EulerToQuat(entity.angularVelocity * deltaTime);
+            entity.transform.SetRotation(normalize(rotation * entity.transform.GetRotation()));
+        }
+    }
+
+    PublishSnapshot();
+
+    auto end = std::chrono::steady_clock::now();
+    m_tickTime = std::chrono::duration<float, std::milli>(end - start).count();
+}
+
+void Simulation::UpdateCamera(const InputState &input, float deltaTime)
+{
+    m_camera.Control = input.control;
+    if (input.control)
+    {
+        const float cameraRotSpeed = 0.5f;
+        m_camera.Yaw -= input.mouseDelta.x * cameraRotSpeed;
+        m_camera.Pitch -= input.mouseDelta.y * cameraRotSpeed;
+
+        if (m_camera.Yaw < 0.0f)
+            m_camera.Yaw += 360.0f;
+        if (m_camera.Yaw > 360.0f)
+            m_camera.Yaw -= 360.0f;
+
+        if (m_camera.Pitch > 89.0f)
+            m_camera.Pitch = 89.0f;
+        if (m_camera.Pitch < -89.0f)
+            m_camera.Pitch = -89.0f;
+    }
+
+    m_camera.Front = rotate(mat4(1.0f), radians(m_camera.Yaw), vec3(0.0f, 1.0f, 0.0f)) *
+                     rotate(mat4(1.0f), radians(m_camera.Pitch), vec3(1.0f, 0.0f, 0.0f)) *
+                     vec4(0.0f, 0.0f, -1.0f, 0.0f); // 4차원 성분이 0이면 벡터, 1이면 점
+
+    if (!input.control)
+        return;
+
+    // 초당 이동 거리. tick 간격을 곱하므로 tick rate나 프레임 속도와 무관
+    const float cameraSpeed = 3.0f * deltaTime;
+    if (input.forward)
+        m_camera.Pos += cameraSpeed * m_camera.Front;
+    if (input.backward)
+        m_camera.Pos -= cameraSpeed * m_camera.Front;
+
+    auto cameraRight = normalize(cross(m_camera.Up, -m_camera.Front));
+    if (input.right)
+        m_camera.Pos += cameraSpeed * cameraRight;
+    if (input.left)
+        m_camera.Pos -= cameraSpeed * cameraRight;
+
+    auto cameraUp = normalize(cross(-m_camera.Front, cameraRight));
+    if (input.up)
+        m_camera.Pos += cameraSpeed * cameraUp;
+    if (input.down)
+        m_camera.Pos -= cameraSpeed * cameraUp;
+}
+
+void Simulation::PublishSnapshot()
+{
+    auto &snapshot = m_snapshots.GetWriteBuffer();
+    snapshot.tick = m_timer->GetStepCount();
+    snapshot.time = (double)m_timer->GetStepCount() * m_timer->GetFixedStep();
+    snapshot.step = (float)m_timer->GetFixedStep();
+    snapshot.stepTime = m_timer->GetStepTime();
+    snapshot.prevCamera = m_prevCamera;
+    snapshot.camera = m_camera;
+    snapshot.light = m_light;
+    snapshot.cameraVersion = m_cameraVersion;
+    snapshot.lightVersion = m_lightVersion;
+    // 슬롯을 재사용하므로 vector 용량은 유지됨
+    snapshot.transforms.resize(m_entities.size());
+    for (size_t i = 0; i < m_entities.size(); i++)
+        snapshot.transforms[i] = {m_entities[i].entity, m_entities[i].previous, m_entities[i].transform};
+    snapshot.publishTime = std::chrono::steady_clock::now();
+    m_snapshots.Publish();
+}
+
+void Simulation::SetInput(const InputState &input)
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    // 마우스 이동량은 simulation이 가져갈 때까지 누적
+    vec2 mouseDelta = m_input.mouseDelta + input.mouseDelta;
+    m_input = input;
+    m_input.mouseDelta = mouseDelta;
+}
+
+uint64_t Simulation::SetCamera(const Camera &camera)
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_cameraOverride = camera;
+    return ++m_cameraOverrideVersion;
+}
+
+uint64_t Simulation::SetLight(const Light &light)
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_lightOverride = light;
+    return ++m_lightOverrideVersion;
+}
+
+void Simulation::SetAnimation(bool animation)
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_animation = animation;
+}
+
+void Simulation::AddAnimatedEntity(Entity entity, const Transform &trf, const vec3 &angularVelocity)
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_addedEntities.push_back({entity, trf, angularVelocity});
+}
+
+void Simulation::SetTickRate(float tickRate)
+{
+    m_tickRate = glm::max(tickRate, 1.0f);
+}
+
+const FrameSnapshot &Simulation::Acquire()
+{
+    m_snapshots.Update();
+    auto &snapshot = m_snapshots.GetReadBuffer();
+
+    // 새 snapshot이 없더라도 화면에 보이는 상태의 나이를 측정
+    auto now = std::chrono::steady_clock::now();
+    if (IsThreaded())
+    {
+        float sinceStep = std::chrono::duration<float>(now - snapshot.stepTime).count();
+        m_alpha = glm::clamp(sinceStep / snapshot.step, 0.0f, 1.0f);
+    }
+    else
+    {
+        // 같은 스레드에서 진행했으므로 accumulator에 남은 비율을 그대로 사용
+        m_alpha = m_timer->GetAlpha();
+    }
+    m_latency = std::chrono::duration<float, std::milli>(now - snapshot.publishTime).count();
+    m_averageLatency = m_averageLatency * 0.95f + m_latency * 0.05f;
+    return snapshot;
+}
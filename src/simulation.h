@@ -0,0 +1,161 @@
+#pragma once
+
+#include "common.h"
+#include "transform.h"
+#include "scene.h"
+#include "triplebuffer.h"
+#include "timer.h"
+#include <atomic>
+#include <chrono>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+using namespace glm;
+
+struct Camera
+{
+public:
+    mat4 projection;
+    mat4 view;
+    vec3 Pos{vec3(0.0f, 2.0f, 12.0f)};
+    float Pitch{0.0f};
+    float Yaw{0.0f};
+    vec3 Front{vec3(0.0f, 0.0f, -1.0f)};
+    vec3 Up{vec3(0.0f, 1.0f, 0.0f)};
+    bool Control{false};
+};
+
+struct Light
+{
+    bool directional{false};
+    vec3 position{vec3(2.0f, 4.0f, 4.0f)};
+    vec3 direction{vec3(-0.5f, -1.5f, -1.0f)};
+    // inner cut-off angle, offset angle
+    vec2 cutoff{vec2(50.0f, 5.0f)};
+    float distance{150.0f};
+    vec3 ambient{vec3(0.8f, 0.8f, 0.8f)};
+    vec3 diffuse{vec3(0.5f, 0.5f, 0.5f)};
+    vec3 specular{vec3(1.0f, 1.0f, 1.0f)};
+};
+
+// main 스레드에서 GLFW로부터 읽어 simulation에 전달하는 입력
+struct InputState
+{
+    bool control{false}; // 마우스 오른쪽 버튼을 누르고 있는 동안 카메라 조작
+    bool forward{false};
+    bool backward{false};
+    bool left{false};
+    bool right{false};
+    bool up{false};
+    bool down{false};
+    vec2 mouseDelta{vec2(0.0f)}; // 마지막 tick 이후 누적된 커서 이동량
+};
+
+struct EntityTransform
+{
+    Entity entity;
+    Transform previous; // 직전 tick 값. 렌더 쪽에서 보간에 사용
+    Transform transform;
+};
+
+// simulation tick 결과. 렌더 스레드는 이 값만 읽음
+struct FrameSnapshot
+{
+    uint64_t tick{0};
+    double time{0.0}; // simulation 시간(초)
+    float step{1.0f / 60.0f}; // 이 snapshot을 만든 tick 간격(초)
+    std::chrono::steady_clock::time_point publishTime;
+    std::chrono::steady_clock::time_point stepTime; // tick이 나타내는 실제 시각
+    Camera prevCamera;
+    Camera camera; // projection은 렌더 쪽에서 화면 비율로 계산
+    Light light;
+    // 이 snapshot에 반영된 마지막 SetCamera/SetLight 번호
+    uint64_t cameraVersion{0};
+    uint64_t lightVersion{0};
+    std::vector<EntityTransform> transforms;
+};
+
+// 고정된 tick rate(Timer의 fixed step)로 입력, 카메라, 애니메이션을 갱신하고 FrameSnapshot을 triple buffer로 넘김
+// 별도 스레드(Start) 또는 렌더 스레드에서 직접(Advance) 실행 가능
+CLASS_PTR(Simulation)
+class Simulation
+{
+public:
+    static SimulationUPtr Create(const Camera &camera, const Light &light, float tickRate = 60.0f);
+    ~Simulation();
+
+    void Start();
+    void Stop();
+    bool IsThreaded() const { return m_thread.joinable(); }
+    // 스레드를 쓰지 않을 때 렌더 스레드에서 호출. deltaTime(초)만큼 누적 후 밀린 tick 실행
+    void Advance(double deltaTime);
+
+    // main 스레드에서 호출. 다음 tick에 반영됨
+    void SetInput(const InputState &input);
+    // 반환값 : 변경 번호. snapshot의 cameraVersion/lightVersion이 이 값 이상이면 반영된 것
+    uint64_t SetCamera(const Camera &camera);
+    uint64_t SetLight(const Light &light);
+    void SetAnimation(bool animation);
+    // angularVelocity : 각 축 회전 속도(degree/s)
+    void AddAnimatedEntity(Entity entity, const Transform &trf, const vec3 &angularVelocity);
+
+    void SetTickRate(float tickRate);
+    float GetTickRate() const { return m_tickRate.load(); }
+
+    // 렌더 스레드에서 호출. 가장 최근 snapshot, 새 snapshot이 없으면 이전 것을 반환
+    const FrameSnapshot &Acquire();
+    // 마지막 Acquire 시점의 보간 비율. 0이면 prev 상태, 1이면 현재 상태
+    float GetAlpha() const { return m_alpha; }
+    // publish 후 렌더 스레드가 사용하기까지 걸린 시간(ms)
+    float GetSnapshotLatency() const { return m_latency; }
+    float GetAverageLatency() const { return m_averageLatency; }
+    float GetTickTime() const { return m_tickTime.load(); }
+
+private:
+    Simulation() {}
+    void Init(const Camera &camera, const Light &light, float tickRate);
+    void ThreadLoop();
+    void RunPendingTicks();
+    void Tick(float deltaTime);
+    void UpdateCamera(const InputState &input, float deltaTime);
+    void PublishSnapshot();
+
+    struct AnimatedEntity
+    {
+        Entity entity;
+        Transform transform;
+        vec3 angularVelocity;
+        Transform previous;
+    };
+
+    // simulation 스레드만 접근
+    Camera m_prevCamera;
+    Camera m_camera;
+    Light m_light;
+    uint64_t m_cameraVersion{0};
+    uint64_t m_lightVersion{0};
+    std::vector<AnimatedEntity> m_entities;
+    TimerUPtr m_timer;
+
+    // main 스레드 -> simulation 스레드
+    std::mutex m_mutex;
+    InputState m_input;
+    std::optional<Camera> m_cameraOverride;
+    std::optional<Light> m_lightOverride;
+    uint64_t m_cameraOverrideVersion{0};
+    uint64_t m_lightOverrideVersion{0};
+    std::vector<AnimatedEntity> m_addedEntities;
+    bool m_animation{true};
+
+    TripleBuffer<FrameSnapshot> m_snapshots;
+    std::thread m_thread;
+    std::atomic<bool> m_running{false};
+    std::atomic<float> m_tickRate{60.0f};
+    std::atomic<float> m_tickTime{0.0f}; // ms
+
+    // 렌더 스레드만 접근
+    float m_latency{0.0f};
+    float m_averageLatency{0.0f};
+    float m_alpha{1.0f};
+};
@@ -1,4 +1,7 @@
 #include "texture.h"
+#include "capture.h"
+#include "renderstats.h"
+#include <algorithm>
 
 TextureUPtr Texture::CreateFromImage(const ImagePtr image)
 {
@@ -23,11 +26,15 @@ Texture::~Texture()
     {
         glDeleteTextures(1, &m_texture);
     }
+    if (m_memorySize)
+        RenderStats::TrackTexture(-1, -(int64_t)m_memorySize);
 }
 
 void Texture::Bind() const
 {
     glBindTexture(GL_TEXTURE_2D, m_texture);
+    FrameCapture::RecordBindTexture(GL_TEXTURE_2D, m_texture);
+    RenderStats::AddTextureBind();
 }
 
 void Texture::SetFilter(uint32_t minFilter, uint32_t magFilter) const
@@ -86,6 +93,7 @@ void Texture::SetTextureFromImage(const ImagePtr image)
                  image->GetData());
 
     glGenerateMipmap(GL_TEXTURE_2D);
+    SetMemorySize(RenderStats::GetTextureSize(m_format, m_width, m_height, true));
 }
 
 void Texture::SetTextureFormat(int width, int height, uint32_t format, uint32_t type)
@@ -100,6 +108,10 @@ void Texture::SetTextureFormat(int width, int height, uint32_t format, uint32_t
     {
         imageFormat = GL_DEPTH_COMPONENT;
     }
+    else if (m_format == GL_DEPTH24_STENCIL8)
+    {
+        imageFormat = GL_DEPTH_STENCIL;
+    }
     else if (m_format == GL_RGB ||
              m_format == GL_RGB16F ||
              m_format == GL_RGB32F)
@@ -107,6 +119,7 @@ void Texture::SetTextureFormat(int width, int height, uint32_t format, uint32_t
         imageFormat = GL_RGB;
     }
     else if (m_format == GL_RG ||
+             m_format == GL_RG16 ||
              m_format == GL_RG16F ||
              m_format == GL_RG32F)
     {
@@ -121,6 +134,13 @@ void Texture::SetTextureFormat(int width, int height, uint32_t format, uint32_t
     }
 
     glTexImage2D(GL_TEXTURE_2D, 0, m_format, m_width, m_height, 0, imageFormat, m_type, nullptr);
+    SetMemorySize(RenderStats::GetTextureSize(m_format, m_width, m_height));
+}
+
+void Texture::SetMemorySize(size_t size)
+{
+    RenderStats::TrackTexture(m_memorySize ? 0 : 1, (int64_t)size - (int64_t)m_memorySize);
+    m_memorySize = size;
 }
 
 CubeTextureUPtr CubeTexture::CreateFromImages(const std::vector<Image *> &images)
@@ -137,11 +157,15 @@ CubeTexture::~CubeTexture()
     {
         glDeleteTextures(1, &m_texture);
     }
+    if (m_memorySize)
+        RenderStats::TrackTexture(-1, -(int64_t)m_memorySize);
 }
 
 void CubeTexture::Bind() const
 {
     glBindTexture(GL_TEXTURE_CUBE_MAP, m_texture);
+    FrameCapture::RecordBindTexture(GL_TEXTURE_CUBE_MAP, m_texture);
+    RenderStats::AddTextureBind();
 }
 
 bool CubeTexture::InitFromImages(const std::vector<Image *> &images)
@@ -178,7 +202,143 @@ bool CubeTexture::InitFromImages(const std::vector<Image *> &images)
                      image->GetWidth(), image->GetHeight(), 0,
                      format, GL_UNSIGNED_BYTE,
                      image->GetData());
+        m_memorySize += RenderStats::GetTextureSize(GL_RGB, image->GetWidth(), image->GetHeight());
     }
+    RenderStats::TrackTexture(1, m_memorySize);
 
     return true;
-}
\ No newline at end of file
+}
+TextureArrayUPtr TextureArray::Create(int width, int height, int layers, uint32_t format, uint32_t type)
+{
+    auto texture = TextureArrayUPtr(new TextureArray());
+    texture->Init(width, height, layers, format, type);
+    return std::move(texture);
+}
+
+TextureArray::~TextureArray()
+{
+    if (m_texture)
+    {
+        glDeleteTextures(1, &m_texture);
+    }
+    if (m_memorySize)
+        RenderStats::TrackTexture(-1, -(int64_t)m_memorySize);
+}
+
+void TextureArray::Bind() const
+{
+    glBindTexture(GL_TEXTURE_2D_ARRAY, m_texture);
+    FrameCapture::RecordBindTexture(GL_TEXTURE_2D_ARRAY, m_texture);
+    RenderStats::AddTextureBind();
+}
+
+void TextureArray::SetFilter(uint32_t minFilter, uint32_t magFilter) const
+{
+    glTexParameteri(GL_TEXTURE_2D_ARRAY, GL_TEXTURE_MIN_FILTER, minFilter);
+    glTexParameteri(GL_TEXTURE_2D_ARRAY, GL_TEXTURE_MAG_FILTER, magFilter);
+}
+
+void TextureArray::SetWrap(uint32_t sWrap, uint32_t tWrap) const
+{
+    glTexParameteri(GL_TEXTURE_2D_ARRAY, GL_TEXTURE_WRAP_S, sWrap);
+    glTexParameteri(GL_TEXTURE_2D_ARRAY, GL_TEXTURE_WRAP_T, tWrap);
+}
+
+void TextureArray::SetBorderColor(const glm::vec4 &color) const
+{
+    glTexParameterfv(GL_TEXTURE_2D_ARRAY, GL_TEXTURE_BORDER_COLOR,
+                     glm::value_ptr(color));
+}
+
+void TextureArray::Init(int width, int height, int layers, uint32_t format, uint32_t type)
+{
+    m_width = width;
+    m_height = height;
+    m_layers = layers;
+    glGenTextures(1, &m_texture);
+    Bind();
+
+    // 지금은 빈 렌더 타겟 용도뿐이라 depth 외에는 RGBA로만 할당
+    GLenum imageFormat = format == GL_DEPTH_COMPONENT ? GL_DEPTH_COMPONENT : GL_RGBA;
+    glTexImage3D(GL_TEXTURE_2D_ARRAY, 0, format, width, height, layers, 0,
+                 imageFormat, type, nullptr);
+    SetFilter(GL_LINEAR, GL_LINEAR);
+
+    m_memorySize = RenderStats::GetTextureSize(format, width, height) * layers;
+    RenderStats::TrackTexture(1, m_memorySize);
+}
+
+BufferTextureUPtr BufferTexture::Create(uint32_t internalFormat, size_t texelSize)
+{
+    auto texture = BufferTextureUPtr(new BufferTexture());
+    texture->Init(internalFormat, texelSize);
+    return std::move(texture);
+}
+
+BufferTexture::~BufferTexture()
+{
+    if (m_texture)
+    {
+        FrameCapture::UnregisterBufferTexture(m_texture);
+        glDeleteTextures(1, &m_texture);
+    }
+}
+
+void BufferTexture::Init(uint32_t internalFormat, size_t texelSize)
+{
+    m_internalFormat = internalFormat;
+    m_texelSize = texelSize;
+    glGenTextures(1, &m_texture);
+    Reserve(64);
+}
+
+void BufferTexture::Bind() const
+{
+    glBindTexture(GL_TEXTURE_BUFFER, m_texture);
+    FrameCapture::RecordBindTexture(GL_TEXTURE_BUFFER, m_texture);
+    RenderStats::AddTextureBind();
+}
+
+void BufferTexture::Reserve(size_t texelCount)
+{
+    if (m_buffer && texelCount <= m_buffer->GetCount())
+        return;
+
+    // 매 프레임 크기가 조금씩 바뀌어도 다시 만들지 않도록 두 배씩 늘림
+    size_t capacity = m_buffer ? m_buffer->GetCount() : 0;
+    capacity = std::max(texelCount, capacity * 2);
+
+    // texture가 가리킬 범위를 지정할 수 있으면 stream 버퍼(링 영역 + fence)로 GPU가 읽는 중인 영역을 피해서 씀
+    // 아니면 glBufferSubData로 같은 버퍼를 덮어씀 (드라이버가 필요하면 동기화)
+    if (GLAD_GL_VERSION_4_3 || GLAD_GL_ARB_texture_buffer_range)
+    {
+        m_buffer = Buffer::CreateStream(GL_TEXTURE_BUFFER, m_texelSize, capacity);
+        return; // 범위는 Update마다 연결
+    }
+    m_buffer = Buffer::CreateWithData(GL_TEXTURE_BUFFER, GL_DYNAMIC_DRAW, nullptr, m_texelSize, capacity);
+    glBindTexture(GL_TEXTURE_BUFFER, m_texture);
+    glTexBuffer(GL_TEXTURE_BUFFER, m_internalFormat, m_buffer->Get());
+    FrameCapture::RegisterBufferTexture(m_texture, m_internalFormat, m_buffer->Get());
+}
+
+void BufferTexture::Update(const void *data, size_t texelCount)
+{
+    Reserve(texelCount);
+    m_count = texelCount;
+    if (texelCount == 0)
+        return;
+    if (!m_buffer->IsStream())
+    {
+        m_buffer->Update(data, texelCount);
+        return;
+    }
+
+    // 지난 Update의 영역에 fence를 걸고 다음 영역에 씀. 그 사이의 draw가 지난 영역을 사용함
+    m_buffer->Fence();
+    m_buffer->Update(data, texelCount);
+    size_t offset = m_buffer->GetOffset();
+    size_t size = texelCount * m_texelSize;
+    glBindTexture(GL_TEXTURE_BUFFER, m_texture);
+    glTexBufferRange(GL_TEXTURE_BUFFER, m_internalFormat, m_buffer->Get(), offset, size);
+    FrameCapture::RegisterBufferTexture(m_texture, m_internalFormat, m_buffer->Get(), offset, size);
+}
@@ -1,5 +1,6 @@
 #pragma once
 #include "image.h"
+#include "buffer.h"
 
 CLASS_PTR(Texture)
 class Texture
@@ -15,6 +16,7 @@ private:
     void CreateTexture();
     void SetTextureFromImage(const ImagePtr image);
     void SetTextureFormat(int width, int height, uint32_t format, uint32_t type);
+    void SetMemorySize(size_t size);
 
 private:
     uint32_t m_texture{0};
@@ -22,6 +24,7 @@ private:
     int m_width{0};
     int m_height{0};
     uint32_t m_format{GL_RGBA};
+    size_t m_memorySize{0};
 
 public:
     void Bind() const;
@@ -52,4 +55,63 @@ private:
     CubeTexture() {}
     bool InitFromImages(const std::vector<Image *> &images);
     uint32_t m_texture{0};
+    size_t m_memorySize{0};
+};
+
+// GL_TEXTURE_2D_ARRAY : 같은 크기의 2D 이미지 여러 장. 셰이더에서 (u, v, layer)로 읽음
+CLASS_PTR(TextureArray)
+class TextureArray
+{
+public:
+    static TextureArrayUPtr Create(int width, int height, int layers, uint32_t format,
+                                   uint32_t type = GL_UNSIGNED_BYTE);
+    ~TextureArray();
+
+    const uint32_t Get() const { return m_texture; }
+    void Bind() const;
+    void SetFilter(uint32_t minFilter, uint32_t magFilter) const;
+    void SetWrap(uint32_t sWrap, uint32_t tWrap) const;
+    void SetBorderColor(const glm::vec4 &color) const;
+
+    int GetWidth() const { return m_width; }
+    int GetHeight() const { return m_height; }
+    int GetLayerCount() const { return m_layers; }
+
+private:
+    TextureArray() {}
+    void Init(int width, int height, int layers, uint32_t format, uint32_t type);
+
+    uint32_t m_texture{0};
+    int m_width{0};
+    int m_height{0};
+    int m_layers{0};
+    size_t m_memorySize{0};
+};
+
+// GL_TEXTURE_BUFFER : 셰이더에서 texelFetch로 읽는 1차원 배열. uniform 배열보다 훨씬 큰 데이터를 넘길 수 있음
+CLASS_PTR(BufferTexture)
+class BufferTexture
+{
+public:
+    // internalFormat : GL_RGBA32F, GL_R32UI 등, texelSize : texel 하나의 byte 크기
+    static BufferTextureUPtr Create(uint32_t internalFormat, size_t texelSize);
+    ~BufferTexture();
+
+    const uint32_t Get() const { return m_texture; }
+    void Bind() const;
+    // texelCount개를 처음부터 덮어씀. 용량이 부족하면 더 큰 버퍼를 새로 만들어 연결
+    // glTexBufferRange를 쓸 수 있으면 stream 버퍼에 쓰고 이번 영역의 texelCount개만 texture에 연결
+    void Update(const void *data, size_t texelCount);
+    size_t GetCount() const { return m_count; }
+
+private:
+    BufferTexture() {}
+    void Init(uint32_t internalFormat, size_t texelSize);
+    void Reserve(size_t texelCount);
+
+    uint32_t m_texture{0};
+    uint32_t m_internalFormat{0};
+    size_t m_texelSize{0};
+    size_t m_count{0};
+    BufferUPtr m_buffer;
 };
@@ -0,0 +1,50 @@
+#include "timer.h"
+
+TimerUPtr Timer::Create(double fixedStep)
+{
+    auto timer = TimerUPtr(new Timer());
+    timer->SetFixedStep(fixedStep);
+    timer->Reset();
+    return std::move(timer);
+}
+
+void Timer::Reset()
+{
+    m_lastTime = Clock::now();
+    m_deltaTime = 0.0;
+    m_time = 0.0;
+    m_accumulator = 0.0;
+    m_frameCount = 0;
+    m_stepCount = 0;
+}
+
+void Timer::Tick()
+{
+    auto now = Clock::now();
+    double deltaTime = std::chrono::duration<double>(now - m_lastTime).count();
+    m_lastTime = now;
+    Advance(deltaTime);
+}
+
+void Timer::Advance(double deltaTime)
+{
+    m_deltaTime = glm::min(deltaTime, m_maxDeltaTime);
+    m_time += m_deltaTime;
+    m_accumulator += m_deltaTime;
+    m_frameCount++;
+}
+
+bool Timer::Step()
+{
+    if (m_accumulator < m_fixedStep)
+        return false;
+    m_accumulator -= m_fixedStep;
+    m_stepCount++;
+    return true;
+}
+
+Timer::Clock::time_point Timer::GetStepTime() const
+{
+    // 남은 accumulator만큼 이전 시각이 마지막 step의 경계
+    return m_lastTime - std::chrono::duration_cast<Clock::duration>(std::chrono::duration<double>(m_accumulator));
+}
@@ -0,0 +1,52 @@
+#pragma once
+
+#include "common.h"
+#include <chrono>
+
+// 고해상도 시계로 프레임 간격을 재고 고정 간격(fixed step) 갱신용 accumulator를 관리
+// 사용법 : 매 프레임 Tick() 후 while (timer->Step()) { 고정 간격 갱신 } 하고
+// 남은 시간 비율(GetAlpha)로 이전/현재 상태를 보간
+CLASS_PTR(Timer)
+class Timer
+{
+public:
+    using Clock = std::chrono::steady_clock;
+
+    static TimerUPtr Create(double fixedStep = 1.0 / 60.0);
+
+    void Reset();
+    // 마지막 Tick 이후 실제 경과 시간을 누적
+    void Tick();
+    // 실제 시계 대신 주어진 시간(초)을 누적. 고정 프레임 재생 등에 사용
+    void Advance(double deltaTime);
+    // 누적 시간에서 fixed step 하나를 꺼낼 수 있으면 true
+    bool Step();
+
+    void SetFixedStep(double fixedStep) { m_fixedStep = fixedStep; }
+    double GetFixedStep() const { return m_fixedStep; }
+    // 한 프레임 간격의 최대값. 디버거 정지 등으로 길어져도 step이 몰리지 않도록 제한
+    void SetMaxDeltaTime(double maxDeltaTime) { m_maxDeltaTime = maxDeltaTime; }
+
+    // 마지막 Tick 간격(초)
+    double GetDeltaTime() const { return m_deltaTime; }
+    // Reset 이후 누적 시간(초)
+    double GetTime() const { return m_time; }
+    uint64_t GetFrameCount() const { return m_frameCount; }
+    uint64_t GetStepCount() const { return m_stepCount; }
+    // 아직 처리하지 않은 시간 / fixed step, [0, 1)
+    float GetAlpha() const { return (float)(m_accumulator / m_fixedStep); }
+    // 마지막으로 꺼낸 step이 끝나는 실제 시각
+    Clock::time_point GetStepTime() const;
+
+private:
+    Timer() {}
+
+    Clock::time_point m_lastTime;
+    double m_fixedStep{1.0 / 60.0};
+    double m_maxDeltaTime{0.25};
+    double m_deltaTime{0.0};
+    double m_time{0.0};
+    double m_accumulator{0.0};
+    uint64_t m_frameCount{0};
+    uint64_t m_stepCount{0};
+};
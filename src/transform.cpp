@@ -1,11 +1,23 @@
 #include "transform.h"
 
-mat4 Transform::GetTransform()
+quat Transform::EulerToQuat(const vec3 &degrees)
 {
-    return translate(mat4(1.0f), pos) *
-               rotate(mat4(1.0f), radians(rot.x), vec3(1.0f, 0.0f, 0.0f)) *
-               rotate(mat4(1.0f), radians(rot.y), vec3(0.0f, 1.0f, 0.0f)) *
-               rotate(mat4(1.0f), radians(rot.z), vec3(0.0f, 0.0f, 1.0f)) *
-               scale(mat4(1.0f), scaleVec);
+    return angleAxis(radians(degrees.x), vec3(1.0f, 0.0f, 0.0f)) *
+           angleAxis(radians(degrees.y), vec3(0.0f, 1.0f, 0.0f)) *
+           angleAxis(radians(degrees.z), vec3(0.0f, 0.0f, 1.0f));
 }
 
+const mat4 &Transform::GetTransform() const
+{
+    if (dirty)
+    {
+        // translate * rotate * scale 을 행렬곱 없이 직접 구성
+        mat3 r = mat3_cast(rot);
+        matrix = mat4(vec4(r[0] * scaleVec.x, 0.0f),
+                      vec4(r[1] * scaleVec.y, 0.0f),
+                      vec4(r[2] * scaleVec.z, 0.0f),
+                      vec4(pos, 1.0f));
+        dirty = false;
+    }
+    return matrix;
+}
@@ -1,24 +1,53 @@
 #pragma once
 
 #include "common.h"
+#include <glm/gtc/quaternion.hpp>
 using namespace glm;
 
+// 위치, 회전(quaternion), 크기로부터 만든 행렬을 캐시해두고 값이 바뀔 때만 다시 계산
 class Transform
 {
 
 public:
     Transform(){};
+    // _rot : x, y, z 축 회전각(degree). x -> y -> z 순서로 곱함
     Transform(vec3 _pos, vec3 _rot, vec3 _scale)
+        : pos(_pos), rot(EulerToQuat(_rot)), scaleVec(_scale){};
+    Transform(vec3 _pos, quat _rot, vec3 _scale)
         : pos(_pos), rot(_rot), scaleVec(_scale){};
     ~Transform(){};
-    vec3 pos;
-    vec3 rot;
-    vec3 scaleVec;
-    mat4 GetTransform()    {
-        return translate(mat4(1.0f), pos) *
-               rotate(mat4(1.0f), radians(rot.x), vec3(1.0f, 0.0f, 0.0f)) *
-               rotate(mat4(1.0f), radians(rot.y), vec3(0.0f, 1.0f, 0.0f)) *
-               rotate(mat4(1.0f), radians(rot.z), vec3(0.0f, 0.0f, 1.0f)) *
-               scale(mat4(1.0f), scaleVec);
-    };
+
+    static quat EulerToQuat(const vec3 &degrees);
+
+    const vec3 &GetPosition() const { return pos; }
+    const quat &GetRotation() const { return rot; }
+    const vec3 &GetScale() const { return scaleVec; }
+
+    void SetPosition(const vec3 &_pos)
+    {
+        pos = _pos;
+        dirty = true;
+    }
+    void SetRotation(const quat &_rot)
+    {
+        rot = _rot;
+        dirty = true;
+    }
+    void SetEulerAngles(const vec3 &degrees) { SetRotation(EulerToQuat(degrees)); }
+    void SetScale(const vec3 &_scale)
+    {
+        scaleVec = _scale;
+        dirty = true;
+    }
+
+    bool IsDirty() const { return dirty; }
+    const mat4 &GetTransform() const;
+
+private:
+    vec3 pos{vec3(0.0f)};
+    quat rot{quat(1.0f, 0.0f, 0.0f, 0.0f)};
+    vec3 scaleVec{vec3(1.0f)};
+
+    mutable mat4 matrix{mat4(1.0f)};
+    mutable bool dirty{true};
 };
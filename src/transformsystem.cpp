@@ -0,0 +1,181 @@
+#include "transformsystem.h"
+#include "transformsystem_simd.h"
+
+#if defined(_MSC_VER)
+#include <intrin.h>
+#endif
+
+TransformSystemUPtr TransformSystem::Create(size_t capacity)
+{
+    auto system = TransformSystemUPtr(new TransformSystem());
+    for (auto array : {&system->m_px, &system->m_py, &system->m_pz,
+                       &system->m_qx, &system->m_qy, &system->m_qz, &system->m_qw,
+                       &system->m_sx, &system->m_sy, &system->m_sz})
+        array->reserve(capacity);
+    system->m_matrices.reserve(capacity * 2);
+    return std::move(system);
+}
+
+TransformSystem::~TransformSystem()
+{
+    if (m_texture)
+        glDeleteTextures(1, &m_texture);
+}
+
+uint32_t TransformSystem::Add(const Transform &trf)
+{
+    uint32_t index = (uint32_t)GetCount();
+    const auto &pos = trf.GetPosition();
+    const auto &rot = trf.GetRotation();
+    const auto &scale = trf.GetScale();
+    m_px.push_back(pos.x);
+    m_py.push_back(pos.y);
+    m_pz.push_back(pos.z);
+    m_qx.push_back(rot.x);
+    m_qy.push_back(rot.y);
+    m_qz.push_back(rot.z);
+    m_qw.push_back(rot.w);
+    m_sx.push_back(scale.x);
+    m_sy.push_back(scale.y);
+    m_sz.push_back(scale.z);
+    return index;
+}
+
+void TransformSystem::Set(uint32_t index, const Transform &trf)
+{
+    SetPosition(index, trf.GetPosition());
+    SetRotation(index, trf.GetRotation());
+    SetScale(index, trf.GetScale());
+}
+
+void TransformSystem::SetPosition(uint32_t index, const vec3 &pos)
+{
+    m_px[index] = pos.x;
+    m_py[index] = pos.y;
+    m_pz[index] = pos.z;
+}
+
+void TransformSystem::SetRotation(uint32_t index, const quat &rot)
+{
+    m_qx[index] = rot.x;
+    m_qy[index] = rot.y;
+    m_qz[index] = rot.z;
+    m_qw[index] = rot.w;
+}
+
+void TransformSystem::SetScale(uint32_t index, const vec3 &scale)
+{
+    m_sx[index] = scale.x;
+    m_sy[index] = scale.y;
+    m_sz[index] = scale.z;
+}
+
+bool TransformSystem::IsSimdAvailable()
+{
+#if defined(TRANSFORM_AVX2)
+    // 커널은 AVX2/FMA로 컴파일되지만 나머지 엔진은 아니므로 실행 중인 CPU가 지원하는지 확인
+#if defined(_MSC_VER)
+    static const bool available = []
+    {
+        int info[4];
+        __cpuid(info, 0);
+        if (info[0] < 7)
+            return false;
+        __cpuidex(info, 7, 0);
+        bool avx2 = (info[1] & (1 << 5)) != 0;
+        __cpuid(info, 1);
+        bool fma = (info[2] & (1 << 12)) != 0;
+        bool osxsave = (info[2] & (1 << 27)) != 0;
+        // OS가 AVX 레지스터(YMM) 저장을 지원하는지 확인
+        return avx2 && fma && osxsave && (_xgetbv(0) & 0x6) == 0x6;
+    }();
+    return available;
+#else
+    static const bool available = __builtin_cpu_supports("avx2") && __builtin_cpu_supports("fma");
+    return available;
+#endif
+#else
+    return false;
+#endif
+}
+
+void TransformSystem::Compose(const mat4 &viewProjection)
+{
+    m_matrices.resize(GetCount() * 2);
+
+    size_t done = 0;
+    if (m_useSimd)
+        done = ComposeSimd(viewProjection);
+    ComposeScalar(viewProjection, done, GetCount());
+}
+
+void TransformSystem::ComposeScalar(const mat4 &vp, size_t begin, size_t end)
+{
+    for (size_t i = begin; i < end; i++)
+    {
+        float x = m_qx[i], y = m_qy[i], z = m_qz[i], w = m_qw[i];
+        float xx = x * x, yy = y * y, zz = z * z;
+        float xy = x * y, xz = x * z, yz = y * z;
+        float wx = w * x, wy = w * y, wz = w * z;
+
+        auto &world = m_matrices[i * 2];
+        world[0] = vec4(1.0f - 2.0f * (yy + zz), 2.0f * (xy + wz), 2.0f * (xz - wy), 0.0f) * m_sx[i];
+        world[1] = vec4(2.0f * (xy - wz), 1.0f - 2.0f * (xx + zz), 2.0f * (yz + wx), 0.0f) * m_sy[i];
+        world[2] = vec4(2.0f * (xz + wy), 2.0f * (yz - wx), 1.0f - 2.0f * (xx + yy), 0.0f) * m_sz[i];
+        world[3] = vec4(m_px[i], m_py[i], m_pz[i], 1.0f);
+
+        m_matrices[i * 2 + 1] = vp * world;
+    }
+}
+
+size_t TransformSystem::ComposeSimd(const mat4 &viewProjection)
+{
+#if defined(TRANSFORM_AVX2)
+    // 8개 미만이면 SIMD로 처리할 묶음이 없음 (m_matrices가 비어 있을 수도 있음)
+    if (GetCount() < 8 || !IsSimdAvailable())
+        return 0;
+    TransformSoA soa{m_px.data(), m_py.data(), m_pz.data(),
+                     m_qx.data(), m_qy.data(), m_qz.data(), m_qw.data(),
+                     m_sx.data(), m_sy.data(), m_sz.data()};
+    return ComposeTransformsAvx2(soa, GetCount(), glm::value_ptr(viewProjection),
+                                 glm::value_ptr(m_matrices[0]));
+#else
+    return 0;
+#endif
+}
+
+void TransformSystem::Upload()
+{
+    if (m_matrices.empty())
+        return;
+    // 용량이 부족할 때만 다시 만들고, 영역의 앞쪽 행렬 수만큼만 texture에 연결
+    if (!m_buffer || m_buffer->GetCount() < m_matrices.size())
+        m_buffer = Buffer::CreateStream(GL_TEXTURE_BUFFER, sizeof(mat4), m_matrices.size());
+    else
+        m_buffer->Fence(); // 지난 프레임에 업로드한 영역은 이후의 draw가 끝나야 재사용
+
+    m_buffer->Update(m_matrices.data(), m_matrices.size());
+
+    // persistent 버퍼는 프레임마다 다른 영역에 쓰므로 texture buffer도 그 영역을 가리켜야 함
+    if (!m_texture)
+        glGenTextures(1, &m_texture);
+    glBindTexture(GL_TEXTURE_BUFFER, m_texture);
+    if (GLAD_GL_VERSION_4_3 || GLAD_GL_ARB_texture_buffer_range)
+    {
+        glTexBufferRange(GL_TEXTURE_BUFFER, GL_RGBA32F, m_buffer->Get(),
+                         m_buffer->GetOffset(), m_matrices.size() * sizeof(mat4));
+        m_texelOffset = 0;
+    }
+    else
+    {
+        // range를 지정할 수 없으면 버퍼 전체를 연결하고 셰이더에서 offset을 더함
+        glTexBuffer(GL_TEXTURE_BUFFER, GL_RGBA32F, m_buffer->Get());
+        m_texelOffset = (int)(m_buffer->GetOffset() / sizeof(vec4));
+    }
+}
+
+void TransformSystem::Bind(int slot) const
+{
+    glActiveTexture(GL_TEXTURE0 + slot);
+    glBindTexture(GL_TEXTURE_BUFFER, m_texture);
+}
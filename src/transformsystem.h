@@ -0,0 +1,63 @@
+#pragma once
+
+#include "common.h"
+#include "transform.h"
+#include "buffer.h"
+#include <vector>
+
+// 위치/회전/크기를 성분별 배열(SoA)로 보관하고
+// world 행렬과 world-view-projection 행렬을 한번에 계산하는 transform 저장소
+// AVX2로 빌드하면 8개씩 묶어서 계산
+// 현재 Scene 렌더링은 엔티티마다 uniform으로 행렬을 넘기므로 Context에서는 사용하지 않음
+// (TransformCompose, GpuTransformUpload benchmark에서 계산과 업로드를 검증)
+// 셰이더에서 쓰려면 매 프레임 Compose, Upload 후 Bind하고 samplerBuffer에서
+// texelFetch(matrices, texelOffset + (index * 2 + 1) * 4 + column)으로 wvp 행렬의 열을 읽음
+CLASS_PTR(TransformSystem)
+class TransformSystem
+{
+public:
+    static TransformSystemUPtr Create(size_t capacity = 0);
+    ~TransformSystem();
+
+    uint32_t Add(const Transform &trf);
+    void Set(uint32_t index, const Transform &trf);
+    void SetPosition(uint32_t index, const vec3 &pos);
+    void SetRotation(uint32_t index, const quat &rot);
+    void SetScale(uint32_t index, const vec3 &scale);
+    size_t GetCount() const { return m_px.size(); }
+
+    // 모든 transform의 world, world-view-projection 행렬 계산
+    void Compose(const mat4 &viewProjection);
+    // Compose 결과. 객체마다 [world, wvp] 순서로 연속 저장
+    const mat4 &GetWorld(uint32_t index) const { return m_matrices[index * 2]; }
+    const mat4 &GetWorldViewProjection(uint32_t index) const { return m_matrices[index * 2 + 1]; }
+    const std::vector<mat4> &GetMatrices() const { return m_matrices; }
+
+    // Compose 결과를 stream 버퍼에 한번에 업로드하고 texture buffer가 이번 프레임 영역을 가리키게 함
+    void Upload();
+    const Buffer *GetBuffer() const { return m_buffer.get(); }
+    // RGBA32F texture buffer. 행렬 하나가 4 texel
+    void Bind(int slot) const;
+    uint32_t GetTexture() const { return m_texture; }
+    // texture buffer의 시작에서 이번 프레임 행렬까지의 texel 수
+    // glTexBufferRange를 쓸 수 있으면 항상 0
+    int GetTexelOffset() const { return m_texelOffset; }
+
+    void SetUseSimd(bool useSimd) { m_useSimd = useSimd; }
+    static bool IsSimdAvailable();
+
+private:
+    TransformSystem() {}
+    void ComposeScalar(const mat4 &viewProjection, size_t begin, size_t end);
+    size_t ComposeSimd(const mat4 &viewProjection);
+
+    std::vector<float> m_px, m_py, m_pz;
+    std::vector<float> m_qx, m_qy, m_qz, m_qw;
+    std::vector<float> m_sx, m_sy, m_sz;
+
+    std::vector<mat4> m_matrices;
+    BufferUPtr m_buffer;
+    uint32_t m_texture{0};
+    int m_texelOffset{0};
+    bool m_useSimd{true};
+};
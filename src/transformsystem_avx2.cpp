@@ -0,0 +1,119 @@
+#include "transformsystem_simd.h"
+#include <immintrin.h>
+
+// 이 파일만 AVX2/FMA 옵션으로 컴파일됨 (CMakeLists.txt)
+// AVX2를 지원하지 않는 CPU에서는 호출하지 않도록 TransformSystem::IsSimdAvailable에서 실행 시간에 확인
+
+namespace
+{
+    // 8개의 행을 전치. 입력은 행마다 같은 원소(8개 행렬), 출력은 행마다 한 행렬의 원소 8개
+    inline void Transpose8x8(__m256 r[8])
+    {
+        __m256 t0 = _mm256_unpacklo_ps(r[0], r[1]);
+        __m256 t1 = _mm256_unpackhi_ps(r[0], r[1]);
+        __m256 t2 = _mm256_unpacklo_ps(r[2], r[3]);
+        __m256 t3 = _mm256_unpackhi_ps(r[2], r[3]);
+        __m256 t4 = _mm256_unpacklo_ps(r[4], r[5]);
+        __m256 t5 = _mm256_unpackhi_ps(r[4], r[5]);
+        __m256 t6 = _mm256_unpacklo_ps(r[6], r[7]);
+        __m256 t7 = _mm256_unpackhi_ps(r[6], r[7]);
+        __m256 s0 = _mm256_shuffle_ps(t0, t2, _MM_SHUFFLE(1, 0, 1, 0));
+        __m256 s1 = _mm256_shuffle_ps(t0, t2, _MM_SHUFFLE(3, 2, 3, 2));
+        __m256 s2 = _mm256_shuffle_ps(t1, t3, _MM_SHUFFLE(1, 0, 1, 0));
+        __m256 s3 = _mm256_shuffle_ps(t1, t3, _MM_SHUFFLE(3, 2, 3, 2));
+        __m256 s4 = _mm256_shuffle_ps(t4, t6, _MM_SHUFFLE(1, 0, 1, 0));
+        __m256 s5 = _mm256_shuffle_ps(t4, t6, _MM_SHUFFLE(3, 2, 3, 2));
+        __m256 s6 = _mm256_shuffle_ps(t5, t7, _MM_SHUFFLE(1, 0, 1, 0));
+        __m256 s7 = _mm256_shuffle_ps(t5, t7, _MM_SHUFFLE(3, 2, 3, 2));
+        r[0] = _mm256_permute2f128_ps(s0, s4, 0x20);
+        r[1] = _mm256_permute2f128_ps(s1, s5, 0x20);
+        r[2] = _mm256_permute2f128_ps(s2, s6, 0x20);
+        r[3] = _mm256_permute2f128_ps(s3, s7, 0x20);
+        r[4] = _mm256_permute2f128_ps(s0, s4, 0x31);
+        r[5] = _mm256_permute2f128_ps(s1, s5, 0x31);
+        r[6] = _mm256_permute2f128_ps(s2, s6, 0x31);
+        r[7] = _mm256_permute2f128_ps(s3, s7, 0x31);
+    }
+
+    // 원소별로 계산된 16개 레지스터(column-major 순서)를 8개의 mat4로 저장
+    // stride : 행렬 사이 간격(float 단위)
+    inline void StoreMatrices8(__m256 m[16], float *out, size_t stride)
+    {
+        Transpose8x8(m);
+        Transpose8x8(m + 8);
+        for (int l = 0; l < 8; l++)
+        {
+            _mm256_storeu_ps(out + l * stride, m[l]);
+            _mm256_storeu_ps(out + l * stride + 8, m[8 + l]);
+        }
+    }
+
+    // vp * world. world의 마지막 행은 (0, 0, 0, 1)
+    inline void MultiplyAffine8(const float *vp, const __m256 w[16], __m256 r[16])
+    {
+        for (int c = 0; c < 4; c++)
+        {
+            __m256 wx = w[c * 4 + 0];
+            __m256 wy = w[c * 4 + 1];
+            __m256 wz = w[c * 4 + 2];
+            for (int row = 0; row < 4; row++)
+            {
+                __m256 v = _mm256_mul_ps(_mm256_set1_ps(vp[0 * 4 + row]), wx);
+                v = _mm256_fmadd_ps(_mm256_set1_ps(vp[1 * 4 + row]), wy, v);
+                v = _mm256_fmadd_ps(_mm256_set1_ps(vp[2 * 4 + row]), wz, v);
+                if (c == 3)
+                    v = _mm256_add_ps(v, _mm256_set1_ps(vp[3 * 4 + row]));
+                r[c * 4 + row] = v;
+            }
+        }
+    }
+}
+
+size_t ComposeTransformsAvx2(const TransformSoA &soa, size_t count, const float *vp, float *out)
+{
+    count = count / 8 * 8;
+    const __m256 one = _mm256_set1_ps(1.0f);
+    const __m256 two = _mm256_set1_ps(2.0f);
+    const __m256 zero = _mm256_setzero_ps();
+
+    for (size_t i = 0; i < count; i += 8)
+    {
+        __m256 x = _mm256_loadu_ps(&soa.qx[i]);
+        __m256 y = _mm256_loadu_ps(&soa.qy[i]);
+        __m256 z = _mm256_loadu_ps(&soa.qz[i]);
+        __m256 w = _mm256_loadu_ps(&soa.qw[i]);
+        __m256 sx = _mm256_loadu_ps(&soa.sx[i]);
+        __m256 sy = _mm256_loadu_ps(&soa.sy[i]);
+        __m256 sz = _mm256_loadu_ps(&soa.sz[i]);
+
+        __m256 xx = _mm256_mul_ps(x, x), yy = _mm256_mul_ps(y, y), zz = _mm256_mul_ps(z, z);
+        __m256 xy = _mm256_mul_ps(x, y), xz = _mm256_mul_ps(x, z), yz = _mm256_mul_ps(y, z);
+        __m256 wx = _mm256_mul_ps(w, x), wy = _mm256_mul_ps(w, y), wz = _mm256_mul_ps(w, z);
+
+        __m256 world[16];
+        world[0] = _mm256_mul_ps(_mm256_fnmadd_ps(two, _mm256_add_ps(yy, zz), one), sx);
+        world[1] = _mm256_mul_ps(_mm256_mul_ps(two, _mm256_add_ps(xy, wz)), sx);
+        world[2] = _mm256_mul_ps(_mm256_mul_ps(two, _mm256_sub_ps(xz, wy)), sx);
+        world[3] = zero;
+        world[4] = _mm256_mul_ps(_mm256_mul_ps(two, _mm256_sub_ps(xy, wz)), sy);
+        world[5] = _mm256_mul_ps(_mm256_fnmadd_ps(two, _mm256_add_ps(xx, zz), one), sy);
+        world[6] = _mm256_mul_ps(_mm256_mul_ps(two, _mm256_add_ps(yz, wx)), sy);
+        world[7] = zero;
+        world[8] = _mm256_mul_ps(_mm256_mul_ps(two, _mm256_add_ps(xz, wy)), sz);
+        world[9] = _mm256_mul_ps(_mm256_mul_ps(two, _mm256_sub_ps(yz, wx)), sz);
+        world[10] = _mm256_mul_ps(_mm256_fnmadd_ps(two, _mm256_add_ps(xx, yy), one), sz);
+        world[11] = zero;
+        world[12] = _mm256_loadu_ps(&soa.px[i]);
+        world[13] = _mm256_loadu_ps(&soa.py[i]);
+        world[14] = _mm256_loadu_ps(&soa.pz[i]);
+        world[15] = one;
+
+        __m256 wvp[16];
+        MultiplyAffine8(vp, world, wvp);
+
+        // 객체마다 [world, wvp] 순서로 32 float
+        StoreMatrices8(world, out + i * 32, 32);
+        StoreMatrices8(wvp, out + i * 32 + 16, 32);
+    }
+    return count;
+}
@@ -0,0 +1,17 @@
+#pragma once
+
+#include <cstddef>
+
+// TransformSystem의 성분별 배열. SIMD 커널에 넘기기 위한 포인터 묶음
+struct TransformSoA
+{
+    const float *px, *py, *pz;
+    const float *qx, *qy, *qz, *qw;
+    const float *sx, *sy, *sz;
+};
+
+#if defined(TRANSFORM_AVX2)
+// count의 8의 배수 부분만 계산하고 처리한 개수를 반환
+// vp : column-major 4x4, out : 객체마다 [world, wvp] 순서로 32 float
+size_t ComposeTransformsAvx2(const TransformSoA &soa, size_t count, const float *vp, float *out);
+#endif
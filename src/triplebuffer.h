@@ -0,0 +1,39 @@
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+
+// 생산자 1개, 소비자 1개용 lock-free triple buffer
+// 생산자는 항상 쓰기 전용 슬롯에 기록 후 Publish, 소비자는 Update로 가장 최근 슬롯을 가져옴
+// 어느 쪽도 상대를 기다리지 않으며, 소비자가 느리면 중간 값은 버려짐
+template <typename T>
+class TripleBuffer
+{
+public:
+    // 생산자 쪽
+    T &GetWriteBuffer() { return m_buffers[m_write]; }
+    void Publish()
+    {
+        m_write = m_ready.exchange(m_write | NEW_BIT, std::memory_order_acq_rel) & INDEX_MASK;
+    }
+
+    // 소비자 쪽. 새로 publish된 값이 있으면 true
+    bool Update()
+    {
+        if (!(m_ready.load(std::memory_order_relaxed) & NEW_BIT))
+            return false;
+        m_read = m_ready.exchange(m_read, std::memory_order_acq_rel) & INDEX_MASK;
+        return true;
+    }
+    const T &GetReadBuffer() const { return m_buffers[m_read]; }
+
+private:
+    static constexpr uint8_t INDEX_MASK = 0x3;
+    static constexpr uint8_t NEW_BIT = 0x4;
+
+    T m_buffers[3];
+    uint8_t m_write{0};
+    uint8_t m_read{1};
+    // 두 스레드가 교환하는 슬롯 인덱스 + 새 값 여부
+    std::atomic<uint8_t> m_ready{2};
+};
@@ -1,4 +1,6 @@
 #include "vertexLayout.h"
+#include "capture.h"
+#include "renderstats.h"
 
 VertexLayoutUPtr VertexLayout::Create()
 {
@@ -18,6 +20,8 @@ VertexLayout::~VertexLayout()
 void VertexLayout::Bind() const
 {
     glBindVertexArray(m_vertexArrayObject);
+    FrameCapture::RecordBindVertexArray(m_vertexArrayObject);
+    RenderStats::AddVertexArrayBind();
 }
 
 void VertexLayout::SetAttrib(